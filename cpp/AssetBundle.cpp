@@ -0,0 +1,173 @@
+// cpp/AssetBundle.cpp
+#include "AssetBundle.hpp"
+#include "BridgeConfig.hpp"
+#include "BundleFormat.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::http_server {
+
+std::shared_ptr<AssetBundle> AssetBundle::fromJson(const JsonValue &mount) {
+  const JsonValue *file = mount.get("file");
+  if (!file || !file->isString() || file->asString().empty()) {
+    std::cerr << "[AssetBundle] bundle mount requires 'file'" << std::endl;
+    return nullptr;
+  }
+  const JsonValue *path = mount.get("path");
+  auto bundle = open(path ? path->asString("/") : "/", file->asString());
+  if (bundle) {
+    if (const JsonValue *value = mount.get("fallthrough")) {
+      bundle->_fallthrough = value->asBool(true);
+    }
+  }
+  return bundle;
+}
+
+std::shared_ptr<AssetBundle> AssetBundle::open(const std::string &mountPath,
+                                               const std::string &file) {
+  std::shared_ptr<AssetBundle> bundle(new AssetBundle());
+  bundle->_mountPath = mountPath;
+  if (!bundle->mapFile(file) || !bundle->loadEntries()) {
+    std::cerr << "[AssetBundle] Failed to open bundle " << file << std::endl;
+    return nullptr;
+  }
+  return bundle;
+}
+
+AssetBundle::~AssetBundle() {
+  if (_map) {
+    munmap(const_cast<char *>(_map), _mapSize);
+  }
+}
+
+bool AssetBundle::mapFile(const std::string &file) {
+  int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 ||
+      st.st_size < static_cast<off_t>(bundle::kFileHeaderSize)) {
+    close(fd);
+    return false;
+  }
+  void *map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                   MAP_PRIVATE, fd, 0);
+  // 映射建立后即可关闭文件描述符
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  _map = static_cast<const char *>(map);
+  _mapSize = static_cast<size_t>(st.st_size);
+  return true;
+}
+
+bool AssetBundle::loadEntries() {
+  bundle::FileHeader header;
+  if (!bundle::decodeFileHeader(_map, header) ||
+      header.version != bundle::kVersion) {
+    return false;
+  }
+  uint64_t tableEnd = bundle::kFileHeaderSize +
+                      static_cast<uint64_t>(header.entryCount) *
+                          bundle::kEntrySize;
+  if (tableEnd > _mapSize || header.stringsOffset > _mapSize ||
+      header.stringsSize > _mapSize - header.stringsOffset) {
+    return false;
+  }
+  const char *strings = _map + header.stringsOffset;
+  auto inStrings = [&header](uint64_t offset, uint64_t length) {
+    return offset <= header.stringsSize &&
+           length <= header.stringsSize - offset;
+  };
+  auto inFile = [this](uint64_t offset, uint64_t length) {
+    return offset <= _mapSize && length <= _mapSize - offset;
+  };
+
+  _assets.reserve(header.entryCount);
+  _paths.reserve(header.entryCount);
+  for (uint32_t i = 0; i < header.entryCount; i++) {
+    bundle::Entry entry = bundle::decodeEntry(
+        _map + bundle::kFileHeaderSize + i * bundle::kEntrySize);
+    if (!inStrings(entry.pathOffset, entry.pathLength) ||
+        !inStrings(entry.headersOffset, entry.headersLength) ||
+        !inFile(entry.dataOffset, entry.dataSize) ||
+        !inFile(entry.gzipOffset, entry.gzipSize)) {
+      return false;
+    }
+    std::string_view path(strings + entry.pathOffset, entry.pathLength);
+    // 查找依赖二分，顺序不对的包直接拒绝
+    if (!_paths.empty() && !(_paths.back() < path)) {
+      return false;
+    }
+    _paths.push_back(path);
+
+    StaticAsset asset;
+    asset.data = _map + entry.dataOffset;
+    asset.size = static_cast<size_t>(entry.dataSize);
+    if (entry.gzipSize > 0) {
+      asset.gzipData = _map + entry.gzipOffset;
+      asset.gzipSize = static_cast<size_t>(entry.gzipSize);
+    }
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%016llx\"",
+             static_cast<unsigned long long>(entry.hash));
+    asset.etag = etag;
+    std::string_view lines(strings + entry.headersOffset,
+                           entry.headersLength);
+    while (!lines.empty()) {
+      size_t end = std::min(lines.find('\n'), lines.size());
+      std::string_view line = lines.substr(0, end);
+      lines.remove_prefix(std::min(end + 1, lines.size()));
+      size_t colon = line.find(':');
+      if (colon == std::string_view::npos) {
+        continue;
+      }
+      std::string_view value = line.substr(colon + 1);
+      while (!value.empty() && value.front() == ' ') {
+        value.remove_prefix(1);
+      }
+      asset.headers.emplace_back(std::string(line.substr(0, colon)),
+                                 std::string(value));
+    }
+    _assets.push_back(std::move(asset));
+  }
+  return true;
+}
+
+std::shared_ptr<const StaticAsset>
+AssetBundle::find(const std::string &path) const {
+  if (!matchesPathPrefix(path, _mountPath)) {
+    return nullptr;
+  }
+  size_t end = std::min(path.find('?'), path.size());
+  size_t base = _mountPath.size();
+  if (base > 0 && _mountPath.back() == '/') {
+    base--;
+  }
+  std::string relative =
+      percentDecode(std::string_view(path).substr(base, end - base));
+  while (!relative.empty() && relative.front() == '/') {
+    relative.erase(0, 1);
+  }
+  if (relative.empty() || relative.back() == '/') {
+    relative += "index.html";
+  }
+
+  auto it = std::lower_bound(_paths.begin(), _paths.end(),
+                             std::string_view(relative));
+  if (it == _paths.end() || *it != relative) {
+    return nullptr;
+  }
+  // 别名构造：指向条目，同时持有整个资源包（映射）
+  return std::shared_ptr<const StaticAsset>(
+      shared_from_this(), &_assets[static_cast<size_t>(it - _paths.begin())]);
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,49 @@
+// cpp/AssetBundle.hpp
+#pragma once
+#include "JsonValue.hpp"
+#include "StaticAsset.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// bundle 挂载点：只读的静态资源包（格式见 BundleFormat.hpp）
+// 整个文件只读映射，响应体直接指向映射中的内容，不复制、不解压
+class AssetBundle : public std::enable_shared_from_this<AssetBundle> {
+public:
+  // 解析 { type: 'bundle', path, file, fallthrough }；打开失败时返回 nullptr
+  static std::shared_ptr<AssetBundle> fromJson(const JsonValue &mount);
+  static std::shared_ptr<AssetBundle> open(const std::string &mountPath,
+                                           const std::string &file);
+  ~AssetBundle();
+
+  AssetBundle(const AssetBundle &) = delete;
+  AssetBundle &operator=(const AssetBundle &) = delete;
+
+  // 按请求路径（可带查询字符串）查找条目，以 "/" 结尾时查找 index.html
+  // 返回值持有整个资源包，不存在时返回 nullptr
+  std::shared_ptr<const StaticAsset> find(const std::string &path) const;
+
+  const std::string &mountPath() const { return _mountPath; }
+  bool fallthrough() const { return _fallthrough; }
+  size_t entryCount() const { return _assets.size(); }
+
+private:
+  AssetBundle() = default;
+  bool mapFile(const std::string &file);
+  // 校验文件头和条目表，并为每个条目预先生成响应头和 ETag
+  bool loadEntries();
+
+  std::string _mountPath;
+  bool _fallthrough = true;
+  const char *_map = nullptr;
+  size_t _mapSize = 0;
+  // 与条目表一一对应（同样按路径排序）
+  std::vector<StaticAsset> _assets;
+  std::vector<std::string_view> _paths; // 指向映射中的路径
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,328 @@
+// cpp/BridgeConfig.cpp
+#include "BridgeConfig.hpp"
+#include "FileReader.hpp"
+#include "MemoryStore.hpp"
+#include "RequestReaper.hpp"
+#include "WorkLane.hpp"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+
+namespace margelo::nitro::http_server {
+
+// static_lookup 的默认值
+static constexpr size_t kDefaultLookupEntries = 4096;
+static constexpr int64_t kDefaultRevalidateMs = 1000;
+
+static std::shared_ptr<const BridgeConfig> g_currentConfig;
+static std::mutex g_configMutex;
+
+bool matchesPathPrefix(const std::string &path, const std::string &prefix) {
+  if (prefix.empty() || prefix == "/") {
+    return true;
+  }
+  size_t pathLen = std::min(path.find('?'), path.size());
+  std::string_view base = prefix;
+  if (base.back() == '/') {
+    base.remove_suffix(1);
+  }
+  if (pathLen < base.size() || path.compare(0, base.size(), base) != 0) {
+    return false;
+  }
+  return pathLen == base.size() || path[base.size()] == '/';
+}
+
+bool BridgeConfig::skipsStaticLookup(const std::string &path) const {
+  for (const auto &prefix : staticExcludePrefixes) {
+    if (matchesPathPrefix(path, prefix)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<ResponseCache>
+BridgeConfig::cacheFor(const std::string &path) const {
+  for (const auto &cache : responseCaches) {
+    if (matchesPathPrefix(path, cache->mountPath())) {
+      return cache;
+    }
+  }
+  return nullptr;
+}
+
+const MemoryMount *
+BridgeConfig::memoryMountFor(const std::string &path) const {
+  for (const auto &mount : memoryMounts) {
+    if (matchesPathPrefix(path, mount.path)) {
+      return &mount;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const AssetBundle>
+BridgeConfig::bundleFor(const std::string &path) const {
+  for (const auto &bundle : bundles) {
+    if (matchesPathPrefix(path, bundle->mountPath())) {
+      return bundle;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const StaticFileMount>
+BridgeConfig::fileMountFor(const std::string &path) const {
+  for (const auto &mount : fileMounts) {
+    if (matchesPathPrefix(path, mount->mountPath())) {
+      return mount;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CircuitBreaker>
+BridgeConfig::breakerFor(const std::string &path) const {
+  for (const auto &breaker : circuitBreakers) {
+    if (matchesPathPrefix(path, breaker->path())) {
+      return breaker;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const CorsPolicy>
+BridgeConfig::corsFor(const std::string &path) const {
+  for (const auto &[prefix, policy] : mountCors) {
+    if (matchesPathPrefix(path, prefix)) {
+      return policy;
+    }
+  }
+  return cors;
+}
+
+// 桥接层自己实现的挂载类型：解析到 config 中并返回 true（从 Rust 配置中删除）
+static bool extractBridgeMount(const JsonValue &mount, BridgeConfig &config) {
+  const JsonValue *typeValue = mount.get("type");
+  std::string type = typeValue ? typeValue->asString("") : std::string();
+  const JsonValue *pathValue = mount.get("path");
+  std::string path = pathValue ? pathValue->asString("/") : std::string("/");
+
+  if (type == "cache") {
+    if (auto cache = ResponseCache::fromJson(mount)) {
+      config.responseCaches.push_back(cache);
+    }
+    return true;
+  }
+  if (type == "memory") {
+    MemoryMount memory;
+    memory.path = path;
+    if (const JsonValue *value = mount.get("fallthrough")) {
+      memory.fallthrough = value->asBool(true);
+    }
+    if (const JsonValue *value = mount.get("max_bytes")) {
+      MemoryStore::shared().setCapacity(
+          static_cast<uint64_t>(std::max(value->asNumber(0), 0.0)));
+    }
+    config.memoryMounts.push_back(std::move(memory));
+    return true;
+  }
+  if (type == "bundle") {
+    if (auto bundle = AssetBundle::fromJson(mount)) {
+      config.bundles.push_back(bundle);
+    }
+    return true;
+  }
+  if (type == "static") {
+    // 只有开启 image_variants 或 cache_rules 的 static 挂载点由桥接层提供，
+    // 其余仍交给 Rust
+    auto fileMount = StaticFileMount::fromJson(mount, config.lookupCache);
+    if (!fileMount) {
+      return false;
+    }
+    config.fileMounts.push_back(fileMount);
+    return true;
+  }
+  return false;
+}
+
+// 进程级设置（file_io、request_timeout_ms、lanes）：每次启动服务器都按
+// 配置重新设置，root 为 nullptr 或字段缺失时恢复默认值，不沿用上一个服务器的值
+static void applyProcessSettings(JsonValue *root) {
+  auto take = [root](const char *key) -> std::optional<JsonValue> {
+    return root ? root->take(key) : std::nullopt;
+  };
+  // 文件读取后端是进程级的，启动服务器时按配置切换（默认 pread）
+  FileReader::Backend fileIo = FileReader::Backend::Posix;
+  if (auto value = take("file_io")) {
+    if (auto backend = parseFileIoBackend(value->asString(""))) {
+      fileIo = *backend;
+    } else {
+      std::cerr << "[BridgeConfig] Unknown file_io: " << value->serialize()
+                << std::endl;
+    }
+  }
+  FileReader::shared().setBackend(fileIo);
+  // 未响应请求的回收超时，同样是进程级的（默认 5 分钟，0 表示不回收）
+  double requestTimeoutMs =
+      static_cast<double>(RequestReaper::kDefaultTimeout.count());
+  if (auto value = take("request_timeout_ms")) {
+    requestTimeoutMs = std::max(value->asNumber(requestTimeoutMs), 0.0);
+  }
+  RequestReaper::shared().setTimeout(
+      std::chrono::milliseconds(static_cast<int64_t>(requestTimeoutMs)));
+  // lane 的线程数上限和空闲超时同样是进程级的，未配置时恢复默认值
+  auto lanes = take("lanes");
+  if (lanes && !lanes->isObject()) {
+    lanes.reset();
+  }
+  double idleMs = static_cast<double>(WorkLanes::kDefaultIdleTimeout.count());
+  if (const JsonValue *value = lanes ? lanes->get("idle_ms") : nullptr) {
+    idleMs = std::max(value->asNumber(idleMs), 0.0);
+  }
+  WorkLanes::shared().forEach([&lanes, idleMs](WorkLane &lane) {
+    double maxThreads = WorkLanes::kDefaultMaxThreads;
+    if (const JsonValue *value = lanes ? lanes->get(lane.name()) : nullptr) {
+      maxThreads = std::clamp(value->asNumber(maxThreads), 1.0, 64.0);
+    }
+    lane.setMaxThreads(static_cast<size_t>(maxThreads));
+    lane.setIdleTimeout(
+        std::chrono::milliseconds(static_cast<int64_t>(idleMs)));
+  });
+}
+
+void BridgeConfig::applyDefaultProcessSettings() {
+  applyProcessSettings(nullptr);
+}
+
+std::shared_ptr<const BridgeConfig>
+BridgeConfig::extract(const std::string &configJson,
+                      std::string &rustConfigJson,
+                      const std::string &defaultRootDir) {
+  auto config = std::make_shared<BridgeConfig>();
+  config->lookupCache = std::make_shared<FileLookupCache>(
+      kDefaultLookupEntries, kDefaultRevalidateMs);
+  std::string error;
+  auto root = JsonValue::parse(configJson, &error);
+  if (!root || !root->isObject()) {
+    std::cerr << "[BridgeConfig] Failed to parse config JSON: " << error
+              << std::endl;
+    applyDefaultProcessSettings();
+    rustConfigJson = configJson;
+    return config;
+  }
+
+  if (auto cors = root->take("cors")) {
+    config->cors = CorsPolicy::fromJson(*cors);
+  }
+  applyProcessSettings(&*root);
+  if (auto lookup = root->take("static_lookup"); lookup && lookup->isObject()) {
+    if (const JsonValue *value = lookup->get("exclude_prefixes")) {
+      config->staticExcludePrefixes = value->stringList();
+    }
+    double entries = kDefaultLookupEntries;
+    double revalidateMs = kDefaultRevalidateMs;
+    if (const JsonValue *value = lookup->get("max_entries")) {
+      entries = std::max(value->asNumber(entries), 1.0);
+    }
+    if (const JsonValue *value = lookup->get("revalidate_ms")) {
+      revalidateMs = std::max(value->asNumber(revalidateMs), 0.0);
+    }
+    config->lookupCache = std::make_shared<FileLookupCache>(
+        static_cast<size_t>(entries), static_cast<int64_t>(revalidateMs));
+  }
+  if (auto breakers = root->take("circuit_breakers");
+      breakers && breakers->isArray()) {
+    for (const auto &json : breakers->elements()) {
+      if (auto breaker = CircuitBreaker::fromJson(json, "")) {
+        config->circuitBreakers.push_back(breaker);
+      }
+    }
+  }
+  if (auto value = root->take("request_decompression")) {
+    config->requestDecompression = DecompressionLimits::fromJson(*value);
+  }
+  if (auto value = root->take("listen")) {
+    config->listenAddresses = value->stringList();
+  }
+  if (auto spa = root->take("spa_fallback")) {
+    std::string rootDir = defaultRootDir;
+    if (const JsonValue *value = root->get("root_dir")) {
+      rootDir = value->asString(rootDir);
+    }
+    config->spaFallback =
+        SpaFallback::fromJson(*spa, rootDir, config->lookupCache);
+  }
+
+  if (JsonValue *mounts = root->get("mounts"); mounts && mounts->isArray()) {
+    for (auto &mount : mounts->elements()) {
+      if (!mount.isObject()) {
+        continue;
+      }
+      std::string path = mount.get("path") ? mount.get("path")->asString("")
+                                           : std::string();
+      if (auto cors = mount.take("cors")) {
+        if (auto policy = CorsPolicy::fromJson(*cors)) {
+          config->mountCors.emplace_back(path, policy);
+        }
+      }
+      if (auto json = mount.take("circuit_breaker")) {
+        if (auto breaker = CircuitBreaker::fromJson(*json, path)) {
+          config->circuitBreakers.push_back(breaker);
+        }
+      }
+    }
+
+    // 桥接层自己实现的挂载类型不交给 Rust
+    auto &elements = mounts->elements();
+    elements.erase(
+        std::remove_if(elements.begin(), elements.end(),
+                       [&config](const JsonValue &mount) {
+                         return extractBridgeMount(mount, *config);
+                       }),
+        elements.end());
+  }
+  std::stable_sort(config->memoryMounts.begin(), config->memoryMounts.end(),
+                   [](const auto &a, const auto &b) {
+                     return a.path.size() > b.path.size();
+                   });
+  std::stable_sort(config->bundles.begin(), config->bundles.end(),
+                   [](const auto &a, const auto &b) {
+                     return a->mountPath().size() > b->mountPath().size();
+                   });
+  std::stable_sort(config->fileMounts.begin(), config->fileMounts.end(),
+                   [](const auto &a, const auto &b) {
+                     return a->mountPath().size() > b->mountPath().size();
+                   });
+  std::stable_sort(config->responseCaches.begin(),
+                   config->responseCaches.end(),
+                   [](const auto &a, const auto &b) {
+                     return a->mountPath().size() > b->mountPath().size();
+                   });
+
+  std::stable_sort(config->circuitBreakers.begin(),
+                   config->circuitBreakers.end(),
+                   [](const auto &a, const auto &b) {
+                     return a->path().size() > b->path().size();
+                   });
+  std::stable_sort(config->mountCors.begin(), config->mountCors.end(),
+                   [](const auto &a, const auto &b) {
+                     return a.first.size() > b.first.size();
+                   });
+
+  rustConfigJson = root->serialize();
+  return config;
+}
+
+std::shared_ptr<const BridgeConfig> BridgeConfig::current() {
+  std::lock_guard<std::mutex> lock(g_configMutex);
+  return g_currentConfig;
+}
+
+void BridgeConfig::install(std::shared_ptr<const BridgeConfig> config) {
+  std::lock_guard<std::mutex> lock(g_configMutex);
+  g_currentConfig = std::move(config);
+}
+
+} // namespace margelo::nitro::http_server
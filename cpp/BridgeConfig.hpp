@@ -0,0 +1,90 @@
+// cpp/BridgeConfig.hpp
+#pragma once
+#include "AssetBundle.hpp"
+#include "CircuitBreaker.hpp"
+#include "ContentDecoder.hpp"
+#include "CorsPolicy.hpp"
+#include "FileLookupCache.hpp"
+#include "ResponseCache.hpp"
+#include "SpaFallback.hpp"
+#include "StaticFileMount.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// memory 挂载点：内容来自 MemoryStore
+struct MemoryMount {
+  std::string path;
+  bool fallthrough = true; // 未命中时交给 JS；false 时直接返回 404
+};
+
+// ServerConfig 中由桥接层（而非 Rust 核心）处理的部分
+// startServerWithConfig 时从 configJson 中取出，剩余部分原样交给 Rust
+struct BridgeConfig {
+  // 全局 CORS 策略
+  std::shared_ptr<const CorsPolicy> cors;
+  // 挂载点级别的 CORS 策略（按路径前缀从长到短排列）
+  std::vector<std::pair<std::string, std::shared_ptr<const CorsPolicy>>>
+      mountCors;
+  // 单页应用回退（未配置时为 nullptr）
+  std::shared_ptr<const SpaFallback> spaFallback;
+  // 桥接层文件探测共用的 stat 缓存
+  std::shared_ptr<FileLookupCache> lookupCache;
+  // 这些路径前缀跳过桥接层的所有静态处理，直接交给 JS（如 /api）
+  std::vector<std::string> staticExcludePrefixes;
+  // cache 挂载点（按路径前缀从长到短排列），不转发给 Rust
+  std::vector<std::shared_ptr<ResponseCache>> responseCaches;
+  // memory 挂载点（按路径前缀从长到短排列），不转发给 Rust
+  std::vector<MemoryMount> memoryMounts;
+  // bundle 挂载点（按路径前缀从长到短排列），不转发给 Rust
+  std::vector<std::shared_ptr<const AssetBundle>> bundles;
+  // 开启了 image_variants / cache_rules 的 static 挂载点（排列同上），
+  // 不转发给 Rust
+  std::vector<std::shared_ptr<const StaticFileMount>> fileMounts;
+  // JS 处理器的熔断器（按路径前缀从长到短排列）
+  std::vector<std::shared_ptr<CircuitBreaker>> circuitBreakers;
+  // 解压 gzip / deflate 请求体（未配置时不解压，原样交给 JS）
+  std::optional<DecompressionLimits> requestDecompression;
+  // 额外监听地址，由 ListenRelay 转发到主监听地址（Rust 只绑定一个地址）
+  std::vector<std::string> listenAddresses;
+
+  bool skipsStaticLookup(const std::string &path) const;
+  // 请求路径所属的 cache 挂载点，没有时返回 nullptr
+  std::shared_ptr<ResponseCache> cacheFor(const std::string &path) const;
+  // 请求路径所属的 memory 挂载点，没有时返回 nullptr
+  const MemoryMount *memoryMountFor(const std::string &path) const;
+  // 请求路径所属的 bundle 挂载点，没有时返回 nullptr
+  std::shared_ptr<const AssetBundle> bundleFor(const std::string &path) const;
+  // 请求路径所属的桥接层 static 挂载点，没有时返回 nullptr
+  std::shared_ptr<const StaticFileMount>
+  fileMountFor(const std::string &path) const;
+  // 请求路径所属的熔断器，没有时返回 nullptr
+  std::shared_ptr<CircuitBreaker> breakerFor(const std::string &path) const;
+
+  // 请求路径对应的 CORS 策略（最长前缀优先，其次是全局策略）
+  std::shared_ptr<const CorsPolicy> corsFor(const std::string &path) const;
+
+  // 解析 configJson，返回桥接层配置，并把去掉桥接层字段后的 JSON 写入
+  // rustConfigJson；configJson 无法解析时原样转发并返回空配置
+  // defaultRootDir 为 configJson 未给出 root_dir 时的静态文件根目录
+  // 同时按 configJson 设置进程级的 file_io、request_timeout_ms 和 lanes；
+  // configJson 无法解析时它们恢复默认值
+  static std::shared_ptr<const BridgeConfig>
+  extract(const std::string &configJson, std::string &rustConfigJson,
+          const std::string &defaultRootDir = "");
+  // 不带配置启动服务器时调用：进程级设置恢复默认值
+  static void applyDefaultProcessSettings();
+
+  // 当前生效的配置（未使用 startServerWithConfig 时为 nullptr）
+  static std::shared_ptr<const BridgeConfig> current();
+  static void install(std::shared_ptr<const BridgeConfig> config);
+};
+
+// path（忽略查询字符串）是否位于挂载点 prefix 之下，按路径段匹配
+bool matchesPathPrefix(const std::string &path, const std::string &prefix);
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,61 @@
+// cpp/BridgeMetrics.hpp
+#pragma once
+#include "LatencyHistogram.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace margelo::nitro::http_server {
+
+// 桥接层（C++ ↔ JS）自身的运行指标
+struct BridgeMetrics {
+  static BridgeMetrics &shared() {
+    static BridgeMetrics metrics;
+    return metrics;
+  }
+
+  // 从 c_request_callback 投递到 JS 处理器真正开始执行之间的等待时间
+  LatencyHistogram dispatchDelay;
+  // 已投递到 JS 的请求总数
+  std::atomic<uint64_t> dispatchedRequests{0};
+  // 已投递但 JS 处理器尚未开始执行的请求数
+  std::atomic<int64_t> dispatchQueueDepth{0};
+
+  // 已完成的响应数，以及这些响应共调用了多少次原生响应接口
+  // （writeResponseChunk / endResponse / sendResponse / sendBinaryResponse）
+  std::atomic<uint64_t> completedResponses{0};
+  std::atomic<uint64_t> responseNativeCalls{0};
+  std::atomic<uint64_t> maxResponseNativeCalls{0};
+
+  // 由桥接层直接应答的 CORS 预检请求数
+  std::atomic<uint64_t> corsPreflights{0};
+  // 由桥接层直接返回入口 HTML 的 SPA 回退请求数
+  std::atomic<uint64_t> spaFallbacks{0};
+  // 由 cache 挂载点直接应答的请求数
+  std::atomic<uint64_t> responseCacheHits{0};
+  // 由 memory 挂载点直接应答的请求数
+  std::atomic<uint64_t> memoryMountHits{0};
+  // 由 bundle 挂载点直接应答的请求数
+  std::atomic<uint64_t> bundleHits{0};
+  // static 挂载点按 Accept 协商后返回 AVIF / WebP 兄弟文件的响应数
+  std::atomic<uint64_t> imageVariantHits{0};
+  // 由桥接层解压后交给 JS 的请求体数
+  std::atomic<uint64_t> decompressedRequests{0};
+  // 压缩数据损坏（400）或超过解压限制（413）而被拒绝的请求体数
+  std::atomic<uint64_t> rejectedCompressedRequests{0};
+  // 通过 sendFileResponse 直接从文件发送的响应数
+  std::atomic<uint64_t> fileResponses{0};
+  // 桥接层处理出错、直接返回 500 的请求数
+  std::atomic<uint64_t> failedRequests{0};
+
+  void recordResponseCalls(uint64_t calls) {
+    completedResponses.fetch_add(1, std::memory_order_relaxed);
+    responseNativeCalls.fetch_add(calls, std::memory_order_relaxed);
+    uint64_t prevMax = maxResponseNativeCalls.load(std::memory_order_relaxed);
+    while (calls > prevMax &&
+           !maxResponseNativeCalls.compare_exchange_weak(
+               prevMax, calls, std::memory_order_relaxed)) {
+    }
+  }
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,109 @@
+// cpp/BundleFormat.hpp
+// 静态资源包格式（tools/bundle 打包，AssetBundle 以 mmap 方式读取）
+//
+// 文件头（32 字节）：
+//   magic[8] = "RNHTBDL\0"，u32 版本，u32 条目数，u64 字符串区偏移，
+//   u64 字符串区长度
+// 之后是条目表，每个条目 kEntrySize 字节，按路径的字节序严格递增排列：
+//   u32 路径偏移，u32 路径长度，u32 响应头偏移，u32 响应头长度，
+//   u64 内容哈希（FNV-1a，用作 ETag），u64 内容偏移，u64 内容长度，
+//   u64 gzip 版本偏移，u64 gzip 版本长度（没有 gzip 版本时均为 0）
+// 路径和响应头的偏移相对于字符串区，内容偏移相对于文件开头。
+// 路径不带前导 "/"；响应头为若干 "名称: 值\n" 行（至少含 Content-Type）。
+// 整数均为小端。内容按 kDataAlignment 对齐，便于直接从映射中发送。
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::http_server::bundle {
+
+constexpr char kMagic[8] = {'R', 'N', 'H', 'T', 'B', 'D', 'L', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kFileHeaderSize = 32;
+constexpr size_t kEntrySize = 56;
+constexpr size_t kDataAlignment = 16;
+
+struct FileHeader {
+  uint32_t version = kVersion;
+  uint32_t entryCount = 0;
+  uint64_t stringsOffset = 0;
+  uint64_t stringsSize = 0;
+};
+
+struct Entry {
+  uint32_t pathOffset = 0;
+  uint32_t pathLength = 0;
+  uint32_t headersOffset = 0;
+  uint32_t headersLength = 0;
+  uint64_t hash = 0;
+  uint64_t dataOffset = 0;
+  uint64_t dataSize = 0;
+  uint64_t gzipOffset = 0;
+  uint64_t gzipSize = 0;
+};
+
+inline void putLE(std::string &out, uint64_t v, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+  }
+}
+
+inline uint64_t getLE(const char *p, int bytes) {
+  uint64_t v = 0;
+  for (int i = 0; i < bytes; i++) {
+    v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+  }
+  return v;
+}
+
+inline void encodeFileHeader(std::string &out, const FileHeader &h) {
+  out.append(kMagic, sizeof(kMagic));
+  putLE(out, h.version, 4);
+  putLE(out, h.entryCount, 4);
+  putLE(out, h.stringsOffset, 8);
+  putLE(out, h.stringsSize, 8);
+}
+
+// data 至少 kFileHeaderSize 字节；magic 不符时返回 false
+inline bool decodeFileHeader(const char *data, FileHeader &h) {
+  for (size_t i = 0; i < sizeof(kMagic); i++) {
+    if (data[i] != kMagic[i]) {
+      return false;
+    }
+  }
+  h.version = static_cast<uint32_t>(getLE(data + 8, 4));
+  h.entryCount = static_cast<uint32_t>(getLE(data + 12, 4));
+  h.stringsOffset = getLE(data + 16, 8);
+  h.stringsSize = getLE(data + 24, 8);
+  return true;
+}
+
+inline void encodeEntry(std::string &out, const Entry &e) {
+  putLE(out, e.pathOffset, 4);
+  putLE(out, e.pathLength, 4);
+  putLE(out, e.headersOffset, 4);
+  putLE(out, e.headersLength, 4);
+  putLE(out, e.hash, 8);
+  putLE(out, e.dataOffset, 8);
+  putLE(out, e.dataSize, 8);
+  putLE(out, e.gzipOffset, 8);
+  putLE(out, e.gzipSize, 8);
+}
+
+// data 至少 kEntrySize 字节
+inline Entry decodeEntry(const char *data) {
+  Entry e;
+  e.pathOffset = static_cast<uint32_t>(getLE(data, 4));
+  e.pathLength = static_cast<uint32_t>(getLE(data + 4, 4));
+  e.headersOffset = static_cast<uint32_t>(getLE(data + 8, 4));
+  e.headersLength = static_cast<uint32_t>(getLE(data + 12, 4));
+  e.hash = getLE(data + 16, 8);
+  e.dataOffset = getLE(data + 24, 8);
+  e.dataSize = getLE(data + 32, 8);
+  e.gzipOffset = getLE(data + 40, 8);
+  e.gzipSize = getLE(data + 48, 8);
+  return e;
+}
+
+} // namespace margelo::nitro::http_server::bundle
@@ -0,0 +1,277 @@
+// cpp/CacheRules.cpp
+#include "CacheRules.hpp"
+#include "StaticAsset.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+namespace margelo::nitro::http_server {
+
+// immutable 未指定 max_age 时使用的有效期（一年）
+static constexpr int64_t kImmutableMaxAge = 31536000;
+
+// 展开花括号："*.{js,css}" → "*.js", "*.css"（不支持嵌套）
+static void expandBraces(const std::string &pattern,
+                         std::vector<std::string> &out) {
+  size_t open = pattern.find('{');
+  size_t close = open == std::string::npos ? std::string::npos
+                                           : pattern.find('}', open);
+  if (close == std::string::npos) {
+    out.push_back(pattern);
+    return;
+  }
+  std::string prefix = pattern.substr(0, open);
+  std::string suffix = pattern.substr(close + 1);
+  std::string body = pattern.substr(open + 1, close - open - 1);
+  size_t start = 0;
+  while (true) {
+    size_t comma = body.find(',', start);
+    expandBraces(prefix + body.substr(start, comma - start) + suffix, out);
+    if (comma == std::string::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+}
+
+void CacheRules::compileGlob(const std::string &pattern,
+                             std::vector<Glob> &globs) {
+  std::vector<std::string> expanded;
+  expandBraces(pattern, expanded);
+  for (std::string source : expanded) {
+    if (!source.empty() && source.front() == '/') {
+      source.erase(0, 1);
+    }
+    Glob glob;
+    glob.basenameOnly = source.find('/') == std::string::npos;
+    auto appendLiteral = [&glob](char c) {
+      if (glob.tokens.empty() ||
+          glob.tokens.back().kind != GlobToken::Kind::Literal) {
+        glob.tokens.emplace_back();
+      }
+      glob.tokens.back().literal += c;
+    };
+    for (size_t i = 0; i < source.size(); i++) {
+      char c = source[i];
+      GlobToken token;
+      if (c == '*') {
+        if (i + 1 < source.size() && source[i + 1] == '*') {
+          bool dirs = i + 2 < source.size() && source[i + 2] == '/';
+          token.kind = dirs ? GlobToken::Kind::AnyDirs
+                            : GlobToken::Kind::GlobStar;
+          i += dirs ? 2 : 1;
+        } else {
+          token.kind = GlobToken::Kind::Star;
+        }
+      } else if (c == '?') {
+        token.kind = GlobToken::Kind::AnyChar;
+      } else if (c == '[' && source.find(']', i + 2) != std::string::npos) {
+        size_t j = i + 1;
+        bool negated = source[j] == '!' || source[j] == '^';
+        if (negated) {
+          j++;
+        }
+        // 紧跟在 [ 之后的 ] 是普通字符
+        size_t end = source.find(']', j + 1);
+        if (end == std::string::npos) {
+          appendLiteral(c);
+          continue;
+        }
+        token.kind = GlobToken::Kind::Class;
+        for (size_t k = j; k < end; k++) {
+          auto from = static_cast<unsigned char>(source[k]);
+          auto to = from;
+          if (k + 2 < end && source[k + 1] == '-') {
+            to = static_cast<unsigned char>(source[k + 2]);
+            k += 2;
+          }
+          for (unsigned v = from; v <= to; v++) {
+            token.chars.set(v);
+          }
+        }
+        if (negated) {
+          token.chars.flip();
+        }
+        token.chars.reset('/');
+        i = end;
+      } else {
+        if (c == '\\' && i + 1 < source.size()) {
+          c = source[++i];
+        }
+        appendLiteral(c);
+        continue;
+      }
+      glob.tokens.push_back(std::move(token));
+    }
+    globs.push_back(std::move(glob));
+  }
+}
+
+bool CacheRules::matchGlob(const std::vector<GlobToken> &tokens, size_t index,
+                           const char *text, const char *end) {
+  for (; index < tokens.size(); index++) {
+    const GlobToken &token = tokens[index];
+    switch (token.kind) {
+    case GlobToken::Kind::Literal:
+      if (static_cast<size_t>(end - text) < token.literal.size() ||
+          std::memcmp(text, token.literal.data(), token.literal.size()) != 0) {
+        return false;
+      }
+      text += token.literal.size();
+      break;
+    case GlobToken::Kind::AnyChar:
+      if (text == end || *text == '/') {
+        return false;
+      }
+      text++;
+      break;
+    case GlobToken::Kind::Class:
+      if (text == end || !token.chars.test(static_cast<unsigned char>(*text))) {
+        return false;
+      }
+      text++;
+      break;
+    case GlobToken::Kind::Star:
+      for (const char *p = text;; p++) {
+        if (matchGlob(tokens, index + 1, p, end)) {
+          return true;
+        }
+        if (p == end || *p == '/') {
+          return false;
+        }
+      }
+    case GlobToken::Kind::GlobStar:
+      for (const char *p = text;; p++) {
+        if (matchGlob(tokens, index + 1, p, end)) {
+          return true;
+        }
+        if (p == end) {
+          return false;
+        }
+      }
+    case GlobToken::Kind::AnyDirs:
+      if (matchGlob(tokens, index + 1, text, end)) {
+        return true;
+      }
+      for (const char *p = text; p != end; p++) {
+        if (*p == '/' && matchGlob(tokens, index + 1, p + 1, end)) {
+          return true;
+        }
+      }
+      return false;
+    }
+  }
+  return text == end;
+}
+
+bool CacheRules::matches(const Rule &rule, const std::string &relativePath) {
+  if (rule.regex && std::regex_search(relativePath, *rule.regex)) {
+    return true;
+  }
+  const char *begin = relativePath.data();
+  const char *end = begin + relativePath.size();
+  if (begin != end && *begin == '/') {
+    begin++;
+  }
+  const char *basename = begin;
+  for (const char *p = begin; p != end; p++) {
+    if (*p == '/') {
+      basename = p + 1;
+    }
+  }
+  for (const auto &glob : rule.globs) {
+    if (matchGlob(glob.tokens, 0, glob.basenameOnly ? basename : begin, end)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<const CacheRules> CacheRules::fromJson(const JsonValue &json) {
+  if (!json.isArray()) {
+    return nullptr;
+  }
+  auto rules = std::make_shared<CacheRules>();
+  for (const auto &item : json.elements()) {
+    if (!item.isObject()) {
+      continue;
+    }
+    Rule rule;
+    if (const JsonValue *value = item.get("match")) {
+      for (const auto &pattern : value->stringList()) {
+        compileGlob(pattern, rule.globs);
+      }
+    }
+    if (const JsonValue *value = item.get("regex");
+        value && value->isString()) {
+      try {
+        rule.regex.emplace(value->asString(),
+                           std::regex::ECMAScript | std::regex::optimize);
+      } catch (const std::regex_error &e) {
+        std::cerr << "[CacheRules] Invalid regex '" << value->asString()
+                  << "': " << e.what() << std::endl;
+      }
+    }
+    if (rule.globs.empty() && !rule.regex) {
+      std::cerr << "[CacheRules] Rule without 'match' or 'regex' ignored"
+                << std::endl;
+      continue;
+    }
+
+    bool immutable = false;
+    if (const JsonValue *value = item.get("immutable")) {
+      immutable = value->asBool();
+    }
+    std::optional<int64_t> maxAge;
+    if (const JsonValue *value = item.get("max_age");
+        value && value->isNumber()) {
+      maxAge = static_cast<int64_t>(std::max(value->asNumber(), 0.0));
+    }
+    const JsonValue *cacheControl = item.get("cache_control");
+    if (cacheControl && cacheControl->isString()) {
+      rule.cacheControl = cacheControl->asString();
+    } else {
+      if (!maxAge && immutable) {
+        maxAge = kImmutableMaxAge;
+      }
+      if (maxAge) {
+        rule.cacheControl = "public, max-age=" + std::to_string(*maxAge);
+        rule.expiresSeconds = maxAge;
+      }
+    }
+    if (immutable &&
+        rule.cacheControl.find("immutable") == std::string::npos) {
+      rule.cacheControl += rule.cacheControl.empty() ? "immutable"
+                                                     : ", immutable";
+    }
+    if (const JsonValue *value = item.get("expires");
+        value && value->isNumber()) {
+      rule.expiresSeconds = static_cast<int64_t>(std::floor(value->asNumber()));
+    }
+    rules->_rules.push_back(std::move(rule));
+  }
+  return rules->_rules.empty() ? nullptr : rules;
+}
+
+bool CacheRules::appendHeaders(const std::string &relativePath,
+                               HeaderList &headers) const {
+  for (const auto &rule : _rules) {
+    if (!matches(rule, relativePath)) {
+      continue;
+    }
+    if (!rule.cacheControl.empty()) {
+      headers.emplace_back("Cache-Control", rule.cacheControl);
+    }
+    if (rule.expiresSeconds) {
+      headers.emplace_back(
+          "Expires", formatHttpDate(std::time(nullptr) +
+                                    static_cast<time_t>(*rule.expiresSeconds)));
+    }
+    return true;
+  }
+  return false;
+}
+
+} // namespace margelo::nitro::http_server
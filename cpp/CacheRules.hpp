@@ -0,0 +1,62 @@
+// cpp/CacheRules.hpp
+#pragma once
+#include "CorsPolicy.hpp"
+#include "JsonValue.hpp"
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// static 挂载点的 cache_rules：按路径选择 Cache-Control / Expires
+// 规则在解析配置时编译好（glob 转成匹配指令，regex 预先编译），
+// 请求时按顺序取第一条匹配的规则
+class CacheRules {
+public:
+  // json 为规则数组；没有有效规则时返回 nullptr
+  static std::shared_ptr<const CacheRules> fromJson(const JsonValue &json);
+
+  // 给挂载点内的路径 relativePath（以 / 开头）追加命中规则的响应头
+  // 没有规则命中时返回 false，headers 不变
+  bool appendHeaders(const std::string &relativePath,
+                     HeaderList &headers) const;
+
+  size_t size() const { return _rules.size(); }
+
+private:
+  // glob 编译后的匹配指令
+  // Star 为 *（不跨 /），GlobStar 为 **，AnyDirs 为 **/（零到多级目录）
+  struct GlobToken {
+    enum class Kind { Literal, AnyChar, Class, Star, GlobStar, AnyDirs };
+    Kind kind = Kind::Literal;
+    std::string literal;
+    std::bitset<256> chars; // Class 的字符集（已按 [!...] 取反）
+  };
+
+  // 一个 glob（花括号展开后）
+  struct Glob {
+    std::vector<GlobToken> tokens;
+    bool basenameOnly = false; // 不含 '/' 时只匹配文件名
+  };
+
+  struct Rule {
+    std::vector<Glob> globs;
+    std::optional<std::regex> regex;
+    std::string cacheControl;    // 为空时不写 Cache-Control
+    std::optional<int64_t> expiresSeconds; // 相对响应时间；负数表示已过期
+  };
+
+  static void compileGlob(const std::string &pattern,
+                          std::vector<Glob> &globs);
+  static bool matchGlob(const std::vector<GlobToken> &tokens, size_t index,
+                        const char *text, const char *end);
+  static bool matches(const Rule &rule, const std::string &relativePath);
+
+  std::vector<Rule> _rules;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,226 @@
+// cpp/CaptureFormat.hpp
+// 流量抓取文件格式（桥接层写入，tools/replay 读取）
+//
+// 文件头：
+//   magic[8] = "RNHTCAP\0"，u32 版本，u32 保留，u64 抓取开始时的 Unix 毫秒
+// 之后是连续的记录，每条记录：u8 类型 + varint 负载长度 + 负载
+//   请求记录：varint 序号，varint 距抓取开始的微秒数，str 方法，str 路径，
+//             varint 头部数量，[str 名，str 值]...，varint 请求体长度，
+//             u64 请求体 FNV-1a 哈希，u8 是否保存了请求体，[请求体]
+//   响应记录：varint 序号，varint 状态码，varint 桥接层耗时（微秒），
+//             varint 响应体字节数
+// 整数均为小端，varint 为 LEB128，str 为 varint 长度 + 字节
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::http_server::capture {
+
+constexpr char kMagic[8] = {'R', 'N', 'H', 'T', 'C', 'A', 'P', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kFileHeaderSize = 24;
+
+enum class RecordType : uint8_t {
+  Request = 1,
+  Response = 2,
+};
+
+struct RequestRecord {
+  uint64_t seq = 0;
+  uint64_t offsetUs = 0;
+  std::string method;
+  std::string path;
+  std::vector<std::pair<std::string, std::string>> headers;
+  uint64_t bodyLength = 0;
+  uint64_t bodyHash = 0;
+  bool bodyStored = false;
+  std::string body;
+};
+
+struct ResponseRecord {
+  uint64_t seq = 0;
+  uint64_t statusCode = 0;
+  uint64_t latencyUs = 0;
+  uint64_t bytesSent = 0;
+};
+
+// FNV-1a 64 位哈希，用于在不保存请求体时比较请求体是否一致
+inline uint64_t hashBody(const char *data, size_t len) {
+  uint64_t hash = 1469598103934665603ull;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// 追加式编码器
+class Encoder {
+public:
+  explicit Encoder(std::string &out) : _out(out) {}
+
+  void u8(uint8_t v) { _out.push_back(static_cast<char>(v)); }
+
+  void fixed(uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+      _out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+  }
+
+  void varint(uint64_t v) {
+    while (v >= 0x80) {
+      _out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+      v >>= 7;
+    }
+    _out.push_back(static_cast<char>(v));
+  }
+
+  void str(const char *data, size_t len) {
+    varint(len);
+    _out.append(data, len);
+  }
+  void str(const std::string &s) { str(s.data(), s.size()); }
+
+private:
+  std::string &_out;
+};
+
+// 顺序解码器；越界后 ok() 返回 false，后续读取均返回零值
+class Decoder {
+public:
+  Decoder(const char *data, size_t len) : _data(data), _len(len) {}
+
+  bool ok() const { return _ok; }
+  bool atEnd() const { return _pos >= _len; }
+  size_t position() const { return _pos; }
+
+  uint8_t u8() {
+    if (!need(1)) {
+      return 0;
+    }
+    return static_cast<uint8_t>(_data[_pos++]);
+  }
+
+  uint64_t fixed(int bytes) {
+    if (!need(static_cast<size_t>(bytes))) {
+      return 0;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) {
+      v |= static_cast<uint64_t>(static_cast<uint8_t>(_data[_pos++]))
+           << (8 * i);
+    }
+    return v;
+  }
+
+  uint64_t varint() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (!need(1)) {
+        return 0;
+      }
+      auto byte = static_cast<uint8_t>(_data[_pos++]);
+      v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return v;
+      }
+    }
+    _ok = false;
+    return 0;
+  }
+
+  std::string str() {
+    uint64_t len = varint();
+    if (!need(len)) {
+      return "";
+    }
+    std::string s(_data + _pos, static_cast<size_t>(len));
+    _pos += static_cast<size_t>(len);
+    return s;
+  }
+
+private:
+  bool need(uint64_t n) {
+    if (!_ok || n > _len - _pos) {
+      _ok = false;
+      return false;
+    }
+    return true;
+  }
+
+  const char *_data;
+  size_t _len;
+  size_t _pos = 0;
+  bool _ok = true;
+};
+
+inline void encodeFileHeader(std::string &out, uint64_t startUnixMs) {
+  out.append(kMagic, sizeof(kMagic));
+  Encoder enc(out);
+  enc.fixed(kVersion, 4);
+  enc.fixed(0, 4);
+  enc.fixed(startUnixMs, 8);
+}
+
+inline bool decodeFileHeader(Decoder &dec, uint64_t &startUnixMs) {
+  for (char c : kMagic) {
+    if (static_cast<char>(dec.u8()) != c) {
+      return false;
+    }
+  }
+  uint32_t version = static_cast<uint32_t>(dec.fixed(4));
+  dec.fixed(4);
+  startUnixMs = dec.fixed(8);
+  return dec.ok() && version == kVersion;
+}
+
+// 写入一条记录：类型 + 负载长度 + 负载
+inline void appendRecord(std::string &out, RecordType type,
+                         const std::string &payload) {
+  Encoder enc(out);
+  enc.u8(static_cast<uint8_t>(type));
+  enc.str(payload);
+}
+
+inline void encodeResponse(std::string &payload, const ResponseRecord &r) {
+  Encoder enc(payload);
+  enc.varint(r.seq);
+  enc.varint(r.statusCode);
+  enc.varint(r.latencyUs);
+  enc.varint(r.bytesSent);
+}
+
+inline bool decodeRequest(const std::string &payload, RequestRecord &r) {
+  Decoder dec(payload.data(), payload.size());
+  r.seq = dec.varint();
+  r.offsetUs = dec.varint();
+  r.method = dec.str();
+  r.path = dec.str();
+  uint64_t headerCount = dec.varint();
+  r.headers.clear();
+  for (uint64_t i = 0; i < headerCount && dec.ok(); i++) {
+    std::string name = dec.str();
+    std::string value = dec.str();
+    r.headers.emplace_back(std::move(name), std::move(value));
+  }
+  r.bodyLength = dec.varint();
+  r.bodyHash = dec.fixed(8);
+  r.bodyStored = dec.u8() != 0;
+  r.body = r.bodyStored ? dec.str() : std::string();
+  return dec.ok();
+}
+
+inline bool decodeResponse(const std::string &payload, ResponseRecord &r) {
+  Decoder dec(payload.data(), payload.size());
+  r.seq = dec.varint();
+  r.statusCode = dec.varint();
+  r.latencyUs = dec.varint();
+  r.bytesSent = dec.varint();
+  return dec.ok();
+}
+
+} // namespace margelo::nitro::http_server::capture
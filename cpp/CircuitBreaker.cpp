@@ -0,0 +1,179 @@
+// cpp/CircuitBreaker.cpp
+#include "CircuitBreaker.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace margelo::nitro::http_server {
+
+static bool equalsIgnoreCase(const std::string &a, const std::string &b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return std::tolower(static_cast<unsigned char>(x)) ==
+                  std::tolower(static_cast<unsigned char>(y));
+         });
+}
+
+std::shared_ptr<CircuitBreaker>
+CircuitBreaker::fromJson(const JsonValue &json, const std::string &path) {
+  if (!json.isObject()) {
+    return nullptr;
+  }
+  auto breaker = std::make_shared<CircuitBreaker>();
+  breaker->_path = path;
+  if (breaker->_path.empty()) {
+    const JsonValue *value = json.get("path");
+    breaker->_path = value ? value->asString("/") : std::string("/");
+  }
+  if (const JsonValue *value = json.get("failures")) {
+    breaker->_failureThreshold =
+        static_cast<size_t>(std::max(value->asNumber(5), 1.0));
+  }
+  if (const JsonValue *value = json.get("window_ms")) {
+    breaker->_window = std::chrono::milliseconds(
+        static_cast<int64_t>(std::max(value->asNumber(10000), 1.0)));
+  }
+  if (const JsonValue *value = json.get("cooldown_ms")) {
+    breaker->_cooldown = std::chrono::milliseconds(
+        static_cast<int64_t>(std::max(value->asNumber(30000), 0.0)));
+  }
+  if (const JsonValue *value = json.get("half_open_probes")) {
+    breaker->_halfOpenProbes =
+        static_cast<size_t>(std::max(value->asNumber(1), 1.0));
+  }
+
+  // fallback 响应：默认 503 纯文本，带 Retry-After
+  bool hasContentType = false;
+  bool hasRetryAfter = false;
+  std::string headersJson = "{";
+  auto appendHeader = [&headersJson](const std::string &key,
+                                     const std::string &value) {
+    if (headersJson.size() > 1) {
+      headersJson += ',';
+    }
+    appendJsonString(headersJson, key);
+    headersJson += ':';
+    appendJsonString(headersJson, value);
+  };
+  if (const JsonValue *fallback = json.get("fallback");
+      fallback && fallback->isObject()) {
+    if (const JsonValue *value = fallback->get("status")) {
+      breaker->_fallbackStatus =
+          static_cast<int>(std::clamp(value->asNumber(503), 100.0, 599.0));
+    }
+    if (const JsonValue *value = fallback->get("body")) {
+      breaker->_fallbackBody = value->asString("");
+    }
+    if (const JsonValue *headers = fallback->get("headers");
+        headers && headers->isObject()) {
+      for (const auto &[key, value] : headers->members()) {
+        if (!value.isString()) {
+          continue;
+        }
+        hasContentType |= equalsIgnoreCase(key, "content-type");
+        hasRetryAfter |= equalsIgnoreCase(key, "retry-after");
+        appendHeader(key, value.asString());
+      }
+    }
+  }
+  if (!hasContentType) {
+    appendHeader("Content-Type", "text/plain; charset=utf-8");
+  }
+  if (!hasRetryAfter && breaker->_cooldown.count() > 0) {
+    appendHeader("Retry-After",
+                 std::to_string((breaker->_cooldown.count() + 999) / 1000));
+  }
+  headersJson += '}';
+  breaker->_fallbackHeadersJson = std::move(headersJson);
+  return breaker;
+}
+
+bool CircuitBreaker::allow(uint64_t &probe) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto now = Clock::now();
+  probe = 0;
+  if (_state == State::Open) {
+    if (now - _changedAt < _cooldown) {
+      shortCircuited++;
+      return false;
+    }
+    transitionLocked(State::HalfOpen, now);
+  }
+  if (_state == State::HalfOpen) {
+    // 半开：每轮只放行有限个探测请求，其余继续返回 fallback
+    if (_probesAdmitted >= _halfOpenProbes) {
+      shortCircuited++;
+      return false;
+    }
+    _probesAdmitted++;
+    probe = _probeRound;
+  }
+  return true;
+}
+
+void CircuitBreaker::record(bool success, uint64_t probe) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto now = Clock::now();
+  if (!success) {
+    failures++;
+  }
+  switch (_state) {
+  case State::Closed:
+    if (success) {
+      return;
+    }
+    _recentFailures.push_back(now);
+    while (!_recentFailures.empty() &&
+           now - _recentFailures.front() > _window) {
+      _recentFailures.pop_front();
+    }
+    if (_recentFailures.size() >= _failureThreshold) {
+      transitionLocked(State::Open, now);
+    }
+    break;
+  case State::HalfOpen:
+    // 半开前已投递的请求和上一轮的探测不影响状态
+    if (probe != _probeRound) {
+      break;
+    }
+    if (!success) {
+      transitionLocked(State::Open, now);
+    } else if (++_probesSucceeded >= _halfOpenProbes) {
+      transitionLocked(State::Closed, now);
+    }
+    break;
+  case State::Open:
+    // 打开前已投递的请求陆续完成，不影响状态
+    break;
+  }
+}
+
+void CircuitBreaker::transitionLocked(State state, Clock::time_point now) {
+  if (state == State::Open) {
+    opens++;
+  }
+  _state = state;
+  _changedAt = now;
+  _recentFailures.clear();
+  if (state == State::HalfOpen) {
+    _probeRound++;
+    _probesAdmitted = 0;
+    _probesSucceeded = 0;
+  }
+}
+
+CircuitBreaker::State CircuitBreaker::state() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // 冷却已结束但还没有请求到达时，按半开报告
+  if (_state == State::Open && Clock::now() - _changedAt >= _cooldown) {
+    return State::HalfOpen;
+  }
+  return _state;
+}
+
+double CircuitBreaker::msSinceStateChange() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return std::chrono::duration<double, std::milli>(Clock::now() - _changedAt)
+      .count();
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,73 @@
+// cpp/CircuitBreaker.hpp
+#pragma once
+#include "JsonValue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::http_server {
+
+// JS 处理器的熔断器（按路径前缀）：窗口内失败（Promise 被拒绝或 5xx 响应）
+// 达到阈值后打开，冷却期内由桥接层直接返回 fallback 响应，不再投递到 JS；
+// 冷却结束后半开，放行 half_open_probes 个探测请求，全部成功则关闭，
+// 任一失败则重新打开；半开期间只有探测请求的结果影响状态
+class CircuitBreaker {
+public:
+  enum class State : uint8_t { Closed, Open, HalfOpen };
+
+  // json 为对象时生效；path 为空时使用 json 中的 path
+  static std::shared_ptr<CircuitBreaker> fromJson(const JsonValue &json,
+                                                  const std::string &path);
+
+  const std::string &path() const { return _path; }
+
+  // 请求能否投递到 JS；返回 false 时调用方应返回 fallback 响应
+  // 放行的是半开探测请求时 probe 为非 0 的标记，否则为 0
+  bool allow(uint64_t &probe);
+  // 投递到 JS 的请求完成时调用，probe 为 allow 给出的标记
+  void record(bool success, uint64_t probe);
+
+  State state() const;
+  // 距离最近一次状态变化的毫秒数
+  double msSinceStateChange() const;
+
+  int fallbackStatus() const { return _fallbackStatus; }
+  const std::string &fallbackHeadersJson() const {
+    return _fallbackHeadersJson;
+  }
+  const std::string &fallbackBody() const { return _fallbackBody; }
+
+  std::atomic<uint64_t> opens{0};          // 打开的次数
+  std::atomic<uint64_t> shortCircuited{0}; // 直接返回 fallback 的请求数
+  std::atomic<uint64_t> failures{0};       // 记录到的失败总数
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void transitionLocked(State state, Clock::time_point now);
+
+  std::string _path;
+  size_t _failureThreshold = 5;
+  std::chrono::milliseconds _window{10000};
+  std::chrono::milliseconds _cooldown{30000};
+  size_t _halfOpenProbes = 1;
+  int _fallbackStatus = 503;
+  std::string _fallbackHeadersJson;
+  std::string _fallbackBody = "Service Unavailable";
+
+  mutable std::mutex _mutex;
+  State _state = State::Closed;
+  Clock::time_point _changedAt = Clock::now();
+  std::deque<Clock::time_point> _recentFailures; // 窗口内的失败时间
+  // 本轮半开的标记（每次进入半开加 1）、已放行和已成功的探测数
+  uint64_t _probeRound = 0;
+  size_t _probesAdmitted = 0;
+  size_t _probesSucceeded = 0;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,161 @@
+// cpp/ContentDecoder.cpp
+#include "ContentDecoder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <zlib.h>
+
+namespace margelo::nitro::http_server {
+
+// 每次 inflate 的输出块大小，超出限制时最多多解出这么多
+static constexpr size_t kInflateChunk = 16 * 1024;
+
+std::optional<DecompressionLimits>
+DecompressionLimits::fromJson(const JsonValue &json) {
+  if (!json.isObject() && !(json.isBool() && json.asBool())) {
+    return std::nullopt;
+  }
+  DecompressionLimits limits;
+  if (const JsonValue *value = json.get("max_bytes")) {
+    limits.maxBytes = static_cast<uint64_t>(std::max(
+        value->asNumber(static_cast<double>(limits.maxBytes)), 1.0));
+  }
+  if (const JsonValue *value = json.get("max_ratio")) {
+    limits.maxRatio = std::max(value->asNumber(limits.maxRatio), 1.0);
+  }
+  return limits;
+}
+
+struct ContentDecoder::Stream {
+  z_stream z{};
+  bool initialized = false;
+
+  ~Stream() {
+    if (initialized) {
+      inflateEnd(&z);
+    }
+  }
+};
+
+std::optional<ContentDecoder::Encoding>
+ContentDecoder::parseEncoding(const std::string &header) {
+  size_t begin = header.find_first_not_of(" \t");
+  size_t end = header.find_last_not_of(" \t");
+  if (begin == std::string::npos) {
+    return std::nullopt;
+  }
+  std::string value = header.substr(begin, end - begin + 1);
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (value == "gzip" || value == "x-gzip") {
+    return Encoding::Gzip;
+  }
+  if (value == "deflate") {
+    return Encoding::Deflate;
+  }
+  return std::nullopt;
+}
+
+ContentDecoder::ContentDecoder(Encoding encoding,
+                               const DecompressionLimits &limits)
+    : _encoding(encoding), _limits(limits),
+      _stream(std::make_unique<Stream>()) {}
+
+ContentDecoder::~ContentDecoder() = default;
+
+ContentDecoder::Status ContentDecoder::feed(const char *data, size_t len,
+                                            bool last, std::string &out) {
+  if (_error != Status::Ok) {
+    return _error;
+  }
+  if (!_stream->initialized) {
+    // deflate 按 RFC 应带 zlib 头，但不少客户端发送裸 deflate 数据，
+    // 根据前两个字节判断
+    _head.append(data, len);
+    if (_head.empty() || (_head.size() < 2 && !last)) {
+      return Status::Ok;
+    }
+    int windowBits = 15 + 32; // gzip：自动识别 gzip / zlib 头
+    if (_encoding == Encoding::Deflate) {
+      auto b0 = static_cast<unsigned char>(_head[0]);
+      auto b1 = _head.size() > 1 ? static_cast<unsigned char>(_head[1]) : 0;
+      bool zlibHeader = (b0 & 0x0f) == Z_DEFLATED && (b0 * 256 + b1) % 31 == 0;
+      windowBits = zlibHeader ? 15 : -15;
+    }
+    if (inflateInit2(&_stream->z, windowBits) != Z_OK) {
+      return _error = Status::Malformed;
+    }
+    _stream->initialized = true;
+    std::string head = std::move(_head);
+    _head.clear();
+    if (inflateInput(head.data(), head.size(), out) != Status::Ok) {
+      return _error;
+    }
+  } else if (len > 0 && inflateInput(data, len, out) != Status::Ok) {
+    return _error;
+  }
+  // 输入结束但压缩流不完整：请求体被截断
+  if (last && _stream->initialized && !_finished) {
+    return _error = Status::Malformed;
+  }
+  return Status::Ok;
+}
+
+ContentDecoder::Status ContentDecoder::inflateInput(const char *data,
+                                                    size_t len,
+                                                    std::string &out) {
+  z_stream &z = _stream->z;
+  z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+  z.avail_in = static_cast<uInt>(len);
+  char buffer[kInflateChunk];
+  for (;;) {
+    if (_finished) {
+      if (z.avail_in == 0) {
+        break;
+      }
+      // gzip 允许多个 member 首尾相接；deflate 流结束后不应再有数据
+      if (_encoding != Encoding::Gzip || inflateReset(&z) != Z_OK) {
+        return _error = Status::Malformed;
+      }
+      _finished = false;
+    }
+    uInt availIn = z.avail_in;
+    z.next_out = reinterpret_cast<Bytef *>(buffer);
+    z.avail_out = static_cast<uInt>(sizeof(buffer));
+    int result = inflate(&z, Z_NO_FLUSH);
+    size_t produced = sizeof(buffer) - z.avail_out;
+    _totalIn += availIn - z.avail_in;
+    _totalOut += produced;
+    if (_totalOut > _limits.maxBytes ||
+        (_totalOut > DecompressionLimits::kRatioFloor &&
+         static_cast<double>(_totalOut) >
+             _limits.maxRatio * static_cast<double>(std::max<uint64_t>(
+                                    _totalIn, 1)))) {
+      return _error = Status::TooLarge;
+    }
+    out.append(buffer, produced);
+    if (result == Z_STREAM_END) {
+      _finished = true;
+      continue;
+    }
+    if (result == Z_BUF_ERROR && produced == 0) {
+      break; // 需要更多输入
+    }
+    if (result != Z_OK) {
+      return _error = Status::Malformed;
+    }
+    // 输出块写满时 zlib 内部可能还有待输出的数据
+    if (z.avail_in == 0 && produced < sizeof(buffer)) {
+      break;
+    }
+  }
+  return Status::Ok;
+}
+
+ContentDecoder::Status
+ContentDecoder::decodeAll(Encoding encoding, const DecompressionLimits &limits,
+                          const char *data, size_t len, std::string &out) {
+  ContentDecoder decoder(encoding, limits);
+  return decoder.feed(data, len, true, out);
+}
+
+} // namespace margelo::nitro::http_server
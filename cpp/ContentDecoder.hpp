@@ -0,0 +1,63 @@
+// cpp/ContentDecoder.hpp
+#pragma once
+#include "JsonValue.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::http_server {
+
+// 解压请求体的限制，防止解压炸弹
+struct DecompressionLimits {
+  uint64_t maxBytes = 32 * 1024 * 1024; // 解压后的最大字节数
+  double maxRatio = 100;                // 解压后与压缩前的最大倍数
+  static constexpr uint64_t kRatioFloor = 1024 * 1024; // 低于此大小不检查倍数
+
+  // json 为对象或 true 时生效，其余返回 std::nullopt
+  static std::optional<DecompressionLimits> fromJson(const JsonValue &json);
+};
+
+// 按 Content-Encoding 解压请求体（gzip / deflate，基于 zlib），可以分段输入
+class ContentDecoder {
+public:
+  enum class Encoding : uint8_t { Gzip, Deflate };
+  enum class Status : uint8_t {
+    Ok,
+    Malformed, // 压缩数据损坏或被截断
+    TooLarge,  // 超过 DecompressionLimits
+  };
+
+  // 支持的 Content-Encoding；identity、br 或多重编码返回 std::nullopt
+  static std::optional<Encoding> parseEncoding(const std::string &header);
+
+  ContentDecoder(Encoding encoding, const DecompressionLimits &limits);
+  ~ContentDecoder();
+  ContentDecoder(const ContentDecoder &) = delete;
+  ContentDecoder &operator=(const ContentDecoder &) = delete;
+
+  // 输入一段压缩数据，解出的数据追加到 out；last 表示输入已结束。
+  // 返回非 Ok 后解码器不再可用
+  Status feed(const char *data, size_t len, bool last, std::string &out);
+
+  // 一次性解压完整的请求体
+  static Status decodeAll(Encoding encoding, const DecompressionLimits &limits,
+                          const char *data, size_t len, std::string &out);
+
+private:
+  struct Stream;
+
+  Status inflateInput(const char *data, size_t len, std::string &out);
+
+  Encoding _encoding;
+  DecompressionLimits _limits;
+  std::unique_ptr<Stream> _stream;
+  std::string _head; // deflate 在判断出是否带 zlib 头之前缓存的输入
+  uint64_t _totalIn = 0;
+  uint64_t _totalOut = 0;
+  bool _finished = false; // 已解出完整的压缩流
+  Status _error = Status::Ok;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,266 @@
+// cpp/CorsPolicy.cpp
+#include "CorsPolicy.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace margelo::nitro::http_server {
+
+// 按 origin 缓存的条目上限，超过后整体清空（origin 数量通常很少）
+static constexpr size_t kMaxCachedOrigins = 256;
+
+static std::string joinList(const std::vector<std::string> &items) {
+  std::string joined;
+  for (const auto &item : items) {
+    if (!joined.empty()) {
+      joined += ", ";
+    }
+    joined += item;
+  }
+  return joined;
+}
+
+std::shared_ptr<const CorsPolicy> CorsPolicy::fromJson(const JsonValue &json) {
+  if (!json.isObject() && !(json.isBool() && json.asBool())) {
+    return nullptr;
+  }
+
+  auto policy = std::make_shared<CorsPolicy>();
+  std::vector<std::string> origins{"*"};
+  if (json.isObject()) {
+    if (const JsonValue *value = json.get("origins")) {
+      origins = value->stringList();
+    }
+  }
+  for (const auto &origin : origins) {
+    if (origin == "*") {
+      policy->_anyOrigin = true;
+    } else if (auto star = origin.find("://*."); star != std::string::npos) {
+      policy->_originSuffixes.emplace_back(origin.substr(0, star + 3),
+                                           origin.substr(star + 4));
+    } else {
+      policy->_origins.push_back(origin);
+    }
+  }
+
+  std::vector<std::string> methods{"GET", "HEAD", "PUT", "PATCH", "POST",
+                                   "DELETE"};
+  if (json.isObject()) {
+    if (const JsonValue *value = json.get("methods")) {
+      methods = value->stringList();
+    }
+    if (const JsonValue *value = json.get("allowed_headers")) {
+      policy->_allowedHeaders = joinList(value->stringList());
+    }
+    if (const JsonValue *value = json.get("exposed_headers")) {
+      policy->_exposedHeaders = joinList(value->stringList());
+    }
+    if (const JsonValue *value = json.get("credentials")) {
+      policy->_credentials = value->asBool();
+    }
+    if (const JsonValue *value = json.get("max_age")) {
+      policy->_maxAge = static_cast<int64_t>(value->asNumber(600));
+    }
+  }
+  policy->_methods = joinList(methods);
+  return policy;
+}
+
+bool CorsPolicy::allowsOrigin(const std::string &origin) const {
+  if (_anyOrigin) {
+    return true;
+  }
+  if (std::find(_origins.begin(), _origins.end(), origin) != _origins.end()) {
+    return true;
+  }
+  for (const auto &[scheme, suffix] : _originSuffixes) {
+    if (origin.size() > scheme.size() + suffix.size() &&
+        origin.compare(0, scheme.size(), scheme) == 0 &&
+        origin.compare(origin.size() - suffix.size(), suffix.size(),
+                       suffix) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<const HeaderList>
+CorsPolicy::buildResponseHeaders(const std::string &origin) const {
+  if (!allowsOrigin(origin)) {
+    return nullptr;
+  }
+  auto headers = std::make_shared<HeaderList>();
+  // 需要携带凭据时不能使用通配符
+  bool wildcard = _anyOrigin && !_credentials;
+  headers->emplace_back("Access-Control-Allow-Origin",
+                        wildcard ? "*" : origin);
+  if (!wildcard) {
+    headers->emplace_back("Vary", "Origin");
+  }
+  if (_credentials) {
+    headers->emplace_back("Access-Control-Allow-Credentials", "true");
+  }
+  if (!_exposedHeaders.empty()) {
+    headers->emplace_back("Access-Control-Expose-Headers", _exposedHeaders);
+  }
+  return headers;
+}
+
+std::shared_ptr<const HeaderList>
+CorsPolicy::responseHeaders(const std::string &origin) const {
+  std::lock_guard<std::mutex> lock(_cacheMutex);
+  auto it = _cache.find(origin);
+  if (it != _cache.end()) {
+    return it->second;
+  }
+  if (_cache.size() >= kMaxCachedOrigins) {
+    _cache.clear();
+  }
+  auto headers = buildResponseHeaders(origin);
+  _cache.emplace(origin, headers);
+  return headers;
+}
+
+std::optional<HeaderList>
+CorsPolicy::preflightHeaders(const std::string &origin,
+                             const std::string &requestHeaders) const {
+  auto base = responseHeaders(origin);
+  if (!base) {
+    return std::nullopt;
+  }
+  HeaderList headers;
+  for (const auto &header : *base) {
+    // 预检响应不需要 Expose-Headers
+    if (header.first != "Access-Control-Expose-Headers") {
+      headers.push_back(header);
+    }
+  }
+  headers.emplace_back("Access-Control-Allow-Methods", _methods);
+  const std::string &allowed =
+      _allowedHeaders.empty() ? requestHeaders : _allowedHeaders;
+  if (!allowed.empty()) {
+    headers.emplace_back("Access-Control-Allow-Headers", allowed);
+  }
+  if (_maxAge > 0) {
+    headers.emplace_back("Access-Control-Max-Age", std::to_string(_maxAge));
+  }
+  return headers;
+}
+
+static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return std::tolower(static_cast<unsigned char>(x)) ==
+                  std::tolower(static_cast<unsigned char>(y));
+         });
+}
+
+// 把 add 中的字段名并入 Vary 值 existing（按名称忽略大小写去重）
+static void mergeVary(std::string &existing, std::string_view add) {
+  auto forEachToken = [](std::string_view list, auto &&fn) {
+    while (!list.empty()) {
+      size_t comma = list.find(',');
+      std::string_view token = list.substr(0, comma);
+      list = comma == std::string_view::npos ? std::string_view()
+                                             : list.substr(comma + 1);
+      size_t first = token.find_first_not_of(" \t");
+      if (first == std::string_view::npos) {
+        continue;
+      }
+      token = token.substr(first, token.find_last_not_of(" \t") - first + 1);
+      fn(token);
+    }
+  };
+  forEachToken(add, [&existing, &forEachToken](std::string_view token) {
+    bool present = false;
+    forEachToken(existing, [&](std::string_view current) {
+      present = present || current == "*" || equalsIgnoreCase(current, token);
+    });
+    if (!present) {
+      if (!existing.empty()) {
+        existing += ", ";
+      }
+      existing += token;
+    }
+  });
+}
+
+void appendHeadersToJson(std::string &headersJson,
+                         const HeaderList &headers) {
+  if (headers.empty()) {
+    return;
+  }
+  // Rust 核心解析 headers_json 时同名键只保留最后一个：Vary 必须并入已有
+  // 的值（如 Vary: Accept-Encoding），不能再追加一个 Vary 键
+  std::string vary;
+  bool hasVary = false;
+  for (const auto &[name, value] : headers) {
+    if (equalsIgnoreCase(name, "vary")) {
+      mergeVary(vary, value);
+      hasVary = true;
+    }
+  }
+  if (hasVary && headersJsonContains(headersJson, "vary")) {
+    auto root = JsonValue::parse(headersJson);
+    if (root && root->isObject()) {
+      for (auto &[name, value] : root->members()) {
+        if (equalsIgnoreCase(name, "vary") && value.isString()) {
+          std::string merged = value.asString();
+          mergeVary(merged, vary);
+          value = JsonValue::makeString(std::move(merged));
+          hasVary = false;
+          break;
+        }
+      }
+      if (!hasVary) {
+        headersJson = root->serialize();
+      }
+    }
+  }
+
+  size_t close = headersJson.rfind('}');
+  if (close == std::string::npos) {
+    headersJson = "{}";
+    close = 1;
+  }
+  size_t last = headersJson.find_last_not_of(" \t\r\n", close - 1);
+  bool empty = last == std::string::npos || headersJson[last] == '{';
+
+  std::string extra;
+  auto append = [&extra, empty](const std::string &name,
+                                const std::string &value) {
+    if (!empty || !extra.empty()) {
+      extra += ',';
+    }
+    appendJsonString(extra, name);
+    extra += ':';
+    appendJsonString(extra, value);
+  };
+  for (const auto &[name, value] : headers) {
+    if (!equalsIgnoreCase(name, "vary")) {
+      append(name, value);
+    }
+  }
+  if (hasVary) {
+    append("Vary", vary);
+  }
+  headersJson.insert(close, extra);
+}
+
+bool headersJsonContains(const std::string &headersJson,
+                         const std::string &lowerName) {
+  std::string quoted = "\"" + lowerName + "\"";
+  auto it = std::search(
+      headersJson.begin(), headersJson.end(), quoted.begin(), quoted.end(),
+      [](char a, char b) { return std::tolower(a) == b; });
+  return it != headersJson.end();
+}
+
+void appendContentLength(std::string &headersJson, uint64_t length) {
+  if (!headersJsonContains(headersJson, "content-length")) {
+    appendHeadersToJson(headersJson,
+                        {{"Content-Length", std::to_string(length)}});
+  }
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,67 @@
+// cpp/CorsPolicy.hpp
+#pragma once
+#include "JsonValue.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+using HeaderList = std::vector<std::pair<std::string, std::string>>;
+
+// ServerConfig 中 cors 段对应的策略
+// 预检请求由桥接层直接应答；普通响应在发送路径上追加 Access-Control-* 头
+class CorsPolicy {
+public:
+  // json 不是对象（或为 false）时返回 nullptr
+  static std::shared_ptr<const CorsPolicy> fromJson(const JsonValue &json);
+
+  bool allowsOrigin(const std::string &origin) const;
+
+  // 预检响应头；origin 不被允许时返回 std::nullopt
+  std::optional<HeaderList>
+  preflightHeaders(const std::string &origin,
+                   const std::string &requestHeaders) const;
+
+  // 普通响应需要追加的头，按 origin 缓存；origin 不被允许时返回 nullptr
+  std::shared_ptr<const HeaderList>
+  responseHeaders(const std::string &origin) const;
+
+private:
+  std::shared_ptr<const HeaderList> buildResponseHeaders(
+      const std::string &origin) const;
+
+  bool _anyOrigin = false;
+  std::vector<std::string> _origins;         // 精确匹配
+  // "https://*.example.com" 形式：(协议前缀 "https://", 后缀 ".example.com")
+  std::vector<std::pair<std::string, std::string>> _originSuffixes;
+  std::string _methods;
+  std::string _allowedHeaders;               // 为空时回显请求的头
+  std::string _exposedHeaders;
+  bool _credentials = false;
+  int64_t _maxAge = 600;
+
+  // origin -> 普通响应头，nullptr 表示不被允许
+  mutable std::mutex _cacheMutex;
+  mutable std::unordered_map<std::string, std::shared_ptr<const HeaderList>>
+      _cache;
+};
+
+// 把额外的响应头拼接到 Rust ABI 使用的响应头 JSON 末尾
+// Vary 并入已有的 Vary 值（Rust 核心对同名键只保留最后一个）
+void appendHeadersToJson(std::string &headersJson, const HeaderList &headers);
+
+// 响应头 JSON 中是否已包含某个头（名称按小写比较）
+bool headersJsonContains(const std::string &headersJson,
+                         const std::string &lowerName);
+
+// HEAD 响应不带响应体，Rust 核心按传入的响应体计算的 Content-Length 为 0；
+// 写入 GET 时的长度（已有 Content-Length 时不变）
+void appendContentLength(std::string &headersJson, uint64_t length);
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,781 @@
+// cpp/Digest.cpp
+#include "Digest.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+// DIGEST_PORTABLE_ONLY：只编译软件实现，供测试覆盖硬件可用机器上的
+// 软件路径
+#if defined(DIGEST_PORTABLE_ONLY)
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define DIGEST_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#define DIGEST_ARM64 1
+#endif
+
+namespace margelo::nitro::http_server {
+
+// ---- 常量 ----
+
+static const uint32_t kSha256K[64] = {
+    0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u,
+    0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+    0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u,
+    0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+    0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu,
+    0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+    0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u,
+    0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+    0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u,
+    0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+    0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u,
+    0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+    0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u,
+    0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+    0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u,
+    0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u,
+};
+
+static const uint64_t kSha512K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL,
+    0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL,
+    0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL,
+    0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL,
+    0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL,
+    0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL,
+    0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL,
+    0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL,
+    0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL,
+    0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL,
+    0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL,
+    0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL,
+    0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL,
+    0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const uint32_t kSha256Init[8] = {
+    0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au,
+    0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u,
+};
+
+static const uint64_t kSha384Init[8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL,
+    0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL,
+    0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL,
+};
+
+static const uint64_t kSha512Init[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+static const uint32_t kMd5K[64] = {
+    0xd76aa478u, 0xe8c7b756u, 0x242070dbu, 0xc1bdceeeu,
+    0xf57c0fafu, 0x4787c62au, 0xa8304613u, 0xfd469501u,
+    0x698098d8u, 0x8b44f7afu, 0xffff5bb1u, 0x895cd7beu,
+    0x6b901122u, 0xfd987193u, 0xa679438eu, 0x49b40821u,
+    0xf61e2562u, 0xc040b340u, 0x265e5a51u, 0xe9b6c7aau,
+    0xd62f105du, 0x02441453u, 0xd8a1e681u, 0xe7d3fbc8u,
+    0x21e1cde6u, 0xc33707d6u, 0xf4d50d87u, 0x455a14edu,
+    0xa9e3e905u, 0xfcefa3f8u, 0x676f02d9u, 0x8d2a4c8au,
+    0xfffa3942u, 0x8771f681u, 0x6d9d6122u, 0xfde5380cu,
+    0xa4beea44u, 0x4bdecfa9u, 0xf6bb4b60u, 0xbebfbc70u,
+    0x289b7ec6u, 0xeaa127fau, 0xd4ef3085u, 0x04881d05u,
+    0xd9d4d039u, 0xe6db99e5u, 0x1fa27cf8u, 0xc4ac5665u,
+    0xf4292244u, 0x432aff97u, 0xab9423a7u, 0xfc93a039u,
+    0x655b59c3u, 0x8f0ccc92u, 0xffeff47du, 0x85845dd1u,
+    0x6fa87e4fu, 0xfe2ce6e0u, 0xa3014314u, 0x4e0811a1u,
+    0xf7537e82u, 0xbd3af235u, 0x2ad7d2bbu, 0xeb86d391u,
+};
+
+static const uint32_t kMd5Shift[16] = {7, 12, 17, 22, 5, 9,  14, 20,
+                                       4, 11, 16, 23, 6, 10, 15, 21};
+
+static inline uint32_t rotl32(uint32_t x, int n) {
+  return (x << n) | (x >> (32 - n));
+}
+static inline uint32_t rotr32(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+static inline uint64_t rotr64(uint64_t x, int n) {
+  return (x >> n) | (x << (64 - n));
+}
+static inline uint32_t loadBe32(const uint8_t *p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+static inline uint32_t loadLe32(const uint8_t *p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+         (uint32_t(p[3]) << 24);
+}
+static inline uint64_t loadBe64(const uint8_t *p) {
+  return (uint64_t(loadBe32(p)) << 32) | loadBe32(p + 4);
+}
+
+// ---- 软件实现 ----
+
+static void md5Blocks(uint32_t *state, const uint8_t *data, size_t count) {
+  for (; count > 0; count--, data += 64) {
+    uint32_t m[16];
+    for (int i = 0; i < 16; i++) {
+      m[i] = loadLe32(data + i * 4);
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (int i = 0; i < 64; i++) {
+      uint32_t f;
+      int g;
+      if (i < 16) {
+        f = (b & c) | (~b & d);
+        g = i;
+      } else if (i < 32) {
+        f = (d & b) | (~d & c);
+        g = (5 * i + 1) % 16;
+      } else if (i < 48) {
+        f = b ^ c ^ d;
+        g = (3 * i + 5) % 16;
+      } else {
+        f = c ^ (b | ~d);
+        g = (7 * i) % 16;
+      }
+      uint32_t next = d;
+      d = c;
+      c = b;
+      b += rotl32(a + f + kMd5K[i] + m[g], kMd5Shift[(i / 16) * 4 + i % 4]);
+      a = next;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+  }
+}
+
+static void sha1BlocksPortable(uint32_t *state, const uint8_t *data,
+                               size_t count) {
+  for (; count > 0; count--, data += 64) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+      w[i] = loadBe32(data + i * 4);
+    }
+    for (int i = 16; i < 80; i++) {
+      w[i] = rotl32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+             e = state[4];
+    for (int i = 0; i < 80; i++) {
+      uint32_t f, k;
+      if (i < 20) {
+        f = (b & c) | (~b & d);
+        k = 0x5a827999u;
+      } else if (i < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ed9eba1u;
+      } else if (i < 60) {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8f1bbcdcu;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xca62c1d6u;
+      }
+      uint32_t t = rotl32(a, 5) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = rotl32(b, 30);
+      b = a;
+      a = t;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+  }
+}
+
+static void sha256BlocksPortable(uint32_t *state, const uint8_t *data,
+                                 size_t count) {
+  for (; count > 0; count--, data += 64) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+      w[i] = loadBe32(data + i * 4);
+    }
+    for (int i = 16; i < 64; i++) {
+      uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^
+                    (w[i - 15] >> 3);
+      uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^
+                    (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+             e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+      uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + s1 + ch + kSha256K[i] + w[i];
+      uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + s0 + maj;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+static void sha512Blocks(uint64_t *state, const uint8_t *data, size_t count) {
+  for (; count > 0; count--, data += 128) {
+    uint64_t w[80];
+    for (int i = 0; i < 16; i++) {
+      w[i] = loadBe64(data + i * 8);
+    }
+    for (int i = 16; i < 80; i++) {
+      uint64_t s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^
+                    (w[i - 15] >> 7);
+      uint64_t s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^
+                    (w[i - 2] >> 6);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3],
+             e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 80; i++) {
+      uint64_t s1 = rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41);
+      uint64_t ch = (e & f) ^ (~e & g);
+      uint64_t t1 = h + s1 + ch + kSha512K[i] + w[i];
+      uint64_t s0 = rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39);
+      uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + s0 + maj;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+// ---- 硬件实现 ----
+
+#if DIGEST_X86
+
+#define DIGEST_SHA_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+DIGEST_SHA_TARGET
+static void sha1BlocksHw(uint32_t *state, const uint8_t *data, size_t count) {
+  const __m128i mask =
+      _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  __m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+  abcd = _mm_shuffle_epi32(abcd, 0x1b);
+  __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+  for (; count > 0; count--, data += 64) {
+    __m128i abcdSave = abcd;
+    __m128i e0Save = e0;
+    __m128i msg[4];
+    for (int i = 0; i < 4; i++) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16)),
+          mask);
+    }
+    // 每次 4 轮：e 由上一组的 abcd 经 sha1nexte 得到
+    __m128i e = _mm_add_epi32(e0, msg[0]);
+    __m128i prev = abcd;
+    for (int i = 0; i < 20; i++) {
+      if (i > 0) {
+        e = _mm_sha1nexte_epu32(prev, msg[i % 4]);
+      }
+      prev = abcd;
+      switch (i / 5) {
+      case 0:
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+        break;
+      case 1:
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 1);
+        break;
+      case 2:
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 2);
+        break;
+      default:
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 3);
+        break;
+      }
+      if (i < 16) {
+        msg[i % 4] = _mm_sha1msg2_epu32(
+            _mm_xor_si128(_mm_sha1msg1_epu32(msg[i % 4], msg[(i + 1) % 4]),
+                          msg[(i + 2) % 4]),
+            msg[(i + 3) % 4]);
+      }
+    }
+    e0 = _mm_sha1nexte_epu32(prev, e0Save);
+    abcd = _mm_add_epi32(abcd, abcdSave);
+  }
+  abcd = _mm_shuffle_epi32(abcd, 0x1b);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state), abcd);
+  state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+DIGEST_SHA_TARGET
+static void sha256BlocksHw(uint32_t *state, const uint8_t *data,
+                           size_t count) {
+  const __m128i mask =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  // 指令使用 ABEF / CDGH 的排列
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+  __m128i state1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+  tmp = _mm_shuffle_epi32(tmp, 0xb1);
+  state1 = _mm_shuffle_epi32(state1, 0x1b);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+  for (; count > 0; count--, data += 64) {
+    __m128i save0 = state0;
+    __m128i save1 = state1;
+    __m128i msg[4];
+    for (int i = 0; i < 4; i++) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16)),
+          mask);
+    }
+    for (int i = 0; i < 16; i++) {
+      __m128i wk = _mm_add_epi32(
+          msg[i % 4],
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(kSha256K + i * 4)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+      state0 = _mm_sha256rnds2_epu32(state0, state1,
+                                     _mm_shuffle_epi32(wk, 0x0e));
+      if (i < 12) {
+        __m128i w = _mm_add_epi32(
+            _mm_sha256msg1_epu32(msg[i % 4], msg[(i + 1) % 4]),
+            _mm_alignr_epi8(msg[(i + 3) % 4], msg[(i + 2) % 4], 4));
+        msg[i % 4] = _mm_sha256msg2_epu32(w, msg[(i + 3) % 4]);
+      }
+    }
+    state0 = _mm_add_epi32(state0, save0);
+    state1 = _mm_add_epi32(state1, save1);
+  }
+  tmp = _mm_shuffle_epi32(state0, 0x1b);
+  state1 = _mm_shuffle_epi32(state1, 0xb1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), state1);
+}
+
+static bool cpuHasShaExtensions() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 19)) ||
+      !(ecx & (1u << 9))) {
+    return false; // SSE4.1 / SSSE3
+  }
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (ebx & (1u << 29)) != 0; // SHA
+}
+
+#elif DIGEST_ARM64
+
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define DIGEST_SHA_TARGET
+#elif defined(__clang__)
+#define DIGEST_SHA_TARGET __attribute__((target("crypto")))
+#else
+#define DIGEST_SHA_TARGET __attribute__((target("+crypto")))
+#endif
+
+DIGEST_SHA_TARGET
+static void sha1BlocksHw(uint32_t *state, const uint8_t *data, size_t count) {
+  uint32x4_t abcd = vld1q_u32(state);
+  uint32_t e0 = state[4];
+  for (; count > 0; count--, data += 64) {
+    uint32x4_t abcdSave = abcd;
+    uint32_t e0Save = e0;
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; i++) {
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+    }
+    static const uint32_t k[4] = {0x5a827999u, 0x6ed9eba1u, 0x8f1bbcdcu,
+                                  0xca62c1d6u};
+    uint32_t e = e0;
+    for (int i = 0; i < 20; i++) {
+      uint32x4_t wk = vaddq_u32(msg[i % 4], vdupq_n_u32(k[i / 5]));
+      uint32_t next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+      if (i < 5) {
+        abcd = vsha1cq_u32(abcd, e, wk);
+      } else if (i < 10 || i >= 15) {
+        abcd = vsha1pq_u32(abcd, e, wk);
+      } else {
+        abcd = vsha1mq_u32(abcd, e, wk);
+      }
+      e = next;
+      if (i < 16) {
+        msg[i % 4] = vsha1su1q_u32(
+            vsha1su0q_u32(msg[i % 4], msg[(i + 1) % 4], msg[(i + 2) % 4]),
+            msg[(i + 3) % 4]);
+      }
+    }
+    e0 = e + e0Save;
+    abcd = vaddq_u32(abcd, abcdSave);
+  }
+  vst1q_u32(state, abcd);
+  state[4] = e0;
+}
+
+DIGEST_SHA_TARGET
+static void sha256BlocksHw(uint32_t *state, const uint8_t *data,
+                           size_t count) {
+  uint32x4_t state0 = vld1q_u32(state);
+  uint32x4_t state1 = vld1q_u32(state + 4);
+  for (; count > 0; count--, data += 64) {
+    uint32x4_t save0 = state0;
+    uint32x4_t save1 = state1;
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; i++) {
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+    }
+    for (int i = 0; i < 16; i++) {
+      uint32x4_t wk = vaddq_u32(msg[i % 4], vld1q_u32(kSha256K + i * 4));
+      uint32x4_t abcd = state0;
+      state0 = vsha256hq_u32(state0, state1, wk);
+      state1 = vsha256h2q_u32(state1, abcd, wk);
+      if (i < 12) {
+        msg[i % 4] = vsha256su1q_u32(
+            vsha256su0q_u32(msg[i % 4], msg[(i + 1) % 4]), msg[(i + 2) % 4],
+            msg[(i + 3) % 4]);
+      }
+    }
+    state0 = vaddq_u32(state0, save0);
+    state1 = vaddq_u32(state1, save1);
+  }
+  vst1q_u32(state, state0);
+  vst1q_u32(state + 4, state1);
+}
+
+static bool cpuHasShaExtensions() {
+#if defined(__APPLE__)
+  return true; // 所有 arm64 的 Apple 芯片都带 SHA 指令
+#elif defined(__linux__)
+  unsigned long hwcap = getauxval(AT_HWCAP);
+  return (hwcap & (1ul << 5)) && (hwcap & (1ul << 6)); // HWCAP_SHA1 / SHA2
+#else
+  return false;
+#endif
+}
+
+#endif
+
+using Sha32Blocks = void (*)(uint32_t *, const uint8_t *, size_t);
+
+struct ShaImpl {
+  Sha32Blocks sha1 = sha1BlocksPortable;
+  Sha32Blocks sha256 = sha256BlocksPortable;
+};
+
+// 选择 SHA-1 / SHA-256 的实现。硬件实现先与软件实现对同一段输入的结果
+// 比对，不一致时（指令行为与预期不符）退回软件实现
+static const ShaImpl &shaImpl() {
+  static const ShaImpl impl = [] {
+    ShaImpl result;
+#if DIGEST_X86 || DIGEST_ARM64
+    if (!cpuHasShaExtensions()) {
+      return result;
+    }
+    uint8_t input[128];
+    for (size_t i = 0; i < sizeof(input); i++) {
+      input[i] = static_cast<uint8_t>(i * 151 + 7);
+    }
+    uint32_t expected[8], actual[8];
+    std::memcpy(expected, kSha256Init, sizeof(expected));
+    std::memcpy(actual, kSha256Init, sizeof(actual));
+    sha1BlocksPortable(expected, input, 2);
+    sha1BlocksHw(actual, input, 2);
+    if (std::memcmp(expected, actual, 5 * sizeof(uint32_t)) == 0) {
+      result.sha1 = sha1BlocksHw;
+    }
+    std::memcpy(expected, kSha256Init, sizeof(expected));
+    std::memcpy(actual, kSha256Init, sizeof(actual));
+    sha256BlocksPortable(expected, input, 2);
+    sha256BlocksHw(actual, input, 2);
+    if (std::memcmp(expected, actual, sizeof(expected)) == 0) {
+      result.sha256 = sha256BlocksHw;
+    }
+#endif
+    return result;
+  }();
+  return impl;
+}
+
+// ---- 算法名 ----
+
+std::optional<HashAlgorithm> parseHashAlgorithm(const std::string &name) {
+  std::string key;
+  for (char c : name) {
+    if (c != '-' && c != '_') {
+      key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+  if (key.rfind("rsa", 0) == 0) {
+    key.erase(0, 3);
+  }
+  if (key == "md5") {
+    return HashAlgorithm::Md5;
+  }
+  if (key == "sha1") {
+    return HashAlgorithm::Sha1;
+  }
+  if (key == "sha256") {
+    return HashAlgorithm::Sha256;
+  }
+  if (key == "sha384") {
+    return HashAlgorithm::Sha384;
+  }
+  if (key == "sha512") {
+    return HashAlgorithm::Sha512;
+  }
+  return std::nullopt;
+}
+
+const char *hashAlgorithmName(HashAlgorithm algorithm) {
+  switch (algorithm) {
+  case HashAlgorithm::Md5:
+    return "md5";
+  case HashAlgorithm::Sha1:
+    return "sha1";
+  case HashAlgorithm::Sha256:
+    return "sha256";
+  case HashAlgorithm::Sha384:
+    return "sha384";
+  case HashAlgorithm::Sha512:
+    return "sha512";
+  }
+  return "";
+}
+
+std::vector<std::string> supportedHashNames() {
+  return {"md5", "sha1", "sha256", "sha384", "sha512"};
+}
+
+// ---- Digest ----
+
+Digest::Digest(HashAlgorithm algorithm) : _algorithm(algorithm) { reset(); }
+
+size_t Digest::digestSize() const {
+  switch (_algorithm) {
+  case HashAlgorithm::Md5:
+    return 16;
+  case HashAlgorithm::Sha1:
+    return 20;
+  case HashAlgorithm::Sha256:
+    return 32;
+  case HashAlgorithm::Sha384:
+    return 48;
+  case HashAlgorithm::Sha512:
+    return 64;
+  }
+  return 0;
+}
+
+size_t Digest::blockSize() const {
+  return _algorithm == HashAlgorithm::Sha384 ||
+                 _algorithm == HashAlgorithm::Sha512
+             ? 128
+             : 64;
+}
+
+void Digest::reset() {
+  _buffered = 0;
+  _length = 0;
+  switch (_algorithm) {
+  case HashAlgorithm::Md5:
+    _state = {0x67452301u, 0xefcdab89u, 0x98badcfeu, 0x10325476u};
+    break;
+  case HashAlgorithm::Sha1:
+    _state = {0x67452301u, 0xefcdab89u, 0x98badcfeu, 0x10325476u,
+              0xc3d2e1f0u};
+    break;
+  case HashAlgorithm::Sha256:
+    std::copy(std::begin(kSha256Init), std::end(kSha256Init), _state.begin());
+    break;
+  case HashAlgorithm::Sha384:
+    std::copy(std::begin(kSha384Init), std::end(kSha384Init), _state.begin());
+    break;
+  case HashAlgorithm::Sha512:
+    std::copy(std::begin(kSha512Init), std::end(kSha512Init), _state.begin());
+    break;
+  }
+}
+
+void Digest::compress(const uint8_t *blocks, size_t count) {
+  if (_algorithm == HashAlgorithm::Sha384 ||
+      _algorithm == HashAlgorithm::Sha512) {
+    sha512Blocks(_state.data(), blocks, count);
+    return;
+  }
+  uint32_t state[8];
+  for (int i = 0; i < 8; i++) {
+    state[i] = static_cast<uint32_t>(_state[i]);
+  }
+  switch (_algorithm) {
+  case HashAlgorithm::Md5:
+    md5Blocks(state, blocks, count);
+    break;
+  case HashAlgorithm::Sha1:
+    shaImpl().sha1(state, blocks, count);
+    break;
+  default:
+    shaImpl().sha256(state, blocks, count);
+    break;
+  }
+  std::copy(std::begin(state), std::end(state), _state.begin());
+}
+
+void Digest::update(const uint8_t *data, size_t len) {
+  size_t block = blockSize();
+  _length += len;
+  if (_buffered > 0) {
+    size_t n = std::min(len, block - _buffered);
+    std::memcpy(_buffer.data() + _buffered, data, n);
+    _buffered += n;
+    data += n;
+    len -= n;
+    if (_buffered < block) {
+      return;
+    }
+    compress(_buffer.data(), 1);
+    _buffered = 0;
+  }
+  // 整块直接从输入压缩，不经过缓冲区
+  if (len >= block) {
+    size_t count = len / block;
+    compress(data, count);
+    data += count * block;
+    len -= count * block;
+  }
+  if (len > 0) {
+    std::memcpy(_buffer.data(), data, len);
+    _buffered = len;
+  }
+}
+
+std::vector<uint8_t> Digest::finish() {
+  size_t block = blockSize();
+  // 长度字段：MD5 为 64 位小端，SHA-1/256 为 64 位大端，SHA-384/512 为
+  // 128 位大端（高 64 位恒为 0）
+  size_t lengthBytes = block == 128 ? 16 : 8;
+  uint64_t bits = _length * 8;
+  uint8_t tail[256] = {0x80};
+  size_t padding = (block - (_buffered + 1 + lengthBytes) % block) % block;
+  size_t tailLen = 1 + padding + lengthBytes;
+  for (int i = 0; i < 8; i++) {
+    uint8_t byte = static_cast<uint8_t>(bits >> (8 * i));
+    if (_algorithm == HashAlgorithm::Md5) {
+      tail[tailLen - 8 + i] = byte;
+    } else {
+      tail[tailLen - 1 - i] = byte;
+    }
+  }
+  uint64_t length = _length;
+  update(tail, tailLen);
+  _length = length;
+
+  std::vector<uint8_t> out(digestSize());
+  for (size_t i = 0; i < out.size(); i++) {
+    if (block == 128) {
+      out[i] = static_cast<uint8_t>(_state[i / 8] >> (56 - 8 * (i % 8)));
+    } else if (_algorithm == HashAlgorithm::Md5) {
+      out[i] = static_cast<uint8_t>(_state[i / 4] >> (8 * (i % 4)));
+    } else {
+      out[i] = static_cast<uint8_t>(_state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+  }
+  reset();
+  return out;
+}
+
+// ---- Hmac ----
+
+Hmac::Hmac(HashAlgorithm algorithm, const uint8_t *key, size_t keyLen)
+    : _inner(algorithm), _outer(algorithm) {
+  size_t block = _inner.blockSize();
+  std::vector<uint8_t> pad(block, 0);
+  if (keyLen > block) {
+    Digest keyDigest(algorithm);
+    keyDigest.update(key, keyLen);
+    auto hashed = keyDigest.finish();
+    std::copy(hashed.begin(), hashed.end(), pad.begin());
+  } else if (keyLen > 0) {
+    std::memcpy(pad.data(), key, keyLen);
+  }
+  for (auto &byte : pad) {
+    byte ^= 0x36;
+  }
+  _inner.update(pad.data(), block);
+  for (auto &byte : pad) {
+    byte ^= 0x36 ^ 0x5c;
+  }
+  _outer.update(pad.data(), block);
+}
+
+std::vector<uint8_t> Hmac::finish() {
+  auto innerDigest = _inner.finish();
+  Digest outer = _outer;
+  outer.update(innerDigest.data(), innerDigest.size());
+  return outer.finish();
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,60 @@
+// cpp/Digest.hpp
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+enum class HashAlgorithm : uint8_t { Md5, Sha1, Sha256, Sha384, Sha512 };
+
+// "sha256"、"SHA-256"、"RSA-SHA256" 等写法都可以，不支持时返回 std::nullopt
+std::optional<HashAlgorithm> parseHashAlgorithm(const std::string &name);
+const char *hashAlgorithmName(HashAlgorithm algorithm);
+// 支持的算法名（与 Node 的 crypto.getHashes() 写法一致）
+std::vector<std::string> supportedHashNames();
+
+// 流式摘要（MD5 / SHA-1 / SHA-2），可复制：复制即得到当前状态的副本。
+// SHA-1 / SHA-256 在 CPU 支持时使用硬件指令（x86 SHA-NI、ARMv8 SHA）
+class Digest {
+public:
+  explicit Digest(HashAlgorithm algorithm);
+
+  HashAlgorithm algorithm() const { return _algorithm; }
+  size_t digestSize() const;
+  size_t blockSize() const;
+
+  void update(const uint8_t *data, size_t len);
+  // 计算结果；之后 Digest 回到初始状态
+  std::vector<uint8_t> finish();
+
+private:
+  void reset();
+  void compress(const uint8_t *blocks, size_t count);
+
+  HashAlgorithm _algorithm;
+  // SHA-384 / SHA-512 使用 64 位字，其余使用低 32 位
+  std::array<uint64_t, 8> _state{};
+  std::array<uint8_t, 128> _buffer{};
+  size_t _buffered = 0;
+  uint64_t _length = 0; // 已输入的字节数
+};
+
+// HMAC（RFC 2104），同样可复制
+class Hmac {
+public:
+  Hmac(HashAlgorithm algorithm, const uint8_t *key, size_t keyLen);
+
+  HashAlgorithm algorithm() const { return _inner.algorithm(); }
+  void update(const uint8_t *data, size_t len) { _inner.update(data, len); }
+  std::vector<uint8_t> finish();
+
+private:
+  Digest _inner;
+  Digest _outer;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,126 @@
+// cpp/FileLookupCache.cpp
+#include "FileLookupCache.hpp"
+#include <sys/stat.h>
+
+namespace margelo::nitro::http_server {
+
+FileLookupCache::FileLookupCache(size_t maxEntries, int64_t revalidateMs)
+    : _maxEntries(maxEntries),
+      _revalidate(std::chrono::milliseconds(revalidateMs)) {}
+
+std::optional<FileStat>
+FileLookupCache::statUncached(const std::string &path) {
+  probes.fetch_add(1, std::memory_order_relaxed);
+  struct stat st {};
+  if (::stat(path.c_str(), &st) != 0) {
+    return std::nullopt;
+  }
+  FileStat result;
+  result.size = static_cast<int64_t>(st.st_size);
+#if defined(__APPLE__)
+  result.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 +
+                   st.st_mtimespec.tv_nsec;
+#else
+  result.mtimeNs =
+      static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+  result.isDirectory = S_ISDIR(st.st_mode);
+  return result;
+}
+
+// 返回 -1 表示目录不存在
+int64_t FileLookupCache::probeDirMtime(const std::string &dir) {
+  auto dirStat = statUncached(dir.empty() ? "/" : dir);
+  return dirStat ? dirStat->mtimeNs : -1;
+}
+
+std::optional<int64_t>
+FileLookupCache::cachedDirMtime(const std::string &dir,
+                                Clock::time_point now) const {
+  auto it = _dirs.find(dir);
+  if (it == _dirs.end() || now - it->second.checkedAt >= _revalidate) {
+    return std::nullopt;
+  }
+  return it->second.mtimeNs;
+}
+
+std::optional<FileStat> FileLookupCache::stat(const std::string &path) {
+  auto now = Clock::now();
+  size_t slash = path.rfind('/');
+  std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+
+  // 先在锁内查缓存，需要的系统调用在锁外进行，最后再加锁写入结果
+  std::optional<int64_t> missingDirMtime; // 缓存为不存在时记录的目录 mtime
+  std::optional<int64_t> knownDirMtime;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(path);
+    if (it != _entries.end()) {
+      const Entry &entry = it->second;
+      if (entry.stat) {
+        if (now - entry.checkedAt < _revalidate) {
+          hits.fetch_add(1, std::memory_order_relaxed);
+          return entry.stat;
+        }
+      } else {
+        missingDirMtime = entry.dirMtimeNs;
+      }
+    }
+    knownDirMtime = cachedDirMtime(dir, now);
+    if (missingDirMtime && knownDirMtime == missingDirMtime) {
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+  }
+
+  std::optional<int64_t> probedDirMtime;
+  if (missingDirMtime && !knownDirMtime) {
+    probedDirMtime = probeDirMtime(dir);
+    if (*probedDirMtime == *missingDirMtime) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      DirState &state = _dirs[dir];
+      state.mtimeNs = *probedDirMtime;
+      state.checkedAt = now;
+      return std::nullopt;
+    }
+  }
+
+  Entry entry;
+  entry.stat = statUncached(path);
+  entry.checkedAt = now;
+  if (!entry.stat) {
+    if (knownDirMtime || probedDirMtime) {
+      // 目录在文件之前 stat 过，期间新建的文件会改变目录 mtime
+      entry.dirMtimeNs = knownDirMtime ? *knownDirMtime : *probedDirMtime;
+    } else {
+      probedDirMtime = probeDirMtime(dir);
+      entry.dirMtimeNs = *probedDirMtime;
+      // 目录是在文件之后 stat 的：期间新建的文件会被这次的目录 mtime
+      // 掩盖，所以再确认一次文件仍不存在
+      entry.stat = statUncached(path);
+    }
+  }
+  auto result = entry.stat;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_entries.size() >= _maxEntries) {
+    // 条目上限通常远大于实际路径数，超过后整体清空
+    _entries.clear();
+    _dirs.clear();
+  }
+  if (probedDirMtime) {
+    DirState &state = _dirs[dir];
+    state.mtimeNs = *probedDirMtime;
+    state.checkedAt = now;
+  }
+  _entries[path] = std::move(entry);
+  return result;
+}
+
+void FileLookupCache::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _entries.clear();
+  _dirs.clear();
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,64 @@
+// cpp/FileLookupCache.hpp
+#pragma once
+#include "RequestRegistry.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::http_server {
+
+struct FileStat {
+  int64_t size = 0;
+  int64_t mtimeNs = 0;
+  bool isDirectory = false;
+};
+
+// 桥接层文件探测（SPA 入口、桥接层挂载点）的 stat 缓存
+// - 不存在的路径：父目录 mtime 不变就一直有效（目录内增删文件会改变 mtime）
+// - 存在的路径：文件内容变化不影响目录 mtime，按 revalidateMs 重新 stat
+// 父目录 mtime 本身也最多每 revalidateMs 检查一次，同一目录下的缺失路径共享
+class FileLookupCache {
+public:
+  FileLookupCache(size_t maxEntries, int64_t revalidateMs);
+
+  // stat 的缓存版本；路径不存在时返回 std::nullopt
+  std::optional<FileStat> stat(const std::string &path);
+
+  void clear();
+
+  // 直接由缓存应答、未发出系统调用的次数
+  std::atomic<uint64_t> hits{0};
+  // 实际发出的 stat 次数（含父目录检查）
+  std::atomic<uint64_t> probes{0};
+
+private:
+  struct DirState {
+    int64_t mtimeNs = -1; // -1 表示目录不存在
+    Clock::time_point checkedAt;
+  };
+
+  struct Entry {
+    std::optional<FileStat> stat;
+    int64_t dirMtimeNs = -1; // 记录缺失时父目录的 mtime
+    Clock::time_point checkedAt;
+  };
+
+  // 系统调用在 _mutex 之外进行，慢的 stat 不挡住其他路径的查询
+  std::optional<FileStat> statUncached(const std::string &path);
+  int64_t probeDirMtime(const std::string &dir);
+  // 仍在 revalidate 期内的目录 mtime；调用方持有 _mutex
+  std::optional<int64_t> cachedDirMtime(const std::string &dir,
+                                        Clock::time_point now) const;
+
+  const size_t _maxEntries;
+  const Clock::duration _revalidate;
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, Entry> _entries;
+  std::unordered_map<std::string, DirState> _dirs;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,549 @@
+// cpp/FileReader.cpp
+#include "FileReader.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Android 应用的 seccomp 策略可能直接以 SIGSYS 终止 io_uring 调用，
+// 无法在运行时安全探测，因此只在桌面/嵌入式 Linux 上编译该后端
+#if defined(__linux__) && !defined(__ANDROID__) &&                            \
+    __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+// IO_URING_OP_SUPPORTED 与 IORING_REGISTER_PROBE 同时引入（Linux 5.6 头文件）
+#if defined(__NR_io_uring_setup) && defined(IO_URING_OP_SUPPORTED)
+#define RN_HTTP_HAS_IO_URING 1
+#endif
+#endif
+
+#if RN_HTTP_HAS_IO_URING
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <thread>
+#include <vector>
+#endif
+
+namespace margelo::nitro::http_server {
+
+// 从 fd 读满 out（文件在 fstat 之后变短时按实际长度截断）
+static bool posixRead(int fd, std::string &out) {
+  size_t offset = 0;
+  while (offset < out.size()) {
+    ssize_t n = pread(fd, out.data() + offset, out.size() - offset,
+                      static_cast<off_t>(offset));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      return false;
+    }
+    if (n == 0) {
+      break;
+    }
+    offset += static_cast<size_t>(n);
+  }
+  out.resize(offset);
+  return true;
+}
+
+#if RN_HTTP_HAS_IO_URING
+
+// 环大小和注册缓冲区：不超过 kFixedBufferBytes 的读取使用 READ_FIXED
+static constexpr unsigned kRingEntries = 64;
+static constexpr size_t kFixedBufferCount = 16;
+static constexpr size_t kFixedBufferBytes = 64 * 1024;
+// 单次 READ 的长度上限（sqe->len 为 32 位）
+static constexpr size_t kMaxReadBytes = 1u << 30;
+// 唤醒提交线程的 POLL_ADD 使用的 user_data
+static constexpr uint64_t kWakeTag = 0;
+
+static int uringSetup(unsigned entries, io_uring_params *params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int uringEnter(int fd, unsigned toSubmit, unsigned minComplete,
+                      unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit,
+                                  minComplete, flags, nullptr, 0));
+}
+
+static int uringRegister(int fd, unsigned opcode, const void *arg,
+                         unsigned count) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+class UringReader {
+public:
+  static std::shared_ptr<UringReader> create() {
+    std::shared_ptr<UringReader> reader(new UringReader());
+    if (!reader->setup()) {
+      return nullptr;
+    }
+    reader->_thread = std::thread([raw = reader.get()] { raw->run(); });
+    return reader;
+  }
+
+  ~UringReader() {
+    if (_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+      }
+      wake();
+      _thread.join();
+    }
+    if (_sqes) {
+      munmap(_sqes, _sqesSize);
+    }
+    if (_cqMap && _cqMap != _sqMap) {
+      munmap(_cqMap, _cqMapSize);
+    }
+    if (_sqMap) {
+      munmap(_sqMap, _sqMapSize);
+    }
+    if (_ringFd >= 0) {
+      close(_ringFd);
+    }
+    if (_wakeFd >= 0) {
+      close(_wakeFd);
+    }
+  }
+
+  // 阻塞直到读取完成；out 的长度即要读取的字节数
+  bool read(int fd, std::string &out) {
+    if (out.empty()) {
+      return true;
+    }
+    Op op;
+    op.fd = fd;
+    op.dest = out.data();
+    op.length = out.size();
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_stopping || _failed) {
+        return posixRead(fd, out);
+      }
+      _queue.push_back(&op);
+    }
+    wake();
+    std::unique_lock<std::mutex> lock(_mutex);
+    op.doneCv.wait(lock, [&op] { return op.done; });
+    if (op.result < 0) {
+      return false;
+    }
+    out.resize(op.offset);
+    return true;
+  }
+
+private:
+  struct Op {
+    int fd = -1;
+    char *dest = nullptr;
+    size_t length = 0;
+    size_t offset = 0; // 已读取的字节数
+    int buffer = -1;   // 使用的注册缓冲区，-1 表示直接读入 dest
+    int result = 0;    // 负数为 -errno
+    bool done = false;
+    std::condition_variable doneCv; // 只唤醒等待该操作的线程
+  };
+
+  UringReader() = default;
+
+  bool setup() {
+    io_uring_params params{};
+    _ringFd = uringSetup(kRingEntries, &params);
+    if (_ringFd < 0) {
+      return false;
+    }
+    // 需要 READ / READ_FIXED / POLL_ADD（READ 在 5.6 引入）
+    std::vector<char> probeStorage(sizeof(io_uring_probe) +
+                                   256 * sizeof(io_uring_probe_op));
+    auto *probe = reinterpret_cast<io_uring_probe *>(probeStorage.data());
+    if (uringRegister(_ringFd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+      return false;
+    }
+    for (int opcode : {IORING_OP_READ, IORING_OP_READ_FIXED,
+                       IORING_OP_POLL_ADD}) {
+      if (opcode > probe->last_op ||
+          !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+        return false;
+      }
+    }
+
+    _sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap) {
+      _sqMapSize = _cqMapSize = std::max(_sqMapSize, _cqMapSize);
+    }
+    void *sqMap = mmap(nullptr, _sqMapSize, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQ_RING);
+    if (sqMap == MAP_FAILED) {
+      return false;
+    }
+    _sqMap = sqMap;
+    if (singleMap) {
+      _cqMap = _sqMap;
+    } else {
+      void *cqMap = mmap(nullptr, _cqMapSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, _ringFd,
+                         IORING_OFF_CQ_RING);
+      if (cqMap == MAP_FAILED) {
+        return false;
+      }
+      _cqMap = cqMap;
+    }
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+    _sqes = static_cast<io_uring_sqe *>(sqes);
+
+    auto *sq = static_cast<char *>(_sqMap);
+    _sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    _sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    _sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    _sqEntries = params.sq_entries;
+    auto *cq = static_cast<char *>(_cqMap);
+    _cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    _cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wakeFd < 0) {
+      return false;
+    }
+
+    // 注册缓冲区失败（如 RLIMIT_MEMLOCK 过小）时只用普通 READ
+    _bufferPool.resize(kFixedBufferCount * kFixedBufferBytes);
+    std::vector<iovec> iovecs(kFixedBufferCount);
+    for (size_t i = 0; i < kFixedBufferCount; i++) {
+      iovecs[i].iov_base = _bufferPool.data() + i * kFixedBufferBytes;
+      iovecs[i].iov_len = kFixedBufferBytes;
+    }
+    if (uringRegister(_ringFd, IORING_REGISTER_BUFFERS, iovecs.data(),
+                      kFixedBufferCount) == 0) {
+      for (size_t i = 0; i < kFixedBufferCount; i++) {
+        _freeBuffers.push_back(static_cast<int>(i));
+      }
+    } else {
+      _bufferPool.clear();
+    }
+    return true;
+  }
+
+  void wake() {
+    uint64_t one = 1;
+    ssize_t ignored = write(_wakeFd, &one, sizeof(one));
+    (void)ignored;
+  }
+
+  io_uring_sqe *nextSqe() {
+    unsigned tail = *_sqTail;
+    unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    if (tail - head >= _sqEntries) {
+      return nullptr;
+    }
+    io_uring_sqe *sqe = &_sqes[tail & _sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    _sqArray[tail & _sqMask] = tail & _sqMask;
+    return sqe;
+  }
+
+  void commitSqe() {
+    __atomic_store_n(_sqTail, *_sqTail + 1, __ATOMIC_RELEASE);
+  }
+
+  // SQ 已满时返回 false，操作留待下一轮
+  bool prepareRead(Op *op) {
+    io_uring_sqe *sqe = nextSqe();
+    if (!sqe) {
+      return false;
+    }
+    size_t remaining = op->length - op->offset;
+    if (op->buffer < 0 && op->length <= kFixedBufferBytes &&
+        !_freeBuffers.empty()) {
+      op->buffer = _freeBuffers.back();
+      _freeBuffers.pop_back();
+    }
+    sqe->fd = op->fd;
+    sqe->off = op->offset;
+    sqe->user_data = reinterpret_cast<uint64_t>(op);
+    if (op->buffer >= 0) {
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->addr = reinterpret_cast<uint64_t>(fixedBuffer(op->buffer));
+      sqe->len = static_cast<uint32_t>(remaining);
+      sqe->buf_index = static_cast<uint16_t>(op->buffer);
+    } else {
+      sqe->opcode = IORING_OP_READ;
+      sqe->addr = reinterpret_cast<uint64_t>(op->dest + op->offset);
+      sqe->len = static_cast<uint32_t>(std::min(remaining, kMaxReadBytes));
+    }
+    commitSqe();
+    return true;
+  }
+
+  bool prepareWakePoll() {
+    io_uring_sqe *sqe = nextSqe();
+    if (!sqe) {
+      return false;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = _wakeFd;
+    sqe->poll_events = POLLIN;
+    sqe->user_data = kWakeTag;
+    commitSqe();
+    return true;
+  }
+
+  char *fixedBuffer(int index) {
+    return _bufferPool.data() + static_cast<size_t>(index) * kFixedBufferBytes;
+  }
+
+  void finish(Op *op, std::vector<Op *> &finished) {
+    if (op->buffer >= 0) {
+      _freeBuffers.push_back(op->buffer);
+      op->buffer = -1;
+    }
+    finished.push_back(op);
+  }
+
+  // 提交线程：收集排队的读取，一次 io_uring_enter 提交并等待完成
+  void run() {
+    std::deque<Op *> pending; // 等待提交（新请求、SQ 已满、短读后续读）
+    std::vector<Op *> finished;
+    unsigned inflight = 0;
+    unsigned unsubmitted = 0;
+    bool wakeArmed = false;
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        pending.insert(pending.end(), _queue.begin(), _queue.end());
+        _queue.clear();
+        if (_stopping && pending.empty() && inflight == 0) {
+          return;
+        }
+      }
+      if (!wakeArmed && prepareWakePoll()) {
+        wakeArmed = true;
+        unsubmitted++;
+      }
+      while (!pending.empty() && prepareRead(pending.front())) {
+        pending.pop_front();
+        inflight++;
+        unsubmitted++;
+      }
+
+      int submitted =
+          uringEnter(_ringFd, unsubmitted, 1, IORING_ENTER_GETEVENTS);
+      if (submitted < 0 && errno != EINTR && errno != EBUSY &&
+          errno != EAGAIN) {
+        failPending(pending);
+        if (inflight == 0) {
+          return;
+        }
+        // 已提交的读取仍会写入调用方的内存，必须等它们完成
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      if (submitted > 0) {
+        unsubmitted -= std::min<unsigned>(unsubmitted, submitted);
+      }
+
+      unsigned head = *_cqHead;
+      unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+      for (; head != tail; head++) {
+        const io_uring_cqe &cqe = _cqes[head & _cqMask];
+        if (cqe.user_data == kWakeTag) {
+          uint64_t count = 0;
+          ssize_t ignored = ::read(_wakeFd, &count, sizeof(count));
+          (void)ignored;
+          wakeArmed = false;
+          continue;
+        }
+        auto *op = reinterpret_cast<Op *>(cqe.user_data);
+        inflight--;
+        if (cqe.res == -EAGAIN || cqe.res == -EINTR) {
+          pending.push_back(op);
+        } else if (cqe.res < 0) {
+          op->result = cqe.res;
+          finish(op, finished);
+        } else if (cqe.res == 0) {
+          finish(op, finished); // 文件变短
+        } else {
+          if (op->buffer >= 0) {
+            std::memcpy(op->dest + op->offset, fixedBuffer(op->buffer),
+                        static_cast<size_t>(cqe.res));
+          }
+          op->offset += static_cast<size_t>(cqe.res);
+          if (op->offset < op->length) {
+            pending.push_back(op); // 短读，继续读剩余部分
+          } else {
+            finish(op, finished);
+          }
+        }
+      }
+      __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+      if (!finished.empty()) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (Op *op : finished) {
+          op->done = true;
+          op->doneCv.notify_one();
+        }
+        finished.clear();
+      }
+    }
+  }
+
+  // io_uring_enter 出现无法恢复的错误：未提交的读取失败，之后的读取
+  // 都走 pread
+  void failPending(std::deque<Op *> &pending) {
+    std::cerr << "[FileReader] io_uring_enter failed: " << strerror(errno)
+              << std::endl;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _failed = true;
+    pending.insert(pending.end(), _queue.begin(), _queue.end());
+    _queue.clear();
+    for (Op *op : pending) {
+      if (op->buffer >= 0) {
+        _freeBuffers.push_back(op->buffer);
+        op->buffer = -1;
+      }
+      op->result = -EIO;
+      op->done = true;
+      op->doneCv.notify_one();
+    }
+    pending.clear();
+  }
+
+  int _ringFd = -1;
+  int _wakeFd = -1;
+  void *_sqMap = nullptr;
+  size_t _sqMapSize = 0;
+  void *_cqMap = nullptr;
+  size_t _cqMapSize = 0;
+  io_uring_sqe *_sqes = nullptr;
+  size_t _sqesSize = 0;
+  unsigned *_sqHead = nullptr;
+  unsigned *_sqTail = nullptr;
+  unsigned *_sqArray = nullptr;
+  unsigned _sqMask = 0;
+  unsigned _sqEntries = 0;
+  unsigned *_cqHead = nullptr;
+  unsigned *_cqTail = nullptr;
+  unsigned _cqMask = 0;
+  io_uring_cqe *_cqes = nullptr;
+
+  // 以下只由提交线程访问
+  std::vector<char> _bufferPool;
+  std::vector<int> _freeBuffers;
+
+  std::mutex _mutex;
+  std::deque<Op *> _queue;
+  bool _stopping = false;
+  bool _failed = false;
+  std::thread _thread;
+};
+
+#else
+
+// 非 Linux 平台没有 io_uring，setBackend(IoUring) 总是退回 pread
+class UringReader {
+public:
+  static std::shared_ptr<UringReader> create() { return nullptr; }
+  bool read(int fd, std::string &out) { return posixRead(fd, out); }
+};
+
+#endif
+
+FileReader &FileReader::shared() {
+  static FileReader reader;
+  return reader;
+}
+
+FileReader::Backend FileReader::setBackend(Backend backend) {
+  std::shared_ptr<UringReader> uring;
+  if (backend == Backend::IoUring) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_uring) {
+        return Backend::IoUring;
+      }
+    }
+    uring = UringReader::create();
+    if (!uring) {
+      std::cerr << "[FileReader] io_uring unavailable, using pread"
+                << std::endl;
+    }
+  }
+  // 旧的环在最后一个使用者结束后释放
+  std::shared_ptr<UringReader> previous;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    previous = std::move(_uring);
+    _uring = uring;
+  }
+  return uring ? Backend::IoUring : Backend::Posix;
+}
+
+FileReader::Backend FileReader::backend() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _uring ? Backend::IoUring : Backend::Posix;
+}
+
+std::optional<std::string> FileReader::readFile(const std::string &path,
+                                                size_t maxBytes) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      static_cast<uint64_t>(st.st_size) > maxBytes) {
+    close(fd);
+    return std::nullopt;
+  }
+  std::string contents(static_cast<size_t>(st.st_size), '\0');
+
+  std::shared_ptr<UringReader> uring;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uring = _uring;
+  }
+  bool ok = uring ? uring->read(fd, contents) : posixRead(fd, contents);
+  if (uring && ok) {
+    uringReads.fetch_add(1, std::memory_order_relaxed);
+  }
+  close(fd);
+  if (!ok) {
+    return std::nullopt;
+  }
+  return contents;
+}
+
+std::optional<FileReader::Backend>
+parseFileIoBackend(const std::string &name) {
+  if (name == "posix" || name == "pread") {
+    return FileReader::Backend::Posix;
+  }
+  if (name == "io_uring") {
+    return FileReader::Backend::IoUring;
+  }
+  return std::nullopt;
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,47 @@
+// cpp/FileReader.hpp
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::http_server {
+
+class UringReader;
+
+// 桥接层整文件读取（cache 挂载点的 blob、SPA 入口 HTML 等）的后端
+// 默认使用 pread；Linux（不含 Android）上可切换到 io_uring：所有读取由一个
+// 提交线程批量提交到同一个环，小文件读入预先注册的缓冲区（READ_FIXED），
+// 大文件直接读入目标内存。io_uring 不可用（内核过旧、被禁用等）时自动退回
+// pread
+class FileReader {
+public:
+  enum class Backend { Posix, IoUring };
+
+  static FileReader &shared();
+
+  // 切换后端，返回实际使用的后端；正在进行的读取不受影响
+  Backend setBackend(Backend backend);
+  Backend backend() const;
+
+  // 读取整个文件；文件大于 maxBytes 或读取失败时返回 std::nullopt
+  std::optional<std::string> readFile(const std::string &path,
+                                      size_t maxBytes = SIZE_MAX);
+
+  // 通过 io_uring 完成的读取次数
+  std::atomic<uint64_t> uringReads{0};
+
+private:
+  FileReader() = default;
+
+  mutable std::mutex _mutex;
+  std::shared_ptr<UringReader> _uring; // 为 nullptr 时使用 pread
+};
+
+// 解析配置中的 file_io 值（"posix" / "io_uring"）
+std::optional<FileReader::Backend> parseFileIoBackend(const std::string &name);
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,89 @@
+// cpp/HybridCrypto.cpp
+#include "HybridCrypto.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace margelo::nitro::http_server {
+
+static HashAlgorithm requireAlgorithm(const std::string &algorithm) {
+  auto parsed = parseHashAlgorithm(algorithm);
+  if (!parsed) {
+    throw std::invalid_argument("Digest method not supported: " + algorithm);
+  }
+  return *parsed;
+}
+
+HybridHashContext::HybridHashContext(Digest digest)
+    : HybridObject(TAG), _state(std::move(digest)) {}
+
+HybridHashContext::HybridHashContext(Hmac hmac)
+    : HybridObject(TAG), _state(std::move(hmac)) {}
+
+std::string HybridHashContext::getAlgorithm() {
+  return std::visit(
+      [](const auto &state) { return hashAlgorithmName(state.algorithm()); },
+      _state);
+}
+
+void HybridHashContext::append(const uint8_t *data, size_t len) {
+  if (_finished) {
+    throw std::runtime_error("Digest already called");
+  }
+  std::visit([data, len](auto &state) { state.update(data, len); }, _state);
+}
+
+void HybridHashContext::update(const std::shared_ptr<ArrayBuffer> &data) {
+  if (!data) {
+    append(nullptr, 0);
+    return;
+  }
+  append(data->data(), data->size());
+}
+
+void HybridHashContext::updateString(const std::string &data) {
+  append(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridHashContext::digest() {
+  if (_finished) {
+    throw std::runtime_error("Digest already called");
+  }
+  _finished = true;
+  auto result =
+      std::visit([](auto &state) { return state.finish(); }, _state);
+  return ArrayBuffer::copy(result.data(), result.size());
+}
+
+std::shared_ptr<HybridHashContextSpec> HybridHashContext::copy() {
+  if (_finished) {
+    throw std::runtime_error("Digest already called");
+  }
+  const Digest *digest = std::get_if<Digest>(&_state);
+  if (!digest) {
+    throw std::runtime_error("HMAC state cannot be copied");
+  }
+  return std::make_shared<HybridHashContext>(*digest);
+}
+
+HybridCrypto::HybridCrypto() : HybridObject(TAG) {}
+
+std::shared_ptr<HybridHashContextSpec>
+HybridCrypto::createHash(const std::string &algorithm) {
+  return std::make_shared<HybridHashContext>(
+      Digest(requireAlgorithm(algorithm)));
+}
+
+std::shared_ptr<HybridHashContextSpec>
+HybridCrypto::createHmac(const std::string &algorithm,
+                         const std::shared_ptr<ArrayBuffer> &key) {
+  HashAlgorithm parsed = requireAlgorithm(algorithm);
+  const uint8_t *keyData = key ? key->data() : nullptr;
+  size_t keyLen = key ? key->size() : 0;
+  return std::make_shared<HybridHashContext>(Hmac(parsed, keyData, keyLen));
+}
+
+std::vector<std::string> HybridCrypto::getHashes() {
+  return supportedHashNames();
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,42 @@
+// cpp/HybridCrypto.hpp
+#pragma once
+#include "../nitrogen/generated/shared/c++/HybridCryptoSpec.hpp"
+#include "../nitrogen/generated/shared/c++/HybridHashContextSpec.hpp"
+#include "Digest.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <variant>
+
+namespace margelo::nitro::http_server {
+
+// 一次哈希 / HMAC 计算；只在 JS 线程上同步调用
+class HybridHashContext : public HybridHashContextSpec {
+public:
+  explicit HybridHashContext(Digest digest);
+  explicit HybridHashContext(Hmac hmac);
+
+  std::string getAlgorithm() override;
+  void update(const std::shared_ptr<ArrayBuffer> &data) override;
+  void updateString(const std::string &data) override;
+  std::shared_ptr<ArrayBuffer> digest() override;
+  std::shared_ptr<HybridHashContextSpec> copy() override;
+
+private:
+  void append(const uint8_t *data, size_t len);
+
+  std::variant<Digest, Hmac> _state;
+  bool _finished = false; // digest() 之后不能再使用
+};
+
+class HybridCrypto : public HybridCryptoSpec {
+public:
+  HybridCrypto();
+
+  std::shared_ptr<HybridHashContextSpec>
+  createHash(const std::string &algorithm) override;
+  std::shared_ptr<HybridHashContextSpec>
+  createHmac(const std::string &algorithm,
+             const std::shared_ptr<ArrayBuffer> &key) override;
+  std::vector<std::string> getHashes() override;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,167 @@
+// cpp/HybridFileSystem.cpp
+#include "HybridFileSystem.hpp"
+#include "WorkLane.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// 单次 read() 的长度上限，防止 JS 传入过大的 length 一次分配过多内存
+static constexpr size_t kMaxReadBytes = 64 * 1024 * 1024;
+
+// Node 风格的错误消息："ENOENT: no such file or directory, open '<path>'"
+// JS 侧按冒号前的部分设置 err.code（send 等中间件据此返回 404）
+static std::runtime_error fsError(int err, const char *syscall,
+                                  const std::string &path) {
+  static const std::pair<int, const char *> kCodes[] = {
+      {ENOENT, "ENOENT"}, {EACCES, "EACCES"},   {EPERM, "EPERM"},
+      {EISDIR, "EISDIR"}, {ENOTDIR, "ENOTDIR"}, {ELOOP, "ELOOP"},
+      {EMFILE, "EMFILE"}, {ENFILE, "ENFILE"},   {EIO, "EIO"},
+      {ENAMETOOLONG, "ENAMETOOLONG"},
+  };
+  const char *code = "UNKNOWN";
+  for (const auto &[value, name] : kCodes) {
+    if (value == err) {
+      code = name;
+      break;
+    }
+  }
+  std::string message = std::string(code) + ": " + std::strerror(err) +
+                        ", " + syscall + " '" + path + "'";
+  return std::runtime_error(message);
+}
+
+std::shared_ptr<OpenFile> OpenFile::open(const std::string &path) {
+  int fd;
+  do {
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    throw fsError(errno, "open", path);
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0) {
+    int err = errno;
+    ::close(fd);
+    throw fsError(err, "fstat", path);
+  }
+  if (S_ISDIR(st.st_mode)) {
+    ::close(fd);
+    throw fsError(EISDIR, "read", path);
+  }
+  return std::shared_ptr<OpenFile>(
+      new OpenFile(fd, static_cast<uint64_t>(st.st_size), path));
+}
+
+OpenFile::~OpenFile() { ::close(_fd); }
+
+size_t OpenFile::readAt(uint64_t offset, size_t len, char *out) const {
+  size_t done = 0;
+  while (done < len) {
+    ssize_t n = pread(_fd, out + done, len - done,
+                      static_cast<off_t>(offset + done));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      throw fsError(errno, "read", _path);
+    }
+    if (n == 0) {
+      break;
+    }
+    done += static_cast<size_t>(n);
+  }
+  return done;
+}
+
+HybridFileHandle::HybridFileHandle(std::shared_ptr<OpenFile> file)
+    : HybridObject(TAG), _file(std::move(file)), _size(_file->size()) {}
+
+double HybridFileHandle::getSize() { return static_cast<double>(_size); }
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+HybridFileHandle::read(double position, double length) {
+  auto promise = Promise<std::shared_ptr<ArrayBuffer>>::create();
+  if (!_file) {
+    promise->reject(std::make_exception_ptr(
+        std::runtime_error("File handle is closed")));
+    return promise;
+  }
+  if (!(position >= 0) || !(length >= 0) || std::isinf(position)) {
+    promise->reject(std::make_exception_ptr(
+        std::invalid_argument("Invalid read range")));
+    return promise;
+  }
+  auto offset = static_cast<uint64_t>(position);
+  auto len = static_cast<size_t>(
+      std::min(length, static_cast<double>(kMaxReadBytes)));
+  WorkLanes::shared().fsLane().post([promise, file = _file, offset, len] {
+    try {
+      std::vector<char> buffer(len);
+      size_t n = len > 0 ? file->readAt(offset, len, buffer.data()) : 0;
+      if (n == 0) {
+        promise->resolve(ArrayBuffer::allocate(0));
+      } else {
+        promise->resolve(ArrayBuffer::copy(
+            reinterpret_cast<const uint8_t *>(buffer.data()), n));
+      }
+    } catch (...) {
+      promise->reject(std::current_exception());
+    }
+  });
+  return promise;
+}
+
+void HybridFileHandle::close() { _file.reset(); }
+
+HybridFileSystem::HybridFileSystem() : HybridObject(TAG) {}
+
+std::shared_ptr<Promise<std::shared_ptr<HybridFileHandleSpec>>>
+HybridFileSystem::open(const std::string &path) {
+  auto promise = Promise<std::shared_ptr<HybridFileHandleSpec>>::create();
+  WorkLanes::shared().fsLane().post([promise, path] {
+    try {
+      promise->resolve(
+          std::make_shared<HybridFileHandle>(OpenFile::open(path)));
+    } catch (...) {
+      promise->reject(std::current_exception());
+    }
+  });
+  return promise;
+}
+
+std::shared_ptr<Promise<FileStats>>
+HybridFileSystem::stat(const std::string &path) {
+  auto promise = Promise<FileStats>::create();
+  WorkLanes::shared().fsLane().post([promise, path] {
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+      promise->reject(std::make_exception_ptr(fsError(errno, "stat", path)));
+      return;
+    }
+    FileStats result;
+    result.size = static_cast<double>(st.st_size);
+#if defined(__APPLE__)
+    const struct timespec &mtime = st.st_mtimespec;
+#else
+    const struct timespec &mtime = st.st_mtim;
+#endif
+    result.mtimeMs = static_cast<double>(mtime.tv_sec) * 1000.0 +
+                     static_cast<double>(mtime.tv_nsec) / 1e6;
+    result.mode = static_cast<double>(st.st_mode);
+    result.ino = static_cast<double>(st.st_ino);
+    result.isFile = S_ISREG(st.st_mode);
+    result.isDirectory = S_ISDIR(st.st_mode);
+    promise->resolve(result);
+  });
+  return promise;
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,66 @@
+// cpp/HybridFileSystem.hpp
+#pragma once
+#include "../nitrogen/generated/shared/c++/HybridFileHandleSpec.hpp"
+#include "../nitrogen/generated/shared/c++/HybridFileSystemSpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace margelo::nitro::http_server {
+
+// 只读打开的文件描述符；读取和发送任务各自持有，全部结束后才关闭
+class OpenFile {
+public:
+  // 打开失败或是目录时抛出 Node 风格的错误（"ENOENT: ..., open '<path>'"）
+  static std::shared_ptr<OpenFile> open(const std::string &path);
+  ~OpenFile();
+
+  OpenFile(const OpenFile &) = delete;
+  OpenFile &operator=(const OpenFile &) = delete;
+
+  const std::string &path() const { return _path; }
+  uint64_t size() const { return _size; } // 打开时的大小
+
+  // 从 offset 起读取最多 len 字节到 out，返回读到的字节数（文件末尾时
+  // 少于 len）；读取出错时抛出异常
+  size_t readAt(uint64_t offset, size_t len, char *out) const;
+
+private:
+  OpenFile(int fd, uint64_t size, std::string path)
+      : _fd(fd), _size(size), _path(std::move(path)) {}
+
+  int _fd;
+  uint64_t _size;
+  std::string _path;
+};
+
+class HybridFileHandle : public HybridFileHandleSpec {
+public:
+  explicit HybridFileHandle(std::shared_ptr<OpenFile> file);
+
+  double getSize() override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+  read(double position, double length) override;
+  void close() override;
+
+  // 供 sendFileResponse 使用；close() 之后为 nullptr
+  std::shared_ptr<OpenFile> file() const { return _file; }
+
+private:
+  std::shared_ptr<OpenFile> _file;
+  uint64_t _size;
+};
+
+class HybridFileSystem : public HybridFileSystemSpec {
+public:
+  HybridFileSystem();
+
+  std::shared_ptr<Promise<std::shared_ptr<HybridFileHandleSpec>>>
+  open(const std::string &path) override;
+  std::shared_ptr<Promise<FileStats>> stat(const std::string &path) override;
+};
+
+} // namespace margelo::nitro::http_server
@@ -1,8 +1,25 @@
 // cpp/HybridHttpServer.cpp
 #include "HybridHttpServer.hpp"
+#include "BridgeConfig.hpp"
+#include "BridgeMetrics.hpp"
+#include "ContentDecoder.hpp"
+#include "FileReader.hpp"
+#include "HybridFileSystem.hpp"
+#include "JsonValue.hpp"
+#include "ListenRelay.hpp"
+#include "MemoryStore.hpp"
+#include "RequestReaper.hpp"
+#include "RequestRegistry.hpp"
+#include "TrafficCapture.hpp"
+#include "WorkLane.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <mutex>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 extern "C" {
@@ -27,6 +44,76 @@ struct ServerContext {
 static ServerContext *g_serverContext = nullptr;
 static std::mutex g_contextMutex;
 
+// 调度延迟告警：延迟超过阈值时在 JS 线程上回调
+static std::function<void(const DispatchDelayEvent &)> g_dispatchDelayHandler;
+static double g_dispatchDelayThresholdMs = 0;
+static std::mutex g_dispatchDelayMutex;
+
+// 辅助函数：请求已响应，从活跃请求表摘除并修正调度队列深度
+// bodyLen 为本次一并发送的响应体长度（分块写入的部分已在写入时计入）
+// 返回 nullptr 表示该请求之前已经响应过
+static std::shared_ptr<PendingRequest>
+completeRequest(const std::string &requestId, int statusCode,
+                size_t bodyLen) {
+  auto pending = RequestRegistry::shared().removeRequest(requestId);
+  if (!pending) {
+    return nullptr;
+  }
+  if (!pending->handlerStarted.exchange(true)) {
+    // 处理器从未报告开始执行（例如直接使用 HybridObject 的调用方）
+    BridgeMetrics::shared().dispatchQueueDepth--;
+  }
+  pending->bytesSent += bodyLen;
+  if (pending->breaker) {
+    // Promise 被拒绝（桥接层返回 500）和 5xx 响应都算作失败
+    pending->breaker->record(statusCode < 500, pending->breakerProbe);
+  }
+  // 结束响应的这一次调用也计入
+  BridgeMetrics::shared().recordResponseCalls(++pending->responseCalls);
+  if (pending->captureSeq != 0) {
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - pending->createdAt);
+    TrafficCapture::shared().recordResponse(
+        pending->captureSeq, statusCode,
+        static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0)),
+        pending->bytesSent.load());
+  }
+  return pending;
+}
+
+// 辅助函数：服务器停止时丢弃所有待处理请求
+static void resetPendingRequests() {
+  RequestRegistry::shared().clear();
+  BridgeMetrics::shared().dispatchQueueDepth = 0;
+}
+
+static PendingRequestStage toPendingRequestStage(RequestStage stage) {
+  switch (stage) {
+  case RequestStage::Dispatched:
+    return PendingRequestStage::DISPATCHED;
+  case RequestStage::Handling:
+    return PendingRequestStage::HANDLING;
+  case RequestStage::Reading:
+    return PendingRequestStage::READING;
+  case RequestStage::Writing:
+    return PendingRequestStage::WRITING;
+  }
+  return PendingRequestStage::DISPATCHED;
+}
+
+// 辅助函数：追加一个 "key":"value" 对
+static void appendHeaderEntry(std::string &json, bool &first,
+                              const std::string &key,
+                              const std::string &value) {
+  if (!first) {
+    json += ',';
+  }
+  first = false;
+  appendJsonString(json, key);
+  json += ':';
+  appendJsonString(json, value);
+}
+
 // 辅助函数：序列化 headers 为 JSON 字符串
 static std::string serializeHeaders(
     const std::optional<std::unordered_map<std::string, std::string>>
@@ -38,28 +125,348 @@ static std::string serializeHeaders(
   std::string json = "{";
   bool first = true;
   for (const auto &[key, value] : headers.value()) {
-    if (!first)
-      json += ",";
-    first = false;
-
-    // 简单的 JSON 字符串转义（处理引号和反斜杠）
-    auto escapeJson = [](const std::string &str) -> std::string {
-      std::string escaped;
-      for (char c : str) {
-        if (c == '"' || c == '\\') {
-          escaped += '\\';
-        }
-        escaped += c;
-      }
-      return escaped;
-    };
+    appendHeaderEntry(json, first, key, value);
+  }
+  json += "}";
+  return json;
+}
 
-    json += "\"" + escapeJson(key) + "\":\"" + escapeJson(value) + "\"";
+// 辅助函数：把 JS 传来的响应头转换为 Rust ABI 使用的 JSON
+// Rust 核心把 headers_json 解析为 map，同名键只保留最后一个，因此数组值
+// 按逗号拼接成一个头；Set-Cookie 不能拼接（Expires 中含逗号），只发送最后
+// 一个值（http.ts 的 ServerResponse 在设置多个值时提示，这里只记录一次）
+static std::string serializeResponseHeaders(const ResponseHeaders &headers) {
+  if (std::holds_alternative<std::string>(headers)) {
+    // 兼容旧的 headersJson 调用方式，原样转发
+    const auto &headersJson = std::get<std::string>(headers);
+    return headersJson.empty() ? "{}" : headersJson;
+  }
+
+  const auto &map = std::get<ResponseHeaderMap>(headers);
+  std::string json = "{";
+  bool first = true;
+  for (const auto &[key, value] : map) {
+    if (std::holds_alternative<std::string>(value)) {
+      appendHeaderEntry(json, first, key, std::get<std::string>(value));
+      continue;
+    }
+    const auto &values = std::get<std::vector<std::string>>(value);
+    if (values.empty()) {
+      continue;
+    }
+    bool setCookie =
+        key.size() == 10 &&
+        std::equal(key.begin(), key.end(), "set-cookie",
+                   [](char a, char b) { return std::tolower(a) == b; });
+    if (setCookie) {
+      static std::atomic<bool> warned{false};
+      if (values.size() > 1 && !warned.exchange(true)) {
+        std::cerr << "[HybridHttpServer] Only the last of several Set-Cookie "
+                     "values is sent (logged once)"
+                  << std::endl;
+      }
+      appendHeaderEntry(json, first, key, values.back());
+      continue;
+    }
+    std::string joined = values.front();
+    for (size_t i = 1; i < values.size(); i++) {
+      joined += ", ";
+      joined += values[i];
+    }
+    appendHeaderEntry(json, first, key, joined);
   }
   json += "}";
   return json;
 }
 
+// 辅助函数：取出响应头中声明的 Content-Length，未声明或非法时返回 -1
+static int64_t parseContentLength(const std::string &value) {
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos) {
+    return -1;
+  }
+  return static_cast<int64_t>(std::strtoll(value.c_str(), nullptr, 10));
+}
+
+static std::unordered_map<std::string, std::string>
+parseHeadersJson(const char *headersJson);
+
+static int64_t declaredContentLength(const ResponseHeaders &headers) {
+  auto isContentLength = [](const std::string &name) {
+    return name.size() == 14 &&
+           std::equal(name.begin(), name.end(), "content-length",
+                      [](char a, char b) { return std::tolower(a) == b; });
+  };
+
+  if (std::holds_alternative<std::string>(headers)) {
+    auto parsed = parseHeadersJson(std::get<std::string>(headers).c_str());
+    for (const auto &[key, value] : parsed) {
+      if (isContentLength(key)) {
+        return parseContentLength(value);
+      }
+    }
+    return -1;
+  }
+
+  for (const auto &[key, value] : std::get<ResponseHeaderMap>(headers)) {
+    if (!isContentLength(key)) {
+      continue;
+    }
+    if (std::holds_alternative<std::string>(value)) {
+      return parseContentLength(std::get<std::string>(value));
+    }
+    const auto &values = std::get<std::vector<std::string>>(value);
+    return values.size() == 1 ? parseContentLength(values[0]) : -1;
+  }
+  return -1;
+}
+
+// 辅助函数：若 JS 已通过 beginResponse 提交响应头，则用提交的状态码和响应头
+// 覆盖结束响应时传入的参数
+static void applyCommittedHead(PendingRequest *pending, int &statusCode,
+                               std::string &headersJson) {
+  if (!pending) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(pending->headMutex);
+  if (pending->headCommitted) {
+    statusCode = pending->committedStatus;
+    headersJson = pending->committedHeadersJson;
+  }
+}
+
+// 辅助函数：为跨域请求的响应追加 Access-Control-* 头（JS 已自行设置时不覆盖）
+static void appendCorsHeaders(const CorsPolicy *cors, const std::string &origin,
+                              std::string &headersJson) {
+  if (!cors) {
+    return;
+  }
+  auto headers = cors->responseHeaders(origin);
+  if (!headers ||
+      headersJsonContains(headersJson, "access-control-allow-origin")) {
+    return;
+  }
+  appendHeadersToJson(headersJson, *headers);
+}
+
+static void applyCors(const PendingRequest *pending, std::string &headersJson) {
+  if (pending) {
+    appendCorsHeaders(pending->cors.get(), pending->origin, headersJson);
+  }
+}
+
+// 辅助函数：在指定 lane 上执行 fn，结果通过 Promise 返回
+// 与 Promise::async 相同，但慢的一类工作不会占用其他工作的线程
+template <typename T, typename F>
+static std::shared_ptr<Promise<T>> runOnLane(WorkLane &lane, F &&fn) {
+  auto promise = Promise<T>::create();
+  lane.post([promise, fn = std::forward<F>(fn)]() mutable {
+    try {
+      if constexpr (std::is_void_v<T>) {
+        fn();
+        promise->resolve();
+      } else {
+        promise->resolve(fn());
+      }
+    } catch (...) {
+      promise->reject(std::current_exception());
+    }
+  });
+  return promise;
+}
+
+// 辅助函数：cache 挂载点下的请求，响应发出后把可缓存的响应写入磁盘缓存
+// headersJson 应为追加 CORS 头之前的响应头（命中时按请求的 Origin 重新追加）
+// 写盘在 fs lane 上进行，响应体先复制一份
+static void storeInResponseCache(const PendingRequest *pending, int statusCode,
+                                 const std::string &headersJson,
+                                 const char *body, size_t bodyLen) {
+  if (!pending || !pending->responseCache ||
+      !pending->responseCache->accepts(pending->cacheKey, statusCode,
+                                       headersJson, bodyLen)) {
+    return;
+  }
+  WorkLanes::shared().fsLane().post(
+      [cache = pending->responseCache, key = pending->cacheKey, statusCode,
+       headersJson, contents = std::string(body, bodyLen)] {
+        cache->store(key, statusCode, headersJson, contents.data(),
+                     contents.size());
+      });
+}
+
+// 回收超时未响应的请求：由桥接层直接应答 504（已开始流式写入的请求直接
+// 结束响应），从活跃请求表摘除并按路由记录泄漏
+// 两种情况都按 504 计入统计和熔断器
+static void reapPendingRequest(const std::shared_ptr<PendingRequest> &request) {
+  int statusCode = 504;
+  std::string headersJson = "{\"Content-Type\":\"text/plain\"}";
+  // 还没写出响应体时提交的响应头并未发出，改为发送新的 504；
+  // 已开始流式写入时只能按已发出的响应头结束响应
+  bool streamed = request->bytesSent.load() > 0;
+  if (streamed) {
+    std::lock_guard<std::mutex> lock(request->headMutex);
+    if (request->headCommitted) {
+      statusCode = request->committedStatus;
+      headersJson = request->committedHeadersJson;
+    }
+  }
+  auto pending = completeRequest(request->requestId, 504, 0);
+  if (!pending) {
+    // 刚好在回收前响应了
+    return;
+  }
+  RequestReaper::shared().reaped++;
+  RequestReaper::shared().recordLeak(*pending);
+  std::cerr << "[HTTP Server] Reaped " << pending->method << " "
+            << pending->path << " after no response" << std::endl;
+  if (pending->responseEnded.exchange(true)) {
+    // 响应体已按 Content-Length 发完，只差 JS 调用 endResponse
+    return;
+  }
+  applyCors(pending.get(), headersJson);
+  if (streamed) {
+    end_response(pending->requestId.c_str(), statusCode, headersJson.c_str());
+  } else {
+    static const char kBody[] = "Gateway Timeout";
+    send_response(pending->requestId.c_str(), statusCode, headersJson.c_str(),
+                  kBody, static_cast<int>(sizeof(kBody) - 1));
+  }
+}
+
+// 桥接层处理请求时出错：直接返回 500，不让客户端一直等到超时
+static void failRequest(const std::string &requestId) {
+  if (requestId.empty()) {
+    return;
+  }
+  // 已登记的请求先摘除；已经发出响应的不再重复发送
+  auto pending = completeRequest(requestId, 500, 0);
+  if (pending && pending->responseEnded.exchange(true)) {
+    return;
+  }
+  BridgeMetrics::shared().failedRequests++;
+  std::string headersJson = "{\"Content-Type\":\"text/plain\"}";
+  applyCors(pending.get(), headersJson);
+  static const char kBody[] = "Internal Server Error";
+  send_response(requestId.c_str(), 500, headersJson.c_str(), kBody,
+                static_cast<int>(sizeof(kBody) - 1));
+}
+
+// 压缩的请求体无法解压：数据损坏或被截断返回 400，超过解压限制返回 413
+static void rejectCompressedBody(const std::string &requestId,
+                                 ContentDecoder::Status status,
+                                 const CorsPolicy *cors,
+                                 const std::string &origin) {
+  BridgeMetrics::shared().rejectedCompressedRequests++;
+  bool tooLarge = status == ContentDecoder::Status::TooLarge;
+  std::string headersJson = "{\"Content-Type\":\"text/plain\"}";
+  appendCorsHeaders(cors, origin, headersJson);
+  const char *body = tooLarge ? "Payload Too Large" : "Bad Request";
+  send_response(requestId.c_str(), tooLarge ? 413 : 400, headersJson.c_str(),
+                body, static_cast<int>(std::strlen(body)));
+}
+
+// 辅助函数：解析 Rust 传来的请求头 JSON 字符串
+// 格式：{"key1":"value1","key2":"value2"}
+static std::unordered_map<std::string, std::string>
+parseHeadersJson(const char *headersJson) {
+  std::unordered_map<std::string, std::string> headers;
+  if (!headersJson || strlen(headersJson) == 0) {
+    return headers;
+  }
+  std::string jsonStr(headersJson);
+
+  if (jsonStr.length() >= 2 && jsonStr[0] == '{' &&
+      jsonStr[jsonStr.length() - 1] == '}') {
+    size_t pos = 1; // Skip opening '{'
+
+    while (pos < jsonStr.length() - 1) {
+      // Skip whitespace
+      while (pos < jsonStr.length() && std::isspace(jsonStr[pos]))
+        pos++;
+
+      if (pos >= jsonStr.length() - 1 || jsonStr[pos] == '}')
+        break;
+
+      // Parse key
+      if (jsonStr[pos] != '"')
+        break; // Expect quoted key
+      pos++;   // Skip opening quote
+
+      size_t keyStart = pos;
+      while (pos < jsonStr.length() && jsonStr[pos] != '"') {
+        if (jsonStr[pos] == '\\' && pos + 1 < jsonStr.length()) {
+          pos += 2; // Skip escaped character
+        } else {
+          pos++;
+        }
+      }
+
+      if (pos >= jsonStr.length())
+        break;
+      std::string key = jsonStr.substr(keyStart, pos - keyStart);
+      pos++; // Skip closing quote
+
+      // Skip whitespace and colon
+      while (pos < jsonStr.length() &&
+             (std::isspace(jsonStr[pos]) || jsonStr[pos] == ':'))
+        pos++;
+
+      // Parse value
+      if (pos >= jsonStr.length() || jsonStr[pos] != '"')
+        break; // Expect quoted value
+      pos++;   // Skip opening quote
+
+      size_t valueStart = pos;
+      while (pos < jsonStr.length() && jsonStr[pos] != '"') {
+        if (jsonStr[pos] == '\\' && pos + 1 < jsonStr.length()) {
+          pos += 2; // Skip escaped character
+        } else {
+          pos++;
+        }
+      }
+
+      if (pos >= jsonStr.length())
+        break;
+      std::string value = jsonStr.substr(valueStart, pos - valueStart);
+      pos++; // Skip closing quote
+
+      // Unescape common JSON escape sequences
+      auto unescape = [](const std::string &str) -> std::string {
+        std::string result;
+        for (size_t i = 0; i < str.length(); i++) {
+          if (str[i] == '\\' && i + 1 < str.length()) {
+            char next = str[i + 1];
+            if (next == '"' || next == '\\' || next == '/') {
+              result += next;
+              i++;
+            } else if (next == 'n') {
+              result += '\n';
+              i++;
+            } else if (next == 't') {
+              result += '\t';
+              i++;
+            } else {
+              result += str[i];
+            }
+          } else {
+            result += str[i];
+          }
+        }
+        return result;
+      };
+
+      headers[unescape(key)] = unescape(value);
+
+      // Skip whitespace and comma
+      while (pos < jsonStr.length() &&
+             (std::isspace(jsonStr[pos]) || jsonStr[pos] == ','))
+        pos++;
+    }
+  }
+
+  return headers;
+}
+
 // 辅助函数：从 HttpResponse 提取数据并发送 HTTP 响应
 // 警告：此函数在回调路径中调用，可能在非 JS 线程上执行
 // 因此 **不能** 访问 ArrayBuffer（binaryBody），否则会导致内存损坏
@@ -84,13 +491,345 @@ static void extractAndSendResponse(const std::string &requestId,
     bodyLen = bodyStr.length();
   }
 
+  // 已经通过流式接口或 sendBinaryResponse 响应过的请求不再重复发送
+  auto pending = completeRequest(requestId, statusCode, bodyLen);
+  if (!pending) {
+    return;
+  }
+  std::string sentHeadersJson = headersJson;
+  applyCors(pending.get(), sentHeadersJson);
+
   // std::cout << "[HTTP Server] Sending response for request: " << requestId
   //           << ", status: " << statusCode << ", headers: " << headersJson
   //           << ", body length: " << bodyLen << std::endl;
 
   // 直接发送响应（send_response 内部会将数据复制到 Rust）
-  send_response(requestId.c_str(), statusCode, headersJson.c_str(), body,
+  send_response(requestId.c_str(), statusCode, sentHeadersJson.c_str(), body,
                 static_cast<int>(bodyLen));
+  storeInResponseCache(pending.get(), statusCode, headersJson, body, bodyLen);
+}
+
+// sendFileResponse：不超过该大小的文件整段读入后一次发送（可写入 cache
+// 挂载点），更大的文件按 kFileChunkBytes 分块写入，内存占用有上限
+static constexpr uint64_t kFileSingleShotBytes = 1024 * 1024;
+static constexpr size_t kFileChunkBytes = 256 * 1024;
+
+// 把 file 的 [first, first + length) 分块写入响应，之后由调用方 end_response
+// 读取出错时：还没有写出数据则抛出异常（调用方可以改为应答 500），否则
+// 返回 false，响应按已写出的部分结束
+static bool writeFileChunks(const std::string &requestId, const OpenFile &file,
+                            uint64_t first, uint64_t length,
+                            PendingRequest *pending) {
+  std::vector<char> buffer(kFileChunkBytes);
+  uint64_t offset = first;
+  uint64_t remaining = length;
+  bool ok = true;
+  while (ok && remaining > 0) {
+    size_t n = 0;
+    try {
+      n = file.readAt(offset,
+                      static_cast<size_t>(
+                          std::min<uint64_t>(remaining, buffer.size())),
+                      buffer.data());
+    } catch (...) {
+      if (offset == first) {
+        throw;
+      }
+      return false;
+    }
+    if (n == 0) {
+      // 文件在打开后被截断
+      break;
+    }
+    ok = write_response_chunk(requestId.c_str(), buffer.data(),
+                              static_cast<int>(n));
+    if (pending) {
+      pending->bytesSent += n;
+      pending->touch();
+    }
+    offset += n;
+    remaining -= n;
+  }
+  return ok;
+}
+
+// 由桥接层直接应答的请求：memory / bundle / static 挂载点、cache 命中、
+// SPA 回退
+// 返回 true 表示已应答；否则 responseCache 为请求所属的 cache 挂载点
+static bool answerNatively(const HttpRequest &request,
+                           const BridgeConfig *config, const CorsPolicy *cors,
+                           const std::string &origin,
+                           std::shared_ptr<ResponseCache> &responseCache) {
+  // memory / bundle 挂载点：内容已在原生内存（或只读映射）中，直接由
+  // 桥接层应答
+  std::shared_ptr<const StaticAsset> asset;
+  bool staticMount = false;
+  bool fallthrough = true;
+  bool readRequest = request.method == "GET" || request.method == "HEAD";
+  if (const MemoryMount *memory =
+          config ? config->memoryMountFor(request.path) : nullptr) {
+    staticMount = true;
+    fallthrough = memory->fallthrough;
+    asset = readRequest ? MemoryStore::shared().find(request.path) : nullptr;
+    if (asset) {
+      BridgeMetrics::shared().memoryMountHits++;
+    }
+  } else if (auto bundle =
+                 config ? config->bundleFor(request.path) : nullptr) {
+    staticMount = true;
+    fallthrough = bundle->fallthrough();
+    asset = readRequest ? bundle->find(request.path) : nullptr;
+    if (asset) {
+      BridgeMetrics::shared().bundleHits++;
+    }
+  }
+  if (staticMount && (asset || !fallthrough)) {
+    StaticReply reply;
+    if (asset) {
+      reply = buildStaticReply(*asset, request.method, request.headers);
+    } else {
+      reply.statusCode = 404;
+      reply.headersJson = "{}";
+    }
+    appendCorsHeaders(cors, origin, reply.headersJson);
+    send_response(request.requestId.c_str(), reply.statusCode,
+                  reply.headersJson.c_str(), reply.body,
+                  static_cast<int>(reply.bodyLen));
+    return true;
+  }
+
+  // 开启了 image_variants / cache_rules 的 static 挂载点：文件（或按 Accept
+  // 协商出的兄弟文件）存在时由桥接层发送，未命中交给 JS
+  if (auto mount = readRequest && config
+                       ? config->fileMountFor(request.path)
+                       : nullptr) {
+    if (auto match = mount->resolve(request.path, request.headers)) {
+      std::shared_ptr<OpenFile> file;
+      try {
+        file = OpenFile::open(match->filePath);
+      } catch (const std::exception &) {
+        // 在 stat 缓存之后被删除：当作未命中
+      }
+      if (file) {
+        auto reply = mount->buildReply(*match, file->size(), request.method,
+                                       request.headers);
+        appendCorsHeaders(cors, origin, reply.headersJson);
+        if (match->variant) {
+          BridgeMetrics::shared().imageVariantHits++;
+        }
+        const std::string &requestId = request.requestId;
+        if (reply.length <= kFileSingleShotBytes) {
+          std::string body(static_cast<size_t>(reply.length), '\0');
+          size_t n = 0;
+          try {
+            n = reply.length > 0
+                    ? file->readAt(reply.offset, body.size(), body.data())
+                    : 0;
+          } catch (const std::exception &) {
+            failRequest(requestId);
+            return true;
+          }
+          if (n != body.size()) {
+            // 文件在打开后被截断：响应头中的 Content-Length 已不成立
+            failRequest(requestId);
+            return true;
+          }
+          send_response(requestId.c_str(), reply.statusCode,
+                        reply.headersJson.c_str(), body.data(),
+                        static_cast<int>(n));
+          return true;
+        }
+        try {
+          writeFileChunks(requestId, *file, reply.offset, reply.length,
+                          nullptr);
+        } catch (const std::exception &) {
+          failRequest(requestId);
+          return true;
+        }
+        end_response(requestId.c_str(), reply.statusCode,
+                     reply.headersJson.c_str());
+        return true;
+      }
+    }
+  }
+
+  // cache 挂载点：命中时直接由桥接层应答，未命中的 GET 响应稍后写入缓存
+  if (config &&
+      ResponseCache::cacheableRequest(request.method, request.headers)) {
+    responseCache = config->cacheFor(request.path);
+  }
+  if (responseCache) {
+    if (auto hit = responseCache->lookup(request.path)) {
+      std::string headersJson = std::move(hit->headersJson);
+      appendHeadersToJson(headersJson,
+                          {{"Age", std::to_string(hit->ageSeconds)}});
+      appendCorsHeaders(cors, origin, headersJson);
+      bool withBody = request.method != "HEAD";
+      if (!withBody) {
+        appendContentLength(headersJson, hit->body.size());
+      }
+      BridgeMetrics::shared().responseCacheHits++;
+      send_response(request.requestId.c_str(), hit->statusCode,
+                    headersJson.c_str(), withBody ? hit->body.data() : "",
+                    withBody ? static_cast<int>(hit->body.size()) : 0);
+      return true;
+    }
+  }
+
+  // SPA 回退：静态文件未命中的前端路由直接返回入口 HTML
+  // static_lookup.exclude_prefixes 下的路径跳过桥接层的静态处理
+  bool staticLookup = config && !config->skipsStaticLookup(request.path);
+  if (staticLookup && config->spaFallback &&
+      config->spaFallback->matches(request.method, request.path,
+                                   request.headers)) {
+    int statusCode = 0;
+    std::string headersJson;
+    std::shared_ptr<const std::string> body;
+    if (config->spaFallback->respond(request.headers, statusCode,
+                                     headersJson, body)) {
+      if (request.method == "HEAD" && body) {
+        appendContentLength(headersJson, body->size());
+        body = nullptr;
+      }
+      appendCorsHeaders(cors, origin, headersJson);
+      BridgeMetrics::shared().spaFallbacks++;
+      send_response(request.requestId.c_str(), statusCode,
+                    headersJson.c_str(), body ? body->data() : "",
+                    body ? static_cast<int>(body->size()) : 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+// 登记到活跃请求表并调用 JS 处理器
+static void dispatchToJs(const HandlerType &handler, const HttpRequest &request,
+                         const std::shared_ptr<const CorsPolicy> &cors,
+                         const std::string &origin,
+                         const std::shared_ptr<ResponseCache> &responseCache,
+                         const std::shared_ptr<CircuitBreaker> &breaker,
+                         uint64_t breakerProbe,
+                         const std::shared_ptr<ContentDecoder> &bodyDecoder) {
+  // 请求体已复制到 request 中，流量抓取从这里读取
+  const char *rawBody = nullptr;
+  size_t rawBodyLen = 0;
+  if (request.body.has_value()) {
+    rawBody = request.body->data();
+    rawBodyLen = request.body->size();
+  } else if (request.binaryBody.has_value() && *request.binaryBody) {
+    rawBody = reinterpret_cast<const char *>((*request.binaryBody)->data());
+    rawBodyLen = (*request.binaryBody)->size();
+  }
+
+  // 保存 requestId 用于后续响应
+  std::string requestId = request.requestId;
+
+  // 登记到活跃请求表，响应后摘除
+  auto pending = RequestRegistry::shared().addRequest(
+      requestId, request.method, request.path);
+  RequestReaper::shared().notifyRequestAdded();
+  if (cors) {
+    pending->origin = origin;
+    pending->cors = cors;
+  }
+  if (responseCache && request.method == "GET") {
+    pending->responseCache = responseCache;
+    pending->cacheKey = request.path;
+  }
+  pending->breaker = breaker;
+  pending->breakerProbe = breakerProbe;
+  pending->bodyDecoder = bodyDecoder;
+  if (rawBodyLen > 0) {
+    pending->bytesReceived = static_cast<uint64_t>(rawBodyLen);
+  }
+  pending->captureSeq = TrafficCapture::shared().recordRequest(
+      request.method, request.path, request.headers, rawBody, rawBodyLen);
+  BridgeMetrics::shared().dispatchedRequests++;
+  BridgeMetrics::shared().dispatchQueueDepth++;
+
+  // 调用 JavaScript 回调
+  auto responsePromise = handler(request);
+
+  // 使用 addOnResolvedListener 处理 Promise 结果
+  responsePromise->addOnResolvedListener(
+      [requestId](
+          const std::variant<
+              HttpResponse, std::shared_ptr<Promise<HttpResponse>>> &result) {
+        // 处理返回值（可能是直接的响应或者 Promise）
+        if (std::holds_alternative<HttpResponse>(result)) {
+          HttpResponse response = std::get<HttpResponse>(result);
+          extractAndSendResponse(requestId, response);
+        } else {
+          // 如果是 Promise，等待它完成
+          auto promise =
+              std::get<std::shared_ptr<Promise<HttpResponse>>>(result);
+          promise->addOnResolvedListener(
+              [requestId](const HttpResponse &resp) {
+                extractAndSendResponse(requestId, resp);
+              });
+          promise->addOnRejectedListener(
+              [requestId](const std::exception_ptr &error) {
+                // 发送错误响应
+                HttpResponse errorResp;
+                errorResp.statusCode = 500;
+                errorResp.body = "Internal Server Error";
+                extractAndSendResponse(requestId, errorResp);
+              });
+        }
+      });
+
+  responsePromise->addOnRejectedListener(
+      [requestId](const std::exception_ptr &error) {
+        // 发送错误响应
+        HttpResponse errorResp;
+        errorResp.statusCode = 500;
+        errorResp.body = "Internal Server Error";
+        extractAndSendResponse(requestId, errorResp);
+      });
+}
+
+static void handleRequest(const HandlerType &handler,
+                          const BridgeConfig *config,
+                          const HttpRequest &request,
+                          const std::shared_ptr<const CorsPolicy> &cors,
+                          const std::string &origin,
+                          const std::shared_ptr<ContentDecoder> &bodyDecoder) {
+  std::shared_ptr<ResponseCache> responseCache;
+  if (answerNatively(request, config, cors.get(), origin, responseCache)) {
+    return;
+  }
+  // 熔断器打开时直接返回 fallback 响应，不再投递到 JS
+  auto breaker = config ? config->breakerFor(request.path) : nullptr;
+  uint64_t breakerProbe = 0;
+  if (breaker && !breaker->allow(breakerProbe)) {
+    std::string headersJson = breaker->fallbackHeadersJson();
+    appendCorsHeaders(cors.get(), origin, headersJson);
+    const std::string &body = breaker->fallbackBody();
+    bool withBody = request.method != "HEAD";
+    if (!withBody) {
+      appendContentLength(headersJson, body.size());
+    }
+    send_response(request.requestId.c_str(), breaker->fallbackStatus(),
+                  headersJson.c_str(), withBody ? body.data() : "",
+                  withBody ? static_cast<int>(body.size()) : 0);
+    return;
+  }
+  dispatchToJs(handler, request, cors, origin, responseCache, breaker,
+               breakerProbe, bodyDecoder);
+}
+
+// 可能由 bundle、static、cache 挂载点或 SPA 回退应答的 GET/HEAD 会 stat
+// 或读文件，放到 static lane 上处理，不占用 Rust 的工作线程；memory 挂载点
+// 只读内存
+static bool needsStaticLane(const BridgeConfig &config,
+                            const HttpRequest &request) {
+  if ((request.method != "GET" && request.method != "HEAD") ||
+      config.memoryMountFor(request.path)) {
+    return false;
+  }
+  return config.bundleFor(request.path) || config.fileMountFor(request.path) ||
+         config.cacheFor(request.path) ||
+         (config.spaFallback && !config.skipsStaticLookup(request.path));
 }
 
 // C 回调函数：从 Rust 服务器调用
@@ -126,100 +865,38 @@ static void c_request_callback(::HttpRequest *cRequest) {
     }
 
     // Parse headers JSON
-    request.headers = std::unordered_map<std::string, std::string>();
-    if (cRequest->headers_json && strlen(cRequest->headers_json) > 0) {
-      std::string jsonStr(cRequest->headers_json);
-
-      // Simple JSON parser for headers (assumes well-formed JSON object)
-      // Format: {"key1":"value1","key2":"value2"}
-      if (jsonStr.length() >= 2 && jsonStr[0] == '{' &&
-          jsonStr[jsonStr.length() - 1] == '}') {
-        size_t pos = 1; // Skip opening '{'
-
-        while (pos < jsonStr.length() - 1) {
-          // Skip whitespace
-          while (pos < jsonStr.length() && std::isspace(jsonStr[pos]))
-            pos++;
-
-          if (pos >= jsonStr.length() - 1 || jsonStr[pos] == '}')
-            break;
-
-          // Parse key
-          if (jsonStr[pos] != '"')
-            break; // Expect quoted key
-          pos++;   // Skip opening quote
-
-          size_t keyStart = pos;
-          while (pos < jsonStr.length() && jsonStr[pos] != '"') {
-            if (jsonStr[pos] == '\\' && pos + 1 < jsonStr.length()) {
-              pos += 2; // Skip escaped character
-            } else {
-              pos++;
-            }
-          }
-
-          if (pos >= jsonStr.length())
-            break;
-          std::string key = jsonStr.substr(keyStart, pos - keyStart);
-          pos++; // Skip closing quote
-
-          // Skip whitespace and colon
-          while (pos < jsonStr.length() &&
-                 (std::isspace(jsonStr[pos]) || jsonStr[pos] == ':'))
-            pos++;
-
-          // Parse value
-          if (pos >= jsonStr.length() || jsonStr[pos] != '"')
-            break; // Expect quoted value
-          pos++;   // Skip opening quote
-
-          size_t valueStart = pos;
-          while (pos < jsonStr.length() && jsonStr[pos] != '"') {
-            if (jsonStr[pos] == '\\' && pos + 1 < jsonStr.length()) {
-              pos += 2; // Skip escaped character
-            } else {
-              pos++;
-            }
-          }
-
-          if (pos >= jsonStr.length())
-            break;
-          std::string value = jsonStr.substr(valueStart, pos - valueStart);
-          pos++; // Skip closing quote
-
-          // Unescape common JSON escape sequences
-          auto unescape = [](const std::string &str) -> std::string {
-            std::string result;
-            for (size_t i = 0; i < str.length(); i++) {
-              if (str[i] == '\\' && i + 1 < str.length()) {
-                char next = str[i + 1];
-                if (next == '"' || next == '\\' || next == '/') {
-                  result += next;
-                  i++;
-                } else if (next == 'n') {
-                  result += '\n';
-                  i++;
-                } else if (next == 't') {
-                  result += '\t';
-                  i++;
-                } else {
-                  result += str[i];
-                }
-              } else {
-                result += str[i];
-              }
-            }
-            return result;
-          };
-
-          request.headers[unescape(key)] = unescape(value);
-
-          // Skip whitespace and comma
-          while (pos < jsonStr.length() &&
-                 (std::isspace(jsonStr[pos]) || jsonStr[pos] == ','))
-            pos++;
-        }
+    request.headers = parseHeadersJson(cRequest->headers_json);
+
+    // CORS：预检请求直接在桥接层应答，不再投递到 JS
+    auto config = BridgeConfig::current();
+    std::shared_ptr<const CorsPolicy> cors;
+    std::string origin;
+    if (config) {
+      auto originIt = request.headers.find("origin");
+      if (originIt != request.headers.end()) {
+        cors = config->corsFor(request.path);
+        origin = originIt->second;
+      }
+    }
+    if (cors && request.method == "OPTIONS" &&
+        request.headers.count("access-control-request-method")) {
+      auto requestHeadersIt =
+          request.headers.find("access-control-request-headers");
+      auto headers = cors->preflightHeaders(
+          origin, requestHeadersIt != request.headers.end()
+                      ? requestHeadersIt->second
+                      : std::string());
+      std::string headersJson = "{}";
+      // 不被允许的来源返回 403，浏览器会拒绝后续的实际请求
+      int statusCode = headers ? 204 : 403;
+      if (headers) {
+        appendHeadersToJson(headersJson, *headers);
       }
+      BridgeMetrics::shared().corsPreflights++;
+      send_response(request.requestId.c_str(), statusCode, headersJson.c_str(),
+                    "", 0);
+      free_http_request(cRequest);
+      return;
     }
 
     // Set body - check if this is a buffer upload request
@@ -229,13 +906,47 @@ static void c_request_callback(::HttpRequest *cRequest) {
       isBufferUpload = true;
     }
 
-    if (cRequest->body && cRequest->body_len > 0) {
+    // 压缩的请求体：按 request_decompression 在桥接层解压，JS 收到的是
+    // 解压后的数据，请求头中不再有 Content-Encoding
+    const char *body = cRequest->body;
+    size_t bodyLen = cRequest->body && cRequest->body_len > 0
+                         ? static_cast<size_t>(cRequest->body_len)
+                         : 0;
+    std::string decodedBody;
+    std::shared_ptr<ContentDecoder> bodyDecoder;
+    auto encodingIt = request.headers.find("content-encoding");
+    if (config && config->requestDecompression &&
+        encodingIt != request.headers.end()) {
+      if (auto encoding = ContentDecoder::parseEncoding(encodingIt->second)) {
+        const DecompressionLimits &limits = *config->requestDecompression;
+        if (bodyLen > 0) {
+          auto status = ContentDecoder::decodeAll(*encoding, limits, body,
+                                                  bodyLen, decodedBody);
+          if (status != ContentDecoder::Status::Ok) {
+            rejectCompressedBody(request.requestId, status, cors.get(),
+                                 origin);
+            free_http_request(cRequest);
+            return;
+          }
+          body = decodedBody.data();
+          bodyLen = decodedBody.size();
+          request.headers["content-length"] = std::to_string(bodyLen);
+        } else {
+          // 请求体没有随请求一起到达：由 readRequestBodyChunk 分块解压
+          bodyDecoder = std::make_shared<ContentDecoder>(*encoding, limits);
+          request.headers.erase("content-length");
+        }
+        request.headers.erase("content-encoding");
+        BridgeMetrics::shared().decompressedRequests++;
+      }
+    }
+
+    if (bodyLen > 0) {
       if (isBufferUpload) {
         // For buffer upload, create an ArrayBuffer to hold the binary data
         // Use ArrayBuffer::copy to safely copy the data
-        size_t size = static_cast<size_t>(cRequest->body_len);
         auto buffer = ArrayBuffer::copy(
-            reinterpret_cast<const uint8_t *>(cRequest->body), size);
+            reinterpret_cast<const uint8_t *>(body), bodyLen);
         request.binaryBody = buffer;
 
         // std::cout
@@ -244,58 +955,32 @@ static void c_request_callback(::HttpRequest *cRequest) {
         //     << size << " bytes" << std::endl;
       } else {
         // Regular string body
-        request.body = std::string(cRequest->body, cRequest->body_len);
+        request.body = decodedBody.empty() ? std::string(body, bodyLen)
+                                           : std::move(decodedBody);
       }
     }
 
-    // std::cout << "[HTTP Server] Received request: " << request.method << " "
-    //           << request.path << ", ID: " << request.requestId << std::endl;
-
-    // 保存 requestId 用于后续响应
-    std::string requestId = request.requestId;
-
-    // 调用 JavaScript 回调
-    auto responsePromise = handler(request);
-
-    // 使用 addOnResolvedListener 处理 Promise 结果
-    responsePromise->addOnResolvedListener(
-        [requestId](
-            const std::variant<
-                HttpResponse, std::shared_ptr<Promise<HttpResponse>>> &result) {
-          // 处理返回值（可能是直接的响应或者 Promise）
-          if (std::holds_alternative<HttpResponse>(result)) {
-            HttpResponse response = std::get<HttpResponse>(result);
-            extractAndSendResponse(requestId, response);
-          } else {
-            // 如果是 Promise，等待它完成
-            auto promise =
-                std::get<std::shared_ptr<Promise<HttpResponse>>>(result);
-            promise->addOnResolvedListener(
-                [requestId](const HttpResponse &resp) {
-                  extractAndSendResponse(requestId, resp);
-                });
-            promise->addOnRejectedListener(
-                [requestId](const std::exception_ptr &error) {
-                  // 发送错误响应
-                  HttpResponse errorResp;
-                  errorResp.statusCode = 500;
-                  errorResp.body = "Internal Server Error";
-                  extractAndSendResponse(requestId, errorResp);
-                });
-          }
-        });
-
-    responsePromise->addOnRejectedListener(
-        [requestId](const std::exception_ptr &error) {
-          // 发送错误响应
-          HttpResponse errorResp;
-          errorResp.statusCode = 500;
-          errorResp.body = "Internal Server Error";
-          extractAndSendResponse(requestId, errorResp);
-        });
+    // 请求已完整复制，之后的处理不再访问 cRequest
+    if (config && needsStaticLane(*config, request)) {
+      WorkLanes::shared().staticLane().post(
+          [handler, config, request = std::move(request), cors, origin,
+           bodyDecoder] {
+            try {
+              handleRequest(handler, config.get(), request, cors, origin,
+                            bodyDecoder);
+            } catch (const std::exception &e) {
+              std::cerr << "Error in static lane: " << e.what() << std::endl;
+              failRequest(request.requestId);
+            }
+          });
+    } else {
+      handleRequest(handler, config.get(), request, cors, origin,
+                    bodyDecoder);
+    }
 
   } catch (const std::exception &e) {
     std::cerr << "Error in c_request_callback: " << e.what() << std::endl;
+    failRequest(cRequest->request_id ? cRequest->request_id : "");
   }
 
   // 释放 C 请求资源
@@ -303,7 +988,7 @@ static void c_request_callback(::HttpRequest *cRequest) {
 }
 
 HybridHttpServer::HybridHttpServer() : HybridObject(TAG) {
-  // Constructor
+  RequestReaper::shared().setExpireHandler(reapPendingRequest);
 }
 
 HybridHttpServer::~HybridHttpServer() {
@@ -315,6 +1000,19 @@ HybridHttpServer::~HybridHttpServer() {
   }
 }
 
+// 绑定 listen 中的额外地址（转发到 host:port）；没有配置时关闭上一次的转发
+// 在 Rust 启动前绑定，地址被占用时直接启动失败
+static bool startListenRelay(const BridgeConfig *config,
+                             const std::optional<std::string> &host,
+                             int port) {
+  if (!config || config->listenAddresses.empty()) {
+    ListenRelay::shared().stop();
+    return true;
+  }
+  return ListenRelay::shared().start(config->listenAddresses,
+                                     host.value_or(""), port);
+}
+
 std::shared_ptr<Promise<bool>> HybridHttpServer::start(
     double port,
     const std::function<std::shared_ptr<Promise<
@@ -331,6 +1029,9 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::start(
       g_serverContext->handler = handler;
     }
 
+    // 不带配置：进程级设置恢复默认值
+    BridgeConfig::applyDefaultProcessSettings();
+
     // 启动服务器
     int portInt = static_cast<int>(port);
     const char *hostCStr = host.has_value() ? host.value().c_str() : nullptr;
@@ -360,6 +1061,10 @@ HybridHttpServer::sendResponse(const std::string &requestId,
           bodyLen = bodyStr.length();
         }
 
+        std::string finalHeadersJson = headersJson;
+        applyCors(completeRequest(requestId, statusCode, bodyLen).get(),
+                  finalHeadersJson);
+
         // std::cout << "[HTTP Server] Sending response (sendResponse) for
         // request: "
         //           << requestId << ", status: " << statusCode
@@ -367,14 +1072,16 @@ HybridHttpServer::sendResponse(const std::string &requestId,
         //           bodyLen
         //           << std::endl;
 
-        return send_response(requestId.c_str(), statusCode, headersJson.c_str(),
-                             body, static_cast<int>(bodyLen));
+        return send_response(requestId.c_str(), statusCode,
+                             finalHeadersJson.c_str(), body,
+                             static_cast<int>(bodyLen));
       });
 }
 
 std::shared_ptr<Promise<void>> HybridHttpServer::stop() {
   return Promise<void>::async([]() {
     stop_server();
+    resetPendingRequests();
 
     // 清理回调
     std::lock_guard<std::mutex> lock(g_contextMutex);
@@ -410,6 +1117,305 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::isRunning() {
   });
 }
 
+std::shared_ptr<Promise<ServerActivity>> HybridHttpServer::getActivity() {
+  return Promise<ServerActivity>::async([]() -> ServerActivity {
+    auto now = Clock::now();
+    auto ageMs = [now](Clock::time_point since) -> double {
+      return std::chrono::duration<double, std::milli>(now - since).count();
+    };
+
+    ServerActivity activity;
+    RequestRegistry::shared().forEachRequest([&](const PendingRequest &entry) {
+      PendingRequestInfo info;
+      info.requestId = entry.requestId;
+      info.method = entry.method;
+      info.path = entry.path;
+      info.stage = toPendingRequestStage(entry.stage.load());
+      info.ageMs = ageMs(entry.createdAt);
+      info.bytesReceived = static_cast<double>(entry.bytesReceived.load());
+      info.bytesSent = static_cast<double>(entry.bytesSent.load());
+      activity.pendingRequests.push_back(std::move(info));
+    });
+
+    RequestRegistry::shared().forEachConnection(
+        [&](const ActiveConnection &entry) {
+          ConnectionInfo info;
+          info.connectionId = entry.connectionId;
+          info.protocol = entry.protocol;
+          info.peer = entry.peer;
+          info.path = entry.path;
+          info.ageMs = ageMs(entry.openedAt);
+          info.bytesReceived = static_cast<double>(entry.bytesReceived.load());
+          info.bytesSent = static_cast<double>(entry.bytesSent.load());
+          activity.connections.push_back(std::move(info));
+        });
+
+    return activity;
+  });
+}
+
+void HybridHttpServer::markHandlerStart(const std::string &requestId) {
+  auto pending = RequestRegistry::shared().findRequest(requestId);
+  if (!pending || pending->handlerStarted.exchange(true)) {
+    return;
+  }
+
+  auto &metrics = BridgeMetrics::shared();
+  int64_t queueDepth = --metrics.dispatchQueueDepth;
+  auto expected = RequestStage::Dispatched;
+  pending->stage.compare_exchange_strong(expected, RequestStage::Handling);
+
+  auto delay = Clock::now() - pending->createdAt;
+  auto delayUs =
+      std::chrono::duration_cast<std::chrono::microseconds>(delay).count();
+  metrics.dispatchDelay.record(
+      static_cast<uint64_t>(std::max<int64_t>(delayUs, 0)));
+
+  std::function<void(const DispatchDelayEvent &)> handler;
+  {
+    std::lock_guard<std::mutex> lock(g_dispatchDelayMutex);
+    if (!g_dispatchDelayHandler ||
+        static_cast<double>(delayUs) < g_dispatchDelayThresholdMs * 1000.0) {
+      return;
+    }
+    handler = g_dispatchDelayHandler;
+  }
+
+  DispatchDelayEvent event;
+  event.requestId = requestId;
+  event.method = pending->method;
+  event.path = pending->path;
+  event.delayMs = static_cast<double>(delayUs) / 1000.0;
+  event.queueDepth = static_cast<double>(std::max<int64_t>(queueDepth, 0));
+  try {
+    // 本方法在 JS 线程上同步调用，直接执行回调
+    handler(event);
+  } catch (const std::exception &e) {
+    std::cerr << "Error in dispatch delay handler: " << e.what() << std::endl;
+  }
+}
+
+void HybridHttpServer::setDispatchDelayThreshold(
+    double thresholdMs,
+    const std::optional<std::function<void(const DispatchDelayEvent &)>>
+        &handler) {
+  std::lock_guard<std::mutex> lock(g_dispatchDelayMutex);
+  g_dispatchDelayThresholdMs = thresholdMs;
+  g_dispatchDelayHandler = handler.has_value() ? handler.value() : nullptr;
+}
+
+std::shared_ptr<Promise<BridgeStats>> HybridHttpServer::getBridgeStats() {
+  return Promise<BridgeStats>::async([]() -> BridgeStats {
+    auto &metrics = BridgeMetrics::shared();
+    const auto &histogram = metrics.dispatchDelay;
+    auto toMs = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+
+    BridgeStats stats;
+    stats.dispatchedRequests =
+        static_cast<double>(metrics.dispatchedRequests.load());
+    stats.dispatchQueueDepth = static_cast<double>(
+        std::max<int64_t>(metrics.dispatchQueueDepth.load(), 0));
+    stats.dispatchDelayMeanMs = histogram.mean() / 1000.0;
+    stats.dispatchDelayP50Ms = toMs(histogram.percentile(50));
+    stats.dispatchDelayP90Ms = toMs(histogram.percentile(90));
+    stats.dispatchDelayP99Ms = toMs(histogram.percentile(99));
+    stats.dispatchDelayMaxMs = toMs(histogram.max());
+    auto responses = static_cast<double>(metrics.completedResponses.load());
+    auto nativeCalls = static_cast<double>(metrics.responseNativeCalls.load());
+    stats.completedResponses = responses;
+    stats.nativeCallsPerResponseMean =
+        responses > 0 ? nativeCalls / responses : 0.0;
+    stats.nativeCallsPerResponseMax =
+        static_cast<double>(metrics.maxResponseNativeCalls.load());
+    stats.corsPreflightsAnswered =
+        static_cast<double>(metrics.corsPreflights.load());
+    stats.spaFallbacksServed =
+        static_cast<double>(metrics.spaFallbacks.load());
+    stats.responseCacheHits =
+        static_cast<double>(metrics.responseCacheHits.load());
+    stats.memoryMountHits =
+        static_cast<double>(metrics.memoryMountHits.load());
+    stats.bundleHits = static_cast<double>(metrics.bundleHits.load());
+    stats.failedRequests = static_cast<double>(metrics.failedRequests.load());
+    stats.decompressedRequests =
+        static_cast<double>(metrics.decompressedRequests.load());
+    stats.rejectedCompressedRequests =
+        static_cast<double>(metrics.rejectedCompressedRequests.load());
+    stats.fileResponses = static_cast<double>(metrics.fileResponses.load());
+    stats.imageVariantHits =
+        static_cast<double>(metrics.imageVariantHits.load());
+    stats.reapedRequests =
+        static_cast<double>(RequestReaper::shared().reaped.load());
+    for (const auto &leak : RequestReaper::shared().leaks()) {
+      LeakedRoute route;
+      route.route = leak.route;
+      route.stage = toPendingRequestStage(leak.stage);
+      route.count = static_cast<double>(leak.count);
+      stats.leakedRoutes.push_back(route);
+    }
+    stats.uringFileReads =
+        static_cast<double>(FileReader::shared().uringReads.load());
+    stats.memoryStoreBytes =
+        static_cast<double>(MemoryStore::shared().totalBytes());
+    if (auto config = BridgeConfig::current()) {
+      stats.staticLookupCacheHits =
+          static_cast<double>(config->lookupCache->hits.load());
+      stats.staticLookupProbes =
+          static_cast<double>(config->lookupCache->probes.load());
+      double stores = 0;
+      for (const auto &cache : config->responseCaches) {
+        stores += static_cast<double>(cache->stores.load());
+      }
+      stats.responseCacheStores = stores;
+      for (const auto &breaker : config->circuitBreakers) {
+        CircuitBreakerStats entry;
+        entry.path = breaker->path();
+        switch (breaker->state()) {
+        case CircuitBreaker::State::Closed:
+          entry.state = CircuitState::CLOSED;
+          break;
+        case CircuitBreaker::State::Open:
+          entry.state = CircuitState::OPEN;
+          break;
+        case CircuitBreaker::State::HalfOpen:
+          entry.state = CircuitState::HALF_OPEN;
+          break;
+        }
+        entry.opens = static_cast<double>(breaker->opens.load());
+        entry.shortCircuited =
+            static_cast<double>(breaker->shortCircuited.load());
+        entry.failures = static_cast<double>(breaker->failures.load());
+        entry.msSinceStateChange = breaker->msSinceStateChange();
+        stats.circuitBreakers.push_back(std::move(entry));
+      }
+    }
+    WorkLanes::shared().forEach([&](WorkLane &lane) {
+      LaneStats laneStats;
+      laneStats.name = lane.name();
+      laneStats.threads = static_cast<double>(lane.threads());
+      laneStats.maxThreads = static_cast<double>(lane.maxThreads());
+      laneStats.queueDepth = static_cast<double>(lane.queueDepth());
+      laneStats.maxQueueDepth =
+          static_cast<double>(lane.maxQueueDepth.load());
+      laneStats.active = static_cast<double>(lane.active.load());
+      laneStats.completed = static_cast<double>(lane.completed.load());
+      laneStats.queueWaitP99Ms = toMs(lane.queueWait.percentile(99));
+      laneStats.wakeups = static_cast<double>(lane.wakeups.load());
+      laneStats.wakeupsPerSec = lane.wakeupsPerSec();
+      stats.lanes.push_back(laneStats);
+    });
+    for (const auto &listener : ListenRelay::shared().counters()) {
+      ListenerStats entry;
+      entry.address = listener->address;
+      entry.acceptedConnections =
+          static_cast<double>(listener->acceptedConnections.load());
+      entry.activeConnections =
+          static_cast<double>(listener->activeConnections.load());
+      entry.failedConnections =
+          static_cast<double>(listener->failedConnections.load());
+      entry.bytesReceived = static_cast<double>(listener->bytesReceived.load());
+      entry.bytesSent = static_cast<double>(listener->bytesSent.load());
+      stats.listeners.push_back(std::move(entry));
+    }
+    histogram.forEachBucket([&](uint64_t, uint64_t upperUs, uint64_t count) {
+      LatencyBucket bucket;
+      bucket.upperBoundMs = toMs(upperUs);
+      bucket.count = static_cast<double>(count);
+      stats.dispatchDelayHistogram.push_back(bucket);
+    });
+    return stats;
+  });
+}
+
+std::shared_ptr<Promise<bool>> HybridHttpServer::startTrafficCapture(
+    const std::string &filePath,
+    const std::optional<TrafficCaptureOptions> &options) {
+  TrafficCapture::Settings settings;
+  if (options.has_value()) {
+    const auto &opts = options.value();
+    if (opts.maxBodyBytes.has_value()) {
+      settings.maxBodyBytes =
+          static_cast<uint64_t>(std::max(opts.maxBodyBytes.value(), 0.0));
+    }
+    if (opts.captureHeaders.has_value()) {
+      settings.captureHeaders = opts.captureHeaders.value();
+    }
+    if (opts.redactHeaders.has_value()) {
+      settings.redactHeaders = opts.redactHeaders.value();
+    }
+    if (opts.maxFileBytes.has_value()) {
+      settings.maxFileBytes =
+          static_cast<uint64_t>(std::max(opts.maxFileBytes.value(), 0.0));
+    }
+  }
+  WorkLane &lane = WorkLanes::shared().fsLane();
+  return runOnLane<bool>(lane, [filePath, settings]() -> bool {
+    return TrafficCapture::shared().start(filePath, settings);
+  });
+}
+
+std::shared_ptr<Promise<TrafficCaptureSummary>>
+HybridHttpServer::stopTrafficCapture() {
+  WorkLane &lane = WorkLanes::shared().fsLane();
+  return runOnLane<TrafficCaptureSummary>(lane, []() {
+    auto summary = TrafficCapture::shared().stop();
+    TrafficCaptureSummary result;
+    result.filePath = summary.filePath;
+    result.requests = static_cast<double>(summary.requests);
+    result.responses = static_cast<double>(summary.responses);
+    result.droppedRequests = static_cast<double>(summary.droppedRequests);
+    result.bytesWritten = static_cast<double>(summary.bytesWritten);
+    result.durationMs = summary.durationMs;
+    return result;
+  });
+}
+
+std::shared_ptr<Promise<double>> HybridHttpServer::purgeResponseCache(
+    const std::optional<std::string> &pathPrefix) {
+  WorkLane &lane = WorkLanes::shared().fsLane();
+  return runOnLane<double>(lane, [pathPrefix]() -> double {
+    auto config = BridgeConfig::current();
+    if (!config) {
+      return 0;
+    }
+    size_t removed = 0;
+    for (const auto &cache : config->responseCaches) {
+      if (!pathPrefix.has_value() ||
+          matchesPathPrefix(cache->mountPath(), pathPrefix.value())) {
+        // 整个挂载点都在前缀之下
+        removed += cache->purge("");
+      } else if (matchesPathPrefix(pathPrefix.value(), cache->mountPath())) {
+        removed += cache->purge(pathPrefix.value());
+      }
+    }
+    return static_cast<double>(removed);
+  });
+}
+
+std::shared_ptr<Promise<bool>> HybridHttpServer::memPut(
+    const std::string &path, const std::shared_ptr<ArrayBuffer> &data,
+    const std::optional<std::unordered_map<std::string, std::string>>
+        &headers) {
+  // 在 JS 线程上同步复制 ArrayBuffer，压缩等处理放到异步上下文
+  std::string contents;
+  if (data && data->data() && data->size() > 0) {
+    contents.assign(reinterpret_cast<const char *>(data->data()),
+                    data->size());
+  }
+  auto responseHeaders =
+      headers.value_or(std::unordered_map<std::string, std::string>());
+  WorkLane &lane = WorkLanes::shared().fsLane();
+  return runOnLane<bool>(lane, [path, contents = std::move(contents),
+                                responseHeaders]() mutable -> bool {
+    return MemoryStore::shared().put(path, std::move(contents),
+                                     responseHeaders);
+  });
+}
+
+bool HybridHttpServer::memDelete(const std::string &path) {
+  return MemoryStore::shared().remove(path);
+}
+
 std::shared_ptr<Promise<bool>>
 HybridHttpServer::startStaticServer(double port, const std::string &rootDir,
                                     const std::optional<std::string> &host) {
@@ -429,8 +1435,10 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::startAppServer(
     const std::function<std::shared_ptr<Promise<
         std::variant<HttpResponse, std::shared_ptr<Promise<HttpResponse>>>>>(
         const HttpRequest &)> &handler,
-    const std::optional<std::string> &host) {
-  return Promise<bool>::async([port, rootDir, handler, host]() -> bool {
+    const std::optional<std::string> &host,
+    const std::optional<std::string> &configJson) {
+  return Promise<bool>::async([port, rootDir, handler, host,
+                               configJson]() -> bool {
     // Create or update global context
     {
       std::lock_guard<std::mutex> lock(g_contextMutex);
@@ -440,12 +1448,29 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::startAppServer(
       g_serverContext->handler = handler;
     }
 
+    // App server 只使用桥接层配置（SPA 回退、CORS），Rust 不需要 configJson
+    std::shared_ptr<const BridgeConfig> config;
+    if (configJson.has_value()) {
+      std::string rustConfigJson;
+      config =
+          BridgeConfig::extract(configJson.value(), rustConfigJson, rootDir);
+    } else {
+      BridgeConfig::applyDefaultProcessSettings();
+    }
+    BridgeConfig::install(config);
+
     // Start server
     int portInt = static_cast<int>(port);
+    if (!startListenRelay(config.get(), host, portInt)) {
+      return false;
+    }
     const char *hostCStr = host.has_value() ? host.value().c_str() : nullptr;
     // Using "start_app_server" from C library
     bool success = start_app_server(portInt, hostCStr, rootDir.c_str(),
                                     c_request_callback);
+    if (!success) {
+      ListenRelay::shared().stop();
+    }
 
     return success;
   });
@@ -454,6 +1479,9 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::startAppServer(
 std::shared_ptr<Promise<void>> HybridHttpServer::stopAppServer() {
   return Promise<void>::async([]() {
     stop_app_server();
+    ListenRelay::shared().stop();
+    resetPendingRequests();
+    BridgeConfig::install(nullptr);
 
     // Clean up callback
     std::lock_guard<std::mutex> lock(g_contextMutex);
@@ -479,11 +1507,22 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::startServerWithConfig(
       g_serverContext->handler = handler;
     }
 
+    // 取出桥接层自己处理的配置（CORS 等），其余部分交给 Rust
+    std::string rustConfigJson;
+    auto config = BridgeConfig::extract(configJson, rustConfigJson);
+    BridgeConfig::install(config);
+
     // Start server with config
     int portInt = static_cast<int>(port);
+    if (!startListenRelay(config.get(), host, portInt)) {
+      return false;
+    }
     const char *hostCStr = host.has_value() ? host.value().c_str() : nullptr;
     bool success = start_server_with_config(
-        portInt, hostCStr, c_request_callback, configJson.c_str());
+        portInt, hostCStr, c_request_callback, rustConfigJson.c_str());
+    if (!success) {
+      ListenRelay::shared().stop();
+    }
 
     return success;
   });
@@ -496,20 +1535,49 @@ void HybridHttpServer::sendHttpResponse(const std::string &requestId,
 
 std::shared_ptr<Promise<std::string>>
 HybridHttpServer::readRequestBodyChunk(const std::string &requestId) {
-  return Promise<std::string>::async([requestId]() -> std::string {
+  WorkLane &lane = WorkLanes::shared().uploadLane();
+  return runOnLane<std::string>(lane, [requestId]() -> std::string {
     // Buffer size 64KB
     const int BUFFER_SIZE = 64 * 1024;
     std::vector<char> buffer(BUFFER_SIZE);
 
-    int bytesRead =
-        read_request_body_chunk(requestId.c_str(), buffer.data(), BUFFER_SIZE);
+    auto pending = RequestRegistry::shared().findRequest(requestId);
+    if (pending) {
+      pending->stage = RequestStage::Reading;
+      pending->touch();
+    }
+
+    // 压缩的请求体：一直读到解出数据或请求体结束，空字符串仍表示结束
+    ContentDecoder *decoder = pending ? pending->bodyDecoder.get() : nullptr;
+    std::string decoded;
+    for (;;) {
+      int bytesRead = read_request_body_chunk(requestId.c_str(), buffer.data(),
+                                              BUFFER_SIZE);
 
-    if (bytesRead < 0) {
-      throw std::runtime_error("Failed to read request body chunk");
-    } else if (bytesRead == 0) {
-      return "";
-    } else {
-      return std::string(buffer.data(), bytesRead);
+      if (pending && bytesRead > 0) {
+        pending->bytesReceived += static_cast<uint64_t>(bytesRead);
+        pending->touch();
+      }
+
+      if (bytesRead < 0) {
+        throw std::runtime_error("Failed to read request body chunk");
+      }
+      if (!decoder) {
+        return std::string(buffer.data(), bytesRead);
+      }
+      auto status =
+          decoder->feed(buffer.data(), static_cast<size_t>(bytesRead),
+                        bytesRead == 0, decoded);
+      if (status == ContentDecoder::Status::TooLarge) {
+        BridgeMetrics::shared().rejectedCompressedRequests++;
+        throw std::runtime_error("Request body exceeds decompression limits");
+      } else if (status != ContentDecoder::Status::Ok) {
+        BridgeMetrics::shared().rejectedCompressedRequests++;
+        throw std::runtime_error("Malformed compressed request body");
+      }
+      if (!decoded.empty() || bytesRead == 0) {
+        return decoded;
+      }
     }
   });
 }
@@ -517,24 +1585,88 @@ HybridHttpServer::readRequestBodyChunk(const std::string &requestId) {
 std::shared_ptr<Promise<bool>>
 HybridHttpServer::writeResponseChunk(const std::string &requestId,
                                      const std::string &chunk) {
-  return Promise<bool>::async([requestId, chunk]() -> bool {
-    return write_response_chunk(requestId.c_str(), chunk.c_str(),
-                                static_cast<int>(chunk.length()));
+  WorkLane &lane = WorkLanes::shared().callbackLane();
+  return runOnLane<bool>(lane, [requestId, chunk]() -> bool {
+    auto pending = RequestRegistry::shared().findRequest(requestId);
+    uint64_t bytesSent = 0;
+    if (pending) {
+      pending->stage = RequestStage::Writing;
+      pending->touch();
+      bytesSent = pending->bytesSent += chunk.length();
+      pending->responseCalls++;
+    }
+    bool ok = write_response_chunk(requestId.c_str(), chunk.c_str(),
+                                   static_cast<int>(chunk.length()));
+    if (!ok || !pending) {
+      return ok;
+    }
+
+    // 已提交响应头且响应体达到声明的 Content-Length：不必等待 JS 调用
+    // endResponse，立即把响应交给 Rust 发出
+    int statusCode = 0;
+    std::string headersJson;
+    {
+      std::lock_guard<std::mutex> lock(pending->headMutex);
+      if (!pending->headCommitted || pending->declaredContentLength < 0 ||
+          bytesSent < static_cast<uint64_t>(pending->declaredContentLength)) {
+        return ok;
+      }
+      statusCode = pending->committedStatus;
+      headersJson = pending->committedHeadersJson;
+    }
+    if (!pending->responseEnded.exchange(true)) {
+      applyCors(pending.get(), headersJson);
+      end_response(requestId.c_str(), statusCode, headersJson.c_str());
+    }
+    return ok;
+  });
+}
+
+std::shared_ptr<Promise<bool>>
+HybridHttpServer::beginResponse(const std::string &requestId,
+                                double statusCode,
+                                const ResponseHeaders &headers) {
+  WorkLane &lane = WorkLanes::shared().callbackLane();
+  return runOnLane<bool>(lane, [requestId, statusCode, headers]() -> bool {
+    auto pending = RequestRegistry::shared().findRequest(requestId);
+    if (!pending) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(pending->headMutex);
+    if (pending->headCommitted) {
+      return false;
+    }
+    pending->headCommitted = true;
+    pending->committedStatus = static_cast<int>(statusCode);
+    pending->committedHeadersJson = serializeResponseHeaders(headers);
+    pending->declaredContentLength = declaredContentLength(headers);
+    pending->responseCalls++;
+    return true;
   });
 }
 
 std::shared_ptr<Promise<bool>>
 HybridHttpServer::endResponse(const std::string &requestId, double statusCode,
-                              const std::string &headersJson) {
-  return Promise<bool>::async([requestId, statusCode, headersJson]() -> bool {
+                              const ResponseHeaders &headers) {
+  WorkLane &lane = WorkLanes::shared().callbackLane();
+  return runOnLane<bool>(lane, [requestId, statusCode, headers]() -> bool {
     int code = static_cast<int>(statusCode);
+    std::string headersJson = serializeResponseHeaders(headers);
+    applyCommittedHead(RequestRegistry::shared().findRequest(requestId).get(),
+                       code, headersJson);
+    auto pending = completeRequest(requestId, code, 0);
+    if (pending && pending->responseEnded.exchange(true)) {
+      // 响应体达到 Content-Length 时已经发出
+      return true;
+    }
+    applyCors(pending.get(), headersJson);
     return end_response(requestId.c_str(), code, headersJson.c_str());
   });
 }
 
 std::shared_ptr<Promise<bool>> HybridHttpServer::sendBinaryResponse(
     const std::string &requestId, double statusCode,
-    const std::string &headersJson, const std::shared_ptr<ArrayBuffer> &body) {
+    const ResponseHeaders &headers, const std::shared_ptr<ArrayBuffer> &body) {
   // 关键：在 JS 线程上同步复制 ArrayBuffer 数据
   // 这样可以确保在进入异步上下文之前数据已被安全复制
   std::vector<uint8_t> binaryData;
@@ -549,8 +1681,11 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::sendBinaryResponse(
   int code = static_cast<int>(statusCode);
 
   // 使用移动语义将数据传入异步上下文
-  return Promise<bool>::async([requestId, code, headersJson,
-                               binaryData = std::move(binaryData)]() -> bool {
+  WorkLane &lane = WorkLanes::shared().callbackLane();
+  return runOnLane<bool>(lane, [requestId, code, headers,
+                                binaryData = std::move(binaryData)]() -> bool {
+    std::string headersJson = serializeResponseHeaders(headers);
+    int statusCode = code;
     const char *bodyPtr = "";
     size_t bodyLen = 0;
 
@@ -559,13 +1694,109 @@ std::shared_ptr<Promise<bool>> HybridHttpServer::sendBinaryResponse(
       bodyLen = binaryData.size();
     }
 
+    applyCommittedHead(RequestRegistry::shared().findRequest(requestId).get(),
+                       statusCode, headersJson);
+    auto pending = completeRequest(requestId, statusCode, bodyLen);
+    std::string sentHeadersJson = headersJson;
+    applyCors(pending.get(), sentHeadersJson);
+
     // std::cout
     //     << "[HTTP Server] sendBinaryResponse: sending response for request "
     //     << requestId << ", status: " << code << ", body length: " << bodyLen
     //     << std::endl;
 
-    return send_response(requestId.c_str(), code, headersJson.c_str(), bodyPtr,
-                         static_cast<int>(bodyLen));
+    bool ok = send_response(requestId.c_str(), statusCode,
+                            sentHeadersJson.c_str(), bodyPtr,
+                            static_cast<int>(bodyLen));
+    if (ok) {
+      storeInResponseCache(pending.get(), statusCode, headersJson, bodyPtr,
+                           bodyLen);
+    }
+    return ok;
+  });
+}
+
+std::shared_ptr<Promise<bool>> HybridHttpServer::sendFileResponse(
+    const std::string &requestId, double statusCode,
+    const ResponseHeaders &headers,
+    const std::shared_ptr<HybridFileHandleSpec> &file,
+    std::optional<double> start, std::optional<double> end) {
+  auto handle = std::dynamic_pointer_cast<HybridFileHandle>(file);
+  std::shared_ptr<OpenFile> openFile = handle ? handle->file() : nullptr;
+
+  // 按 fs.createReadStream 的语义计算 [first, first + length)，end 包含在内
+  uint64_t size = openFile ? openFile->size() : 0;
+  uint64_t first = static_cast<uint64_t>(std::max(start.value_or(0.0), 0.0));
+  uint64_t length = 0;
+  if (first < size) {
+    uint64_t last = size - 1;
+    if (end && *end < static_cast<double>(last)) {
+      last = *end < 0 ? 0 : static_cast<uint64_t>(*end);
+    }
+    length = last >= first ? last - first + 1 : 0;
+  }
+  int code = static_cast<int>(statusCode);
+
+  // 读取文件会阻塞，放在 fs lane 上
+  WorkLane &lane = WorkLanes::shared().fsLane();
+  return runOnLane<bool>(lane, [requestId, code, headers, openFile, first,
+                                length]() -> bool {
+    if (!openFile) {
+      throw std::runtime_error("File handle is closed");
+    }
+    std::string headersJson = serializeResponseHeaders(headers);
+    int statusCode = code;
+    auto registered = RequestRegistry::shared().findRequest(requestId);
+    applyCommittedHead(registered.get(), statusCode, headersJson);
+
+    if (length <= kFileSingleShotBytes) {
+      std::string body(static_cast<size_t>(length), '\0');
+      try {
+        if (openFile->readAt(first, body.size(), body.data()) != length) {
+          // 文件在打开后被截断：不发送比请求范围短的响应
+          throw std::runtime_error("File was truncated: " + openFile->path());
+        }
+      } catch (...) {
+        failRequest(requestId);
+        throw;
+      }
+      auto pending = completeRequest(requestId, statusCode, body.size());
+      std::string sentHeadersJson = headersJson;
+      applyCors(pending.get(), sentHeadersJson);
+      bool ok = send_response(requestId.c_str(), statusCode,
+                              sentHeadersJson.c_str(), body.data(),
+                              static_cast<int>(body.size()));
+      if (ok) {
+        BridgeMetrics::shared().fileResponses++;
+        storeInResponseCache(pending.get(), statusCode, headersJson,
+                             body.data(), body.size());
+      }
+      return ok;
+    }
+
+    if (registered) {
+      registered->stage = RequestStage::Writing;
+    }
+    bool ok;
+    try {
+      ok = writeFileChunks(requestId, *openFile, first, length,
+                           registered.get());
+    } catch (...) {
+      failRequest(requestId);
+      throw;
+    }
+
+    auto pending = completeRequest(requestId, statusCode, 0);
+    if (pending && pending->responseEnded.exchange(true)) {
+      return ok;
+    }
+    applyCors(pending.get(), headersJson);
+    ok = end_response(requestId.c_str(), statusCode, headersJson.c_str()) &&
+         ok;
+    if (ok) {
+      BridgeMetrics::shared().fileResponses++;
+    }
+    return ok;
   });
 }
 
@@ -635,6 +1866,29 @@ static void c_websocket_callback(const ::WebSocketEvent *cEvent) {
       event.textData = std::string(cEvent->text_data, cEvent->text_len);
     }
 
+    // 维护活跃连接表
+    auto &registry = RequestRegistry::shared();
+    if (event.type == WebSocketEventType::OPEN) {
+      auto headers = parseHeadersJson(cEvent->headers_json);
+      std::string peer;
+      for (const char *name : {"x-forwarded-for", "x-real-ip"}) {
+        auto it = headers.find(name);
+        if (it != headers.end()) {
+          peer = it->second;
+          break;
+        }
+      }
+      registry.addConnection(event.connectionId, "websocket", peer,
+                             event.path.value_or(""));
+    } else if (event.type == WebSocketEventType::MESSAGE) {
+      if (auto conn = registry.findConnection(event.connectionId)) {
+        conn->bytesReceived += static_cast<uint64_t>(
+            std::max(cEvent->text_len, 0) + std::max(cEvent->binary_len, 0));
+      }
+    } else if (event.type == WebSocketEventType::CLOSE) {
+      registry.removeConnection(event.connectionId);
+    }
+
     // 二进制数据
     if (cEvent->binary_data && cEvent->binary_len > 0) {
       size_t size = static_cast<size_t>(cEvent->binary_len);
@@ -676,6 +1930,9 @@ std::shared_ptr<Promise<bool>>
 HybridHttpServer::wsSendText(const std::string &connectionId,
                              const std::string &message) {
   return Promise<bool>::async([connectionId, message]() -> bool {
+    if (auto conn = RequestRegistry::shared().findConnection(connectionId)) {
+      conn->bytesSent += message.length();
+    }
     return ws_send_text(connectionId.c_str(), message.c_str());
   });
 }
@@ -696,6 +1953,10 @@ HybridHttpServer::wsSendBinary(const std::string &connectionId,
         if (binaryData.empty()) {
           return false;
         }
+        if (auto conn =
+                RequestRegistry::shared().findConnection(connectionId)) {
+          conn->bytesSent += binaryData.size();
+        }
         return ws_send_binary(connectionId.c_str(),
                               reinterpret_cast<const char *>(binaryData.data()),
                               static_cast<int>(binaryData.size()));
@@ -5,6 +5,13 @@
 
 namespace margelo::nitro::http_server {
 
+// endResponse / sendBinaryResponse 的响应头参数：
+// 旧版的 JSON 字符串，或 Record<string, string | string[]>
+using ResponseHeaderValue = std::variant<std::string, std::vector<std::string>>;
+using ResponseHeaderMap =
+    std::unordered_map<std::string, ResponseHeaderValue>;
+using ResponseHeaders = std::variant<std::string, ResponseHeaderMap>;
+
 class HybridHttpServer : public HybridHttpServerSpec {
 public:
   HybridHttpServer();
@@ -28,6 +35,33 @@ public:
 
   std::shared_ptr<Promise<bool>> isRunning() override;
 
+  std::shared_ptr<Promise<ServerActivity>> getActivity() override;
+
+  // JS 线程调度延迟指标
+  void markHandlerStart(const std::string &requestId) override;
+  void setDispatchDelayThreshold(
+      double thresholdMs,
+      const std::optional<std::function<void(const DispatchDelayEvent &)>>
+          &handler) override;
+  std::shared_ptr<Promise<BridgeStats>> getBridgeStats() override;
+
+  // 流量抓取
+  std::shared_ptr<Promise<bool>>
+  startTrafficCapture(const std::string &filePath,
+                      const std::optional<TrafficCaptureOptions> &options) override;
+  std::shared_ptr<Promise<TrafficCaptureSummary>> stopTrafficCapture() override;
+
+  // cache 挂载点
+  std::shared_ptr<Promise<double>>
+  purgeResponseCache(const std::optional<std::string> &pathPrefix) override;
+
+  // memory 挂载点
+  std::shared_ptr<Promise<bool>>
+  memPut(const std::string &path, const std::shared_ptr<ArrayBuffer> &data,
+         const std::optional<std::unordered_map<std::string, std::string>>
+             &headers) override;
+  bool memDelete(const std::string &path) override;
+
   // 静态服务器方法
   std::shared_ptr<Promise<bool>>
   startStaticServer(double port, const std::string &rootDir,
@@ -41,7 +75,8 @@ public:
       const std::function<std::shared_ptr<Promise<
           std::variant<HttpResponse, std::shared_ptr<Promise<HttpResponse>>>>>(
           const HttpRequest &)> &handler,
-      const std::optional<std::string> &host) override;
+      const std::optional<std::string> &host,
+      const std::optional<std::string> &configJson) override;
 
   std::shared_ptr<Promise<void>> stopAppServer() override;
 
@@ -61,15 +96,26 @@ public:
   writeResponseChunk(const std::string &requestId,
                      const std::string &chunk) override;
   std::shared_ptr<Promise<bool>>
+  beginResponse(const std::string &requestId, double statusCode,
+                const ResponseHeaders &headers) override;
+  std::shared_ptr<Promise<bool>>
   endResponse(const std::string &requestId, double statusCode,
-              const std::string &headersJson) override;
+              const ResponseHeaders &headers) override;
 
   // 二进制响应（在 JS 线程上安全复制数据）
   std::shared_ptr<Promise<bool>>
   sendBinaryResponse(const std::string &requestId, double statusCode,
-                     const std::string &headersJson,
+                     const ResponseHeaders &headers,
                      const std::shared_ptr<ArrayBuffer> &body) override;
 
+  // 以文件（或其中一段）作为响应体，在 fs lane 上读取，数据不经过 JS
+  std::shared_ptr<Promise<bool>>
+  sendFileResponse(const std::string &requestId, double statusCode,
+                   const ResponseHeaders &headers,
+                   const std::shared_ptr<HybridFileHandleSpec> &file,
+                   std::optional<double> start,
+                   std::optional<double> end) override;
+
   // ==================== WebSocket API ====================
 
   void setWebSocketHandler(
@@ -0,0 +1,102 @@
+// cpp/HybridZlib.cpp
+#include "HybridZlib.hpp"
+#include "WorkLane.hpp"
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+namespace margelo::nitro::http_server {
+
+static int toFlush(double flush) {
+  int value = static_cast<int>(flush);
+  if (value < Z_NO_FLUSH || value > Z_BLOCK ||
+      static_cast<double>(value) != flush) {
+    throw std::invalid_argument("Invalid flush flag: " +
+                                std::to_string(flush));
+  }
+  return value;
+}
+
+static std::shared_ptr<ArrayBuffer>
+toArrayBuffer(std::vector<uint8_t> &&data) {
+  if (data.empty()) {
+    return ArrayBuffer::allocate(0);
+  }
+  return ArrayBuffer::copy(data.data(), data.size());
+}
+
+HybridZlibStream::HybridZlibStream(ZlibMode mode, const ZlibParams &params)
+    : HybridObject(TAG), _state(std::make_shared<State>(mode, params)) {}
+
+std::string HybridZlibStream::getMode() {
+  return zlibModeName(_state->codec.mode());
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+HybridZlibStream::write(const std::shared_ptr<ArrayBuffer> &chunk,
+                        double flush) {
+  auto promise = Promise<std::shared_ptr<ArrayBuffer>>::create();
+  int flushFlag;
+  try {
+    flushFlag = toFlush(flush);
+  } catch (...) {
+    promise->reject(std::current_exception());
+    return promise;
+  }
+  // JS 传入的 ArrayBuffer 只在本次调用内有效，先在 JS 线程上复制
+  std::vector<uint8_t> input;
+  if (chunk && chunk->size() > 0) {
+    input.assign(chunk->data(), chunk->data() + chunk->size());
+  }
+  WorkLanes::shared().computeLane().post(
+      [promise, state = _state, input = std::move(input), flushFlag] {
+        try {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          promise->resolve(toArrayBuffer(
+              state->codec.process(input.data(), input.size(), flushFlag)));
+        } catch (...) {
+          promise->reject(std::current_exception());
+        }
+      });
+  return promise;
+}
+
+std::shared_ptr<ArrayBuffer>
+HybridZlibStream::writeSync(const std::shared_ptr<ArrayBuffer> &chunk,
+                            double flush) {
+  int flushFlag = toFlush(flush);
+  const uint8_t *data = chunk ? chunk->data() : nullptr;
+  size_t size = chunk ? chunk->size() : 0;
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  return toArrayBuffer(_state->codec.process(data, size, flushFlag));
+}
+
+void HybridZlibStream::reset() {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  _state->codec.reset();
+}
+
+HybridZlib::HybridZlib() : HybridObject(TAG) {}
+
+std::shared_ptr<HybridZlibStreamSpec>
+HybridZlib::createStream(const std::string &mode,
+                         const std::optional<ZlibOptions> &options) {
+  auto parsed = parseZlibMode(mode);
+  if (!parsed) {
+    throw std::invalid_argument("Unknown zlib mode: " + mode);
+  }
+  ZlibParams params;
+  if (options) {
+    params.level = static_cast<int>(options->level.value_or(params.level));
+    params.windowBits =
+        static_cast<int>(options->windowBits.value_or(params.windowBits));
+    params.memLevel =
+        static_cast<int>(options->memLevel.value_or(params.memLevel));
+    params.strategy =
+        static_cast<int>(options->strategy.value_or(params.strategy));
+  }
+  return std::make_shared<HybridZlibStream>(*parsed, params);
+}
+
+} // namespace margelo::nitro::http_server
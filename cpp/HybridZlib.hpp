@@ -0,0 +1,45 @@
+// cpp/HybridZlib.hpp
+#pragma once
+#include "../nitrogen/generated/shared/c++/HybridZlibSpec.hpp"
+#include "../nitrogen/generated/shared/c++/HybridZlibStreamSpec.hpp"
+#include "ZlibCodec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+#include <memory>
+#include <mutex>
+
+namespace margelo::nitro::http_server {
+
+class HybridZlibStream : public HybridZlibStreamSpec {
+public:
+  HybridZlibStream(ZlibMode mode, const ZlibParams &params);
+
+  std::string getMode() override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+  write(const std::shared_ptr<ArrayBuffer> &chunk, double flush) override;
+  std::shared_ptr<ArrayBuffer>
+  writeSync(const std::shared_ptr<ArrayBuffer> &chunk, double flush) override;
+  void reset() override;
+
+private:
+  // compute lane 上的任务持有它，JS 侧释放流对象后仍可安全完成
+  struct State {
+    std::mutex mutex;
+    ZlibCodec codec;
+
+    State(ZlibMode mode, const ZlibParams &params) : codec(mode, params) {}
+  };
+
+  std::shared_ptr<State> _state;
+};
+
+class HybridZlib : public HybridZlibSpec {
+public:
+  HybridZlib();
+
+  std::shared_ptr<HybridZlibStreamSpec>
+  createStream(const std::string &mode,
+               const std::optional<ZlibOptions> &options) override;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,481 @@
+// cpp/JsonValue.cpp
+#include "JsonValue.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace margelo::nitro::http_server {
+
+// 最大嵌套深度，防止恶意输入导致栈溢出
+static constexpr int kMaxDepth = 64;
+
+class JsonParser {
+public:
+  explicit JsonParser(const std::string &text) : _text(text) {}
+
+  bool parseDocument(JsonValue &out) {
+    skipWhitespace();
+    if (!parseValue(out, 0)) {
+      return false;
+    }
+    skipWhitespace();
+    if (_pos != _text.size()) {
+      return fail("trailing characters");
+    }
+    return true;
+  }
+
+  const std::string &error() const { return _error; }
+
+private:
+  bool fail(const char *message) {
+    if (_error.empty()) {
+      _error = std::string(message) + " at offset " + std::to_string(_pos);
+    }
+    return false;
+  }
+
+  void skipWhitespace() {
+    while (_pos < _text.size() &&
+           (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' ||
+            _text[_pos] == '\r')) {
+      _pos++;
+    }
+  }
+
+  bool consumeLiteral(const char *literal) {
+    size_t len = std::char_traits<char>::length(literal);
+    if (_text.compare(_pos, len, literal) != 0) {
+      return fail("invalid literal");
+    }
+    _pos += len;
+    return true;
+  }
+
+  bool parseValue(JsonValue &out, int depth) {
+    if (depth > kMaxDepth) {
+      return fail("nesting too deep");
+    }
+    if (_pos >= _text.size()) {
+      return fail("unexpected end of input");
+    }
+    char c = _text[_pos];
+    switch (c) {
+    case '{':
+      return parseObject(out, depth);
+    case '[':
+      return parseArray(out, depth);
+    case '"':
+      out._type = JsonValue::Type::String;
+      return parseString(out._string);
+    case 't':
+      out._type = JsonValue::Type::Bool;
+      out._bool = true;
+      return consumeLiteral("true");
+    case 'f':
+      out._type = JsonValue::Type::Bool;
+      out._bool = false;
+      return consumeLiteral("false");
+    case 'n':
+      out._type = JsonValue::Type::Null;
+      return consumeLiteral("null");
+    default:
+      return parseNumber(out);
+    }
+  }
+
+  bool parseNumber(JsonValue &out) {
+    size_t start = _pos;
+    if (_pos < _text.size() && _text[_pos] == '-') {
+      _pos++;
+    }
+    bool digits = false;
+    while (_pos < _text.size()) {
+      char c = _text[_pos];
+      if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' ||
+          c == '+' || c == '-') {
+        digits = digits || (c >= '0' && c <= '9');
+        _pos++;
+      } else {
+        break;
+      }
+    }
+    if (!digits) {
+      return fail("invalid number");
+    }
+    out._type = JsonValue::Type::Number;
+    out._string = _text.substr(start, _pos - start);
+    return true;
+  }
+
+  static void appendUtf8(std::string &out, uint32_t cp) {
+    if (cp < 0x80) {
+      out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+      out += static_cast<char>(0xC0 | (cp >> 6));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      out += static_cast<char>(0xE0 | (cp >> 12));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (cp >> 18));
+      out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+
+  bool parseHex4(uint32_t &cp) {
+    if (_pos + 4 > _text.size()) {
+      return fail("invalid unicode escape");
+    }
+    cp = 0;
+    for (int i = 0; i < 4; i++) {
+      char c = _text[_pos++];
+      cp <<= 4;
+      if (c >= '0' && c <= '9') {
+        cp |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        cp |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        cp |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        return fail("invalid unicode escape");
+      }
+    }
+    return true;
+  }
+
+  bool parseString(std::string &out) {
+    _pos++; // 跳过开头的引号
+    out.clear();
+    while (_pos < _text.size()) {
+      char c = _text[_pos++];
+      if (c == '"') {
+        return true;
+      }
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      if (_pos >= _text.size()) {
+        break;
+      }
+      char esc = _text[_pos++];
+      switch (esc) {
+      case '"':
+      case '\\':
+      case '/':
+        out += esc;
+        break;
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u': {
+        uint32_t cp = 0;
+        if (!parseHex4(cp)) {
+          return false;
+        }
+        // UTF-16 代理对
+        if (cp >= 0xD800 && cp <= 0xDBFF && _pos + 6 <= _text.size() &&
+            _text[_pos] == '\\' && _text[_pos + 1] == 'u') {
+          _pos += 2;
+          uint32_t low = 0;
+          if (!parseHex4(low)) {
+            return false;
+          }
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        appendUtf8(out, cp);
+        break;
+      }
+      default:
+        return fail("invalid escape");
+      }
+    }
+    return fail("unterminated string");
+  }
+
+  bool parseArray(JsonValue &out, int depth) {
+    _pos++;
+    out._type = JsonValue::Type::Array;
+    skipWhitespace();
+    if (_pos < _text.size() && _text[_pos] == ']') {
+      _pos++;
+      return true;
+    }
+    for (;;) {
+      JsonValue element;
+      skipWhitespace();
+      if (!parseValue(element, depth + 1)) {
+        return false;
+      }
+      out._elements.push_back(std::move(element));
+      skipWhitespace();
+      if (_pos >= _text.size()) {
+        return fail("unterminated array");
+      }
+      char c = _text[_pos++];
+      if (c == ']') {
+        return true;
+      }
+      if (c != ',') {
+        return fail("expected ',' or ']'");
+      }
+    }
+  }
+
+  bool parseObject(JsonValue &out, int depth) {
+    _pos++;
+    out._type = JsonValue::Type::Object;
+    skipWhitespace();
+    if (_pos < _text.size() && _text[_pos] == '}') {
+      _pos++;
+      return true;
+    }
+    for (;;) {
+      skipWhitespace();
+      if (_pos >= _text.size() || _text[_pos] != '"') {
+        return fail("expected key");
+      }
+      std::string key;
+      if (!parseString(key)) {
+        return false;
+      }
+      skipWhitespace();
+      if (_pos >= _text.size() || _text[_pos] != ':') {
+        return fail("expected ':'");
+      }
+      _pos++;
+      skipWhitespace();
+      JsonValue value;
+      if (!parseValue(value, depth + 1)) {
+        return false;
+      }
+      out._members.emplace_back(std::move(key), std::move(value));
+      skipWhitespace();
+      if (_pos >= _text.size()) {
+        return fail("unterminated object");
+      }
+      char c = _text[_pos++];
+      if (c == '}') {
+        return true;
+      }
+      if (c != ',') {
+        return fail("expected ',' or '}'");
+      }
+    }
+  }
+
+  const std::string &_text;
+  size_t _pos = 0;
+  std::string _error;
+};
+
+JsonValue JsonValue::makeBool(bool value) {
+  JsonValue v;
+  v._type = Type::Bool;
+  v._bool = value;
+  return v;
+}
+
+JsonValue JsonValue::makeNumber(double value) {
+  JsonValue v;
+  v._type = Type::Number;
+  char buf[32];
+  if (std::floor(value) == value && std::fabs(value) < 1e15) {
+    snprintf(buf, sizeof(buf), "%.0f", value);
+  } else {
+    snprintf(buf, sizeof(buf), "%.17g", value);
+  }
+  v._string = buf;
+  return v;
+}
+
+JsonValue JsonValue::makeString(std::string value) {
+  JsonValue v;
+  v._type = Type::String;
+  v._string = std::move(value);
+  return v;
+}
+
+JsonValue JsonValue::makeArray() {
+  JsonValue v;
+  v._type = Type::Array;
+  return v;
+}
+
+JsonValue JsonValue::makeObject() {
+  JsonValue v;
+  v._type = Type::Object;
+  return v;
+}
+
+std::optional<JsonValue> JsonValue::parse(const std::string &text,
+                                          std::string *error) {
+  JsonParser parser(text);
+  JsonValue value;
+  if (!parser.parseDocument(value)) {
+    if (error) {
+      *error = parser.error();
+    }
+    return std::nullopt;
+  }
+  return value;
+}
+
+double JsonValue::asNumber(double fallback) const {
+  if (!isNumber()) {
+    return fallback;
+  }
+  return std::strtod(_string.c_str(), nullptr);
+}
+
+const JsonValue *JsonValue::get(const std::string &key) const {
+  for (const auto &[name, value] : _members) {
+    if (name == key) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+JsonValue *JsonValue::get(const std::string &key) {
+  for (auto &[name, value] : _members) {
+    if (name == key) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+void JsonValue::set(const std::string &key, JsonValue value) {
+  if (JsonValue *existing = get(key)) {
+    *existing = std::move(value);
+  } else {
+    _members.emplace_back(key, std::move(value));
+  }
+}
+
+std::optional<JsonValue> JsonValue::take(const std::string &key) {
+  for (auto it = _members.begin(); it != _members.end(); ++it) {
+    if (it->first == key) {
+      JsonValue value = std::move(it->second);
+      _members.erase(it);
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string> JsonValue::stringList() const {
+  std::vector<std::string> list;
+  if (isString()) {
+    list.push_back(_string);
+  } else if (isArray()) {
+    for (const auto &element : _elements) {
+      if (element.isString()) {
+        list.push_back(element._string);
+      }
+    }
+  }
+  return list;
+}
+
+static void serializeTo(const JsonValue &value, std::string &out) {
+  switch (value.type()) {
+  case JsonValue::Type::Null:
+    out += "null";
+    break;
+  case JsonValue::Type::Bool:
+    out += value.asBool() ? "true" : "false";
+    break;
+  case JsonValue::Type::Number:
+    out += value.asString();
+    break;
+  case JsonValue::Type::String:
+    appendJsonString(out, value.asString());
+    break;
+  case JsonValue::Type::Array: {
+    out += '[';
+    bool first = true;
+    for (const auto &element : value.elements()) {
+      if (!first) {
+        out += ',';
+      }
+      first = false;
+      serializeTo(element, out);
+    }
+    out += ']';
+    break;
+  }
+  case JsonValue::Type::Object: {
+    out += '{';
+    bool first = true;
+    for (const auto &[key, member] : value.members()) {
+      if (!first) {
+        out += ',';
+      }
+      first = false;
+      appendJsonString(out, key);
+      out += ':';
+      serializeTo(member, out);
+    }
+    out += '}';
+    break;
+  }
+  }
+}
+
+std::string JsonValue::serialize() const {
+  std::string out;
+  serializeTo(*this, out);
+  return out;
+}
+
+void appendJsonString(std::string &out, const std::string &str) {
+  out += '"';
+  for (char c : str) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+  }
+  out += '"';
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,78 @@
+// cpp/JsonValue.hpp
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// 最小 JSON DOM，用于在桥接层解析/改写 ServerConfig
+// 对象保留键的原始顺序；数字保留原始文本，重新序列化时不会改变精度
+class JsonValue {
+public:
+  enum class Type { Null, Bool, Number, String, Array, Object };
+  using Member = std::pair<std::string, JsonValue>;
+
+  JsonValue() = default;
+  static JsonValue makeBool(bool value);
+  static JsonValue makeNumber(double value);
+  static JsonValue makeString(std::string value);
+  static JsonValue makeArray();
+  static JsonValue makeObject();
+
+  // 解析失败返回 std::nullopt，error 中给出原因
+  static std::optional<JsonValue> parse(const std::string &text,
+                                        std::string *error = nullptr);
+  std::string serialize() const;
+
+  Type type() const { return _type; }
+  bool isNull() const { return _type == Type::Null; }
+  bool isBool() const { return _type == Type::Bool; }
+  bool isNumber() const { return _type == Type::Number; }
+  bool isString() const { return _type == Type::String; }
+  bool isArray() const { return _type == Type::Array; }
+  bool isObject() const { return _type == Type::Object; }
+
+  bool asBool(bool fallback = false) const {
+    return isBool() ? _bool : fallback;
+  }
+  double asNumber(double fallback = 0) const;
+  const std::string &asString() const { return _string; }
+  std::string asString(const std::string &fallback) const {
+    return isString() ? _string : fallback;
+  }
+
+  // 数组
+  const std::vector<JsonValue> &elements() const { return _elements; }
+  std::vector<JsonValue> &elements() { return _elements; }
+  void push(JsonValue value) { _elements.push_back(std::move(value)); }
+
+  // 对象
+  const std::vector<Member> &members() const { return _members; }
+  std::vector<Member> &members() { return _members; }
+  const JsonValue *get(const std::string &key) const;
+  JsonValue *get(const std::string &key);
+  void set(const std::string &key, JsonValue value);
+  // 删除键，返回被删除的值
+  std::optional<JsonValue> take(const std::string &key);
+
+  // 读取字符串数组（忽略非字符串元素）；单个字符串视为只有一个元素
+  std::vector<std::string> stringList() const;
+
+private:
+  friend class JsonParser;
+
+  Type _type = Type::Null;
+  bool _bool = false;
+  std::string _string; // String 的值，或 Number 的原始文本
+  std::vector<JsonValue> _elements;
+  std::vector<Member> _members;
+};
+
+// 以 JSON 字符串字面量形式追加到 out（含引号）
+void appendJsonString(std::string &out, const std::string &str);
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,137 @@
+// cpp/LatencyHistogram.hpp
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::http_server {
+
+// 对数-线性分桶的延迟直方图（HdrHistogram 的简化版），单位为微秒
+// 每个 2 的幂区间再细分 8 个子桶，分位数的相对误差不超过 12.5%
+// 所有计数都是原子变量，可在多个线程上并发 record()
+class LatencyHistogram {
+public:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr uint64_t kSubBucketCount = 1ull << kSubBucketBits;
+  static constexpr size_t kBucketCount =
+      kSubBucketCount + (64 - kSubBucketBits) * kSubBucketCount;
+
+  void record(uint64_t valueUs) {
+    _buckets[indexOf(valueUs)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(valueUs, std::memory_order_relaxed);
+    uint64_t prevMax = _max.load(std::memory_order_relaxed);
+    while (valueUs > prevMax &&
+           !_max.compare_exchange_weak(prevMax, valueUs,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  // 合并另一个直方图（例如每个线程各自记录后汇总）
+  void merge(const LatencyHistogram &other) {
+    for (size_t i = 0; i < kBucketCount; i++) {
+      uint64_t n = other._buckets[i].load(std::memory_order_relaxed);
+      if (n > 0) {
+        _buckets[i].fetch_add(n, std::memory_order_relaxed);
+      }
+    }
+    _count.fetch_add(other.count(), std::memory_order_relaxed);
+    _sum.fetch_add(other._sum.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    uint64_t otherMax = other.max();
+    uint64_t prevMax = _max.load(std::memory_order_relaxed);
+    while (otherMax > prevMax &&
+           !_max.compare_exchange_weak(prevMax, otherMax,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() {
+    for (auto &bucket : _buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+  }
+
+  uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+  uint64_t max() const { return _max.load(std::memory_order_relaxed); }
+
+  double mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0
+                  : static_cast<double>(_sum.load(std::memory_order_relaxed)) /
+                        static_cast<double>(n);
+  }
+
+  // 返回落入第 percentile 分位（0-100）的桶上界，不超过观测到的最大值
+  uint64_t percentile(double percentile) const {
+    uint64_t n = count();
+    if (n == 0) {
+      return 0;
+    }
+    auto target = static_cast<uint64_t>(percentile / 100.0 *
+                                        static_cast<double>(n) + 0.5);
+    if (target == 0) {
+      target = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+      seen += _buckets[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        uint64_t upper = upperBoundOf(i);
+        return upper < max() ? upper : max();
+      }
+    }
+    return max();
+  }
+
+  // 遍历所有非空桶：visit(lowerUs, upperUs, count)
+  template <typename F> void forEachBucket(F &&visit) const {
+    for (size_t i = 0; i < kBucketCount; i++) {
+      uint64_t n = _buckets[i].load(std::memory_order_relaxed);
+      if (n > 0) {
+        visit(lowerBoundOf(i), upperBoundOf(i), n);
+      }
+    }
+  }
+
+  static size_t indexOf(uint64_t value) {
+    if (value < kSubBucketCount) {
+      return static_cast<size_t>(value);
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    int shift = exponent - kSubBucketBits;
+    uint64_t sub = (value >> shift) & (kSubBucketCount - 1);
+    return static_cast<size_t>(kSubBucketCount +
+                               static_cast<uint64_t>(shift) * kSubBucketCount +
+                               sub);
+  }
+
+  static uint64_t lowerBoundOf(size_t index) {
+    if (index < kSubBucketCount) {
+      return index;
+    }
+    uint64_t shift = (index - kSubBucketCount) / kSubBucketCount;
+    uint64_t sub = (index - kSubBucketCount) % kSubBucketCount;
+    return (kSubBucketCount + sub) << shift;
+  }
+
+  static uint64_t upperBoundOf(size_t index) {
+    if (index < kSubBucketCount) {
+      return index;
+    }
+    uint64_t shift = (index - kSubBucketCount) / kSubBucketCount;
+    return lowerBoundOf(index) + (1ull << shift) - 1;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> _buckets{};
+  std::atomic<uint64_t> _count{0};
+  std::atomic<uint64_t> _sum{0};
+  std::atomic<uint64_t> _max{0};
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,472 @@
+// cpp/ListenRelay.cpp
+#include "ListenRelay.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <list>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace margelo::nitro::http_server {
+
+// 每个方向的转发缓冲区
+static constexpr size_t kRelayBufferBytes = 64 * 1024;
+static constexpr int kListenBacklog = 128;
+
+#ifdef MSG_NOSIGNAL
+static constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int kSendFlags = 0;
+#endif
+
+std::optional<ListenAddress> ListenAddress::parse(const std::string &text) {
+  ListenAddress address;
+  address.text = text;
+  if (text.compare(0, 5, "unix:") == 0) {
+    address.family = Family::Unix;
+    address.host = text.substr(5);
+    if (address.host.empty() ||
+        address.host.size() >= sizeof(sockaddr_un::sun_path)) {
+      return std::nullopt;
+    }
+    return address;
+  }
+
+  std::string port;
+  if (!text.empty() && text.front() == '[') {
+    size_t close = text.find("]:");
+    if (close == std::string::npos) {
+      return std::nullopt;
+    }
+    address.family = Family::IPv6;
+    address.host = text.substr(1, close - 1);
+    port = text.substr(close + 2);
+  } else {
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos) {
+      return std::nullopt;
+    }
+    address.host = text.substr(0, colon);
+    port = text.substr(colon + 1);
+    if (address.host.empty()) {
+      address.host = "0.0.0.0";
+    } else if (address.host == "localhost") {
+      address.host = "127.0.0.1";
+    }
+  }
+  if (port.empty() || port.size() > 5 ||
+      port.find_first_not_of("0123456789") != std::string::npos) {
+    return std::nullopt;
+  }
+  address.port = std::stoi(port);
+  if (address.port <= 0 || address.port > 65535) {
+    return std::nullopt;
+  }
+  unsigned char probe[sizeof(in6_addr)];
+  int family = address.family == Family::IPv6 ? AF_INET6 : AF_INET;
+  if (inet_pton(family, address.host.c_str(), probe) != 1) {
+    return std::nullopt;
+  }
+  return address;
+}
+
+namespace {
+
+struct RelayListener {
+  int fd = -1;
+  std::shared_ptr<ListenerCounters> counters;
+};
+
+// 主监听地址（转发目标）
+struct Upstream {
+  sockaddr_storage addr{};
+  socklen_t length = 0;
+};
+
+// 一个方向的转发状态：缓冲区清空后才从源读取下一段
+struct Flow {
+  std::unique_ptr<char[]> buffer{new char[kRelayBufferBytes]};
+  size_t offset = 0;
+  size_t length = 0;
+  bool eof = false;  // 源已关闭写端
+  bool shut = false; // 已对目标 shutdown(SHUT_WR)
+};
+
+struct RelayConnection {
+  int client = -1;
+  int upstream = -1;
+  bool connecting = true;
+  bool dead = false;
+  Flow toUpstream;
+  Flow toClient;
+  std::shared_ptr<ListenerCounters> counters;
+};
+
+} // namespace
+
+static void setNonBlocking(int fd) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+}
+
+static bool isTransient(int error) {
+  return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+}
+
+static std::optional<Upstream> resolveUpstream(const std::string &host,
+                                               int port) {
+  // 主地址监听所有网卡时，经回环地址连接
+  std::string target = host;
+  if (target.empty() || target == "0.0.0.0" || target == "localhost") {
+    target = "127.0.0.1";
+  } else if (target == "::" || target == "[::]") {
+    target = "::1";
+  } else if (target.size() > 2 && target.front() == '[' &&
+             target.back() == ']') {
+    target = target.substr(1, target.size() - 2);
+  }
+  addrinfo hints{};
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_NUMERICSERV;
+  addrinfo *result = nullptr;
+  if (getaddrinfo(target.c_str(), std::to_string(port).c_str(), &hints,
+                  &result) != 0 ||
+      !result) {
+    return std::nullopt;
+  }
+  Upstream upstream;
+  std::memcpy(&upstream.addr, result->ai_addr, result->ai_addrlen);
+  upstream.length = static_cast<socklen_t>(result->ai_addrlen);
+  freeaddrinfo(result);
+  return upstream;
+}
+
+// 绑定并监听一个地址；失败时返回 -1，errno 为失败原因
+static int bindListener(const ListenAddress &address) {
+  sockaddr_storage storage{};
+  socklen_t length = 0;
+  int family = AF_INET;
+  if (address.family == ListenAddress::Family::Unix) {
+    family = AF_UNIX;
+    auto *addr = reinterpret_cast<sockaddr_un *>(&storage);
+    addr->sun_family = AF_UNIX;
+    std::strncpy(addr->sun_path, address.host.c_str(),
+                 sizeof(addr->sun_path) - 1);
+    length = sizeof(sockaddr_un);
+    // 上次异常退出留下的 socket 文件
+    unlink(address.host.c_str());
+  } else if (address.family == ListenAddress::Family::IPv6) {
+    family = AF_INET6;
+    auto *addr = reinterpret_cast<sockaddr_in6 *>(&storage);
+    addr->sin6_family = AF_INET6;
+    addr->sin6_port = htons(static_cast<uint16_t>(address.port));
+    inet_pton(AF_INET6, address.host.c_str(), &addr->sin6_addr);
+    length = sizeof(sockaddr_in6);
+  } else {
+    auto *addr = reinterpret_cast<sockaddr_in *>(&storage);
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(static_cast<uint16_t>(address.port));
+    inet_pton(AF_INET, address.host.c_str(), &addr->sin_addr);
+    length = sizeof(sockaddr_in);
+  }
+
+  int fd = socket(family, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  int one = 1;
+  if (family != AF_UNIX) {
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  }
+  if (family == AF_INET6) {
+    // [::]:port 不占用同端口的 IPv4 地址
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &one, sizeof(one));
+  }
+  if (bind(fd, reinterpret_cast<sockaddr *>(&storage), length) != 0 ||
+      listen(fd, kListenBacklog) != 0) {
+    int error = errno;
+    close(fd);
+    errno = error;
+    return -1;
+  }
+  setNonBlocking(fd);
+  return fd;
+}
+
+// 从 from 读到 flow 的缓冲区；返回 false 表示连接出错
+static bool fillFlow(int from, Flow &flow, std::atomic<uint64_t> &bytes) {
+  ssize_t n = recv(from, flow.buffer.get(), kRelayBufferBytes, 0);
+  if (n > 0) {
+    flow.offset = 0;
+    flow.length = static_cast<size_t>(n);
+    bytes.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+    return true;
+  }
+  if (n == 0) {
+    flow.eof = true;
+    return true;
+  }
+  return isTransient(errno);
+}
+
+// 把 flow 中的数据写到 to，源已关闭且数据写完时关闭 to 的写端
+static bool drainFlow(int to, Flow &flow) {
+  while (flow.length > 0) {
+    ssize_t n = send(to, flow.buffer.get() + flow.offset, flow.length,
+                     kSendFlags);
+    if (n < 0) {
+      return isTransient(errno);
+    }
+    flow.offset += static_cast<size_t>(n);
+    flow.length -= static_cast<size_t>(n);
+  }
+  if (flow.eof && !flow.shut) {
+    shutdown(to, SHUT_WR);
+    flow.shut = true;
+  }
+  return true;
+}
+
+static void acceptConnections(const RelayListener &listener,
+                              const Upstream &upstream,
+                              std::list<RelayConnection> &connections) {
+  for (;;) {
+    int client = accept(listener.fd, nullptr, nullptr);
+    if (client < 0) {
+      return;
+    }
+    setNonBlocking(client);
+    listener.counters->acceptedConnections++;
+    int fd = socket(upstream.addr.ss_family, SOCK_STREAM, 0);
+    if (fd >= 0) {
+      setNonBlocking(fd);
+    }
+    if (fd < 0 ||
+        (connect(fd, reinterpret_cast<const sockaddr *>(&upstream.addr),
+                 upstream.length) != 0 &&
+         errno != EINPROGRESS)) {
+      listener.counters->failedConnections++;
+      if (fd >= 0) {
+        close(fd);
+      }
+      close(client);
+      continue;
+    }
+    listener.counters->activeConnections++;
+    RelayConnection &connection = connections.emplace_back();
+    connection.client = client;
+    connection.upstream = fd;
+    connection.counters = listener.counters;
+  }
+}
+
+static void serviceConnection(RelayConnection &c, short clientEvents,
+                              short upstreamEvents) {
+  if ((clientEvents | upstreamEvents) & POLLNVAL) {
+    c.dead = true;
+    return;
+  }
+  if (c.connecting && upstreamEvents) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    getsockopt(c.upstream, SOL_SOCKET, SO_ERROR, &error, &length);
+    if (error != 0) {
+      c.counters->failedConnections++;
+      c.dead = true;
+      return;
+    }
+    c.connecting = false;
+  } else if (!c.connecting && upstreamEvents && c.toClient.length == 0 &&
+             !c.toClient.eof) {
+    c.dead |= !fillFlow(c.upstream, c.toClient, c.counters->bytesSent);
+  }
+  if (clientEvents && c.toUpstream.length == 0 && !c.toUpstream.eof) {
+    c.dead |= !fillFlow(c.client, c.toUpstream, c.counters->bytesReceived);
+  }
+  if (!c.connecting) {
+    c.dead |= !drainFlow(c.upstream, c.toUpstream);
+  }
+  c.dead |= !drainFlow(c.client, c.toClient);
+}
+
+static void runRelay(std::vector<RelayListener> listeners, int wakeFd,
+                     Upstream upstream) {
+  std::list<RelayConnection> connections;
+  std::vector<pollfd> fds;
+  for (;;) {
+    fds.clear();
+    fds.push_back({wakeFd, POLLIN, 0});
+    for (const auto &listener : listeners) {
+      fds.push_back({listener.fd, POLLIN, 0});
+    }
+    for (const auto &c : connections) {
+      short clientEvents = 0;
+      short upstreamEvents = 0;
+      if (c.toUpstream.length == 0 && !c.toUpstream.eof) {
+        clientEvents |= POLLIN;
+      }
+      if (c.toClient.length > 0) {
+        clientEvents |= POLLOUT;
+      }
+      if (c.connecting || c.toUpstream.length > 0) {
+        upstreamEvents |= POLLOUT;
+      }
+      if (!c.connecting && c.toClient.length == 0 && !c.toClient.eof) {
+        upstreamEvents |= POLLIN;
+      }
+      fds.push_back({c.client, clientEvents, 0});
+      fds.push_back({c.upstream, upstreamEvents, 0});
+    }
+
+    if (poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "[ListenRelay] poll failed: " << std::strerror(errno)
+                << std::endl;
+      break;
+    }
+    if (fds[0].revents) {
+      break;
+    }
+
+    // 先处理已有连接（fds 的顺序与 connections 一致），再接受新连接
+    size_t index = 1 + listeners.size();
+    for (auto it = connections.begin(); it != connections.end();) {
+      serviceConnection(*it, fds[index].revents, fds[index + 1].revents);
+      index += 2;
+      if (it->dead || (it->toUpstream.shut && it->toClient.shut)) {
+        close(it->client);
+        close(it->upstream);
+        it->counters->activeConnections--;
+        it = connections.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    for (size_t i = 0; i < listeners.size(); i++) {
+      if (fds[1 + i].revents & POLLIN) {
+        acceptConnections(listeners[i], upstream, connections);
+      }
+    }
+  }
+
+  for (auto &c : connections) {
+    close(c.client);
+    close(c.upstream);
+    c.counters->activeConnections--;
+  }
+  for (const auto &listener : listeners) {
+    close(listener.fd);
+  }
+  close(wakeFd);
+}
+
+ListenRelay &ListenRelay::shared() {
+  // 不析构：避免进程退出时 join 转发线程
+  static ListenRelay *relay = new ListenRelay();
+  return *relay;
+}
+
+bool ListenRelay::start(const std::vector<std::string> &addresses,
+                        const std::string &upstreamHost, int upstreamPort) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  stopLocked();
+  _counters.clear();
+  if (addresses.empty()) {
+    return true;
+  }
+
+  auto upstream = resolveUpstream(upstreamHost, upstreamPort);
+  if (!upstream) {
+    std::cerr << "[ListenRelay] Cannot resolve primary address "
+              << upstreamHost << ":" << upstreamPort << std::endl;
+    return false;
+  }
+
+  std::vector<RelayListener> listeners;
+  std::vector<std::string> unixPaths;
+  auto fail = [&listeners, &unixPaths]() {
+    for (const auto &listener : listeners) {
+      close(listener.fd);
+    }
+    for (const auto &path : unixPaths) {
+      unlink(path.c_str());
+    }
+    return false;
+  };
+  for (const auto &text : addresses) {
+    auto address = ListenAddress::parse(text);
+    if (!address) {
+      std::cerr << "[ListenRelay] Invalid listen address: " << text
+                << std::endl;
+      return fail();
+    }
+    int fd = bindListener(*address);
+    if (fd < 0) {
+      std::cerr << "[ListenRelay] Cannot listen on " << text << ": "
+                << std::strerror(errno) << std::endl;
+      return fail();
+    }
+    if (address->family == ListenAddress::Family::Unix) {
+      unixPaths.push_back(address->host);
+    }
+    RelayListener listener;
+    listener.fd = fd;
+    listener.counters = std::make_shared<ListenerCounters>();
+    listener.counters->address = text;
+    listeners.push_back(std::move(listener));
+  }
+
+  int wake[2];
+  if (pipe(wake) != 0) {
+    return fail();
+  }
+  fcntl(wake[0], F_SETFD, FD_CLOEXEC);
+  fcntl(wake[1], F_SETFD, FD_CLOEXEC);
+  for (const auto &listener : listeners) {
+    _counters.push_back(listener.counters);
+  }
+  _unixPaths = std::move(unixPaths);
+  _wakeFd = wake[1];
+  _thread = std::thread(runRelay, std::move(listeners), wake[0], *upstream);
+  return true;
+}
+
+void ListenRelay::stop() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  stopLocked();
+}
+
+void ListenRelay::stopLocked() {
+  if (!_thread.joinable()) {
+    return;
+  }
+  char byte = 0;
+  (void)write(_wakeFd, &byte, 1);
+  _thread.join();
+  close(_wakeFd);
+  _wakeFd = -1;
+  for (const auto &path : _unixPaths) {
+    unlink(path.c_str());
+  }
+  _unixPaths.clear();
+}
+
+std::vector<std::shared_ptr<const ListenerCounters>>
+ListenRelay::counters() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _counters;
+}
+
+} // namespace margelo::nitro::http_server
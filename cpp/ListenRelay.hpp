@@ -0,0 +1,65 @@
+// cpp/ListenRelay.hpp
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// ServerConfig.listen 中的一个地址
+// "127.0.0.1:8080"、"[::1]:8080"、"0.0.0.0:8080"、"unix:/path/to/socket"
+struct ListenAddress {
+  enum class Family { IPv4, IPv6, Unix };
+  Family family = Family::IPv4;
+  std::string host; // IPv4 / IPv6 地址（不含方括号），Unix 时为 socket 路径
+  int port = 0;
+  std::string text; // 原始写法，用于日志和统计
+
+  // 格式不对时返回 std::nullopt
+  static std::optional<ListenAddress> parse(const std::string &text);
+};
+
+// 一个监听地址的运行统计
+struct ListenerCounters {
+  std::string address;
+  std::atomic<uint64_t> acceptedConnections{0};
+  std::atomic<int64_t> activeConnections{0};
+  std::atomic<uint64_t> failedConnections{0}; // 连不上主监听地址
+  std::atomic<uint64_t> bytesReceived{0};     // 客户端 → 服务器
+  std::atomic<uint64_t> bytesSent{0};         // 服务器 → 客户端
+};
+
+// 额外监听地址：Rust 核心只绑定一个地址，其余地址由桥接层监听，
+// 把连接原样转发到主监听地址，共用同一个 Rust runtime 和挂载表
+// 所有监听 socket 和转发连接由一个 poll 线程处理，不为每个连接开线程
+class ListenRelay {
+public:
+  static ListenRelay &shared();
+
+  // 绑定 addresses 并开始转发到 upstreamHost:upstreamPort（主监听地址，
+  // 0.0.0.0 / :: 转为回环地址）；任一地址绑定失败时不启动并返回 false
+  bool start(const std::vector<std::string> &addresses,
+             const std::string &upstreamHost, int upstreamPort);
+  // 关闭所有监听 socket 和转发中的连接
+  void stop();
+
+  std::vector<std::shared_ptr<const ListenerCounters>> counters() const;
+
+private:
+  ListenRelay() = default;
+
+  void stopLocked();
+
+  mutable std::mutex _mutex;
+  std::thread _thread;
+  int _wakeFd = -1; // 写入后 poll 线程退出
+  std::vector<std::string> _unixPaths;
+  std::vector<std::shared_ptr<const ListenerCounters>> _counters;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,119 @@
+// cpp/MemoryStore.cpp
+#include "MemoryStore.hpp"
+#include "CaptureFormat.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <utility>
+
+namespace margelo::nitro::http_server {
+
+// 小于该大小的内容不值得压缩
+static constexpr size_t kMinCompressBytes = 1024;
+
+// 内容及其压缩版本，StaticAsset 中的指针指向这里
+struct MemoryFileData {
+  std::string data;
+  std::string gzip;
+};
+
+static uint64_t assetBytes(const StaticAsset &asset) {
+  return asset.size + asset.gzipSize;
+}
+
+MemoryStore &MemoryStore::shared() {
+  static MemoryStore store;
+  return store;
+}
+
+bool MemoryStore::put(
+    const std::string &path, std::string data,
+    const std::unordered_map<std::string, std::string> &headers) {
+  auto contents = std::make_shared<MemoryFileData>();
+  contents->data = std::move(data);
+
+  auto asset = std::make_shared<StaticAsset>();
+  std::string contentType;
+  for (const auto &[name, value] : headers) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (lower == "content-type") {
+      contentType = value;
+    } else if (lower != "content-length" && lower != "etag") {
+      asset->headers.emplace_back(name, value);
+    }
+  }
+  if (contentType.empty()) {
+    contentType = guessContentType(path);
+  }
+  asset->headers.emplace(asset->headers.begin(), "Content-Type", contentType);
+
+  // 写入时一次性计算 ETag 和压缩版本，之后每次请求都不再处理内容
+  const std::string &raw = contents->data;
+  char etag[24];
+  snprintf(etag, sizeof(etag), "\"%016llx\"",
+           static_cast<unsigned long long>(
+               capture::hashBody(raw.data(), raw.size())));
+  asset->etag = etag;
+  if (raw.size() >= kMinCompressBytes && isCompressibleType(contentType)) {
+    auto gzip = gzipCompress(raw.data(), raw.size());
+    // 压缩收益不足 10% 时不保留
+    if (gzip && gzip->size() < raw.size() / 10 * 9) {
+      contents->gzip = std::move(*gzip);
+    }
+  }
+  asset->data = contents->data.data();
+  asset->size = contents->data.size();
+  if (!contents->gzip.empty()) {
+    asset->gzipData = contents->gzip.data();
+    asset->gzipSize = contents->gzip.size();
+  }
+  asset->owner = contents;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  uint64_t replaced = 0;
+  auto it = _files.find(path);
+  if (it != _files.end()) {
+    replaced = assetBytes(*it->second);
+  }
+  uint64_t bytes = assetBytes(*asset);
+  if (_totalBytes - replaced + bytes > _maxBytes) {
+    return false;
+  }
+  _totalBytes = _totalBytes - replaced + bytes;
+  _files[path] = std::move(asset);
+  return true;
+}
+
+bool MemoryStore::remove(const std::string &path) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _files.find(path);
+  if (it == _files.end()) {
+    return false;
+  }
+  _totalBytes -= assetBytes(*it->second);
+  _files.erase(it);
+  return true;
+}
+
+std::shared_ptr<const StaticAsset>
+MemoryStore::find(const std::string &path) const {
+  size_t query = path.find('?');
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _files.find(query == std::string::npos ? path
+                                                   : path.substr(0, query));
+  return it == _files.end() ? nullptr : it->second;
+}
+
+void MemoryStore::setCapacity(uint64_t maxBytes) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _maxBytes = maxBytes;
+}
+
+uint64_t MemoryStore::totalBytes() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _totalBytes;
+}
+
+} // namespace margelo::nitro::http_server
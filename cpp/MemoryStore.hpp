@@ -0,0 +1,38 @@
+// cpp/MemoryStore.hpp
+#pragma once
+#include "StaticAsset.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::http_server {
+
+// memory 挂载点的内容：JS 通过 memPut 写入的文件，保存在原生内存中
+// 与服务器生命周期无关，可以在启动服务器之前写入
+class MemoryStore {
+public:
+  static MemoryStore &shared();
+
+  // 写入（覆盖）一个文件；总大小超过容量时返回 false
+  // headers 中未给出 Content-Type 时按扩展名推断
+  bool put(const std::string &path, std::string data,
+           const std::unordered_map<std::string, std::string> &headers);
+  bool remove(const std::string &path);
+  // path 可带查询字符串；不存在时返回 nullptr
+  std::shared_ptr<const StaticAsset> find(const std::string &path) const;
+
+  void setCapacity(uint64_t maxBytes);
+  uint64_t totalBytes() const;
+
+private:
+  MemoryStore() = default;
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<const StaticAsset>> _files;
+  uint64_t _totalBytes = 0; // 原始内容与压缩版本之和
+  uint64_t _maxBytes = 64ull * 1024 * 1024;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,133 @@
+// cpp/RequestReaper.cpp
+#include "RequestReaper.hpp"
+#include <algorithm>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace margelo::nitro::http_server {
+
+// 路由超过 kMaxLeakRoutes 条后，其余泄漏计入这一条
+static const char *const kOtherRoutes = "*";
+
+RequestReaper &RequestReaper::shared() {
+  // 不析构：回收线程在进程生命周期内一直存在
+  static RequestReaper *reaper = new RequestReaper();
+  return *reaper;
+}
+
+void RequestReaper::setTimeout(std::chrono::milliseconds timeout) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _timeout = std::max(timeout, std::chrono::milliseconds(0));
+  _changed = true;
+  _cv.notify_one();
+}
+
+std::chrono::milliseconds RequestReaper::timeout() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _timeout;
+}
+
+void RequestReaper::setExpireHandler(ExpireHandler handler) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _handler = std::move(handler);
+}
+
+void RequestReaper::notifyRequestAdded() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_started) {
+    startLocked();
+    return;
+  }
+  // 正在按截止时间等待时不必唤醒：新请求的截止时间一定更晚；
+  // 正在扫描或无限期等待时要求重新扫描，避免漏掉新请求
+  if (!_timedWait && _timeout.count() > 0) {
+    _changed = true;
+    _cv.notify_one();
+  }
+}
+
+void RequestReaper::startLocked() {
+  _started = true;
+  std::thread([this] { run(); }).detach();
+}
+
+void RequestReaper::recordLeak(const PendingRequest &request) {
+  std::string route = request.method + " " +
+                      request.path.substr(0, request.path.find('?'));
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = std::find_if(_leaks.begin(), _leaks.end(),
+                         [&](const LeakRecord &r) { return r.route == route; });
+  if (it == _leaks.end() && _leaks.size() >= kMaxLeakRoutes) {
+    it = std::find_if(_leaks.begin(), _leaks.end(), [](const LeakRecord &r) {
+      return r.route == kOtherRoutes;
+    });
+    route = kOtherRoutes;
+  }
+  if (it == _leaks.end()) {
+    _leaks.push_back({std::move(route), request.stage.load(), 0});
+    it = _leaks.end() - 1;
+  }
+  it->stage = request.stage.load();
+  it->count++;
+}
+
+std::vector<LeakRecord> RequestReaper::leaks() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _leaks;
+}
+
+// 扫描活跃请求表：把超时的请求交给 handler，返回下一个截止时间
+static std::optional<Clock::time_point>
+sweep(std::chrono::milliseconds timeout,
+      const RequestReaper::ExpireHandler &handler) {
+  auto now = Clock::now();
+  std::vector<std::string> expired;
+  std::optional<Clock::time_point> next;
+  RequestRegistry::shared().forEachRequest([&](PendingRequest &request) {
+    auto deadline = request.lastActiveAt() + timeout;
+    if (deadline <= now) {
+      expired.push_back(request.requestId);
+    } else if (!next || deadline < *next) {
+      next = deadline;
+    }
+  });
+  // handler 会调用注册表，必须在遍历结束后执行
+  for (const auto &requestId : expired) {
+    if (auto request = RequestRegistry::shared().findRequest(requestId)) {
+      if (handler) {
+        handler(request);
+      }
+    }
+  }
+  return next;
+}
+
+void RequestReaper::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  for (;;) {
+    auto timeout = _timeout;
+    auto handler = _handler;
+    _changed = false;
+    std::optional<Clock::time_point> next;
+    if (timeout.count() > 0) {
+      lock.unlock();
+      next = sweep(timeout, handler);
+      lock.lock();
+    }
+    if (_changed) {
+      continue;
+    }
+    if (next) {
+      // 截止时间对齐到整秒，与其他空闲线程合并唤醒
+      _timedWait = true;
+      _cv.wait_until(lock, std::chrono::ceil<std::chrono::seconds>(*next),
+                     [this] { return _changed; });
+      _timedWait = false;
+    } else {
+      _cv.wait(lock, [this] { return _changed; });
+    }
+  }
+}
+
+} // namespace margelo::nitro::http_server
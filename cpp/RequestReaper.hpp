@@ -0,0 +1,71 @@
+// cpp/RequestReaper.hpp
+#pragma once
+#include "RequestRegistry.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// 超时未响应的请求（泄漏）按路由的统计
+struct LeakRecord {
+  std::string route; // "GET /api/items"（不含查询字符串）
+  RequestStage stage = RequestStage::Dispatched; // 最近一次回收时所处的阶段
+  uint64_t count = 0;
+};
+
+// 回收超时未响应的请求：JS 处理器一直没有 resolve、流式响应一直没有调用
+// endResponse 时，请求状态、客户端连接和已缓冲的响应体都会一直存在。
+// 回收线程按请求的最近活动时间（登记时间，或最近一次分块读写）判断是否
+// 超时，超时的请求交给 ExpireHandler 处理
+//
+// 没有待处理请求时线程无限期等待；否则睡到最早的截止时间（对齐到整秒）
+class RequestReaper {
+public:
+  using ExpireHandler =
+      std::function<void(const std::shared_ptr<PendingRequest> &)>;
+
+  static RequestReaper &shared();
+
+  // 最长存活时间，0 表示不回收
+  void setTimeout(std::chrono::milliseconds timeout);
+  std::chrono::milliseconds timeout() const;
+  void setExpireHandler(ExpireHandler handler);
+
+  // 有新请求登记时调用：回收线程空闲时唤醒它
+  void notifyRequestAdded();
+
+  // 记录一次泄漏（按 method + 路径聚合，最多记录 kMaxLeakRoutes 条路由）
+  void recordLeak(const PendingRequest &request);
+  std::vector<LeakRecord> leaks() const;
+
+  // 已回收的请求数
+  std::atomic<uint64_t> reaped{0};
+
+  static constexpr std::chrono::milliseconds kDefaultTimeout{300000};
+  static constexpr size_t kMaxLeakRoutes = 64;
+
+private:
+  RequestReaper() = default;
+
+  void run();
+  void startLocked();
+
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::chrono::milliseconds _timeout = kDefaultTimeout;
+  ExpireHandler _handler;
+  bool _started = false;
+  bool _timedWait = false; // 线程正在按截止时间等待
+  bool _changed = false;   // 需要立即重新扫描
+
+  std::vector<LeakRecord> _leaks;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,101 @@
+// cpp/RequestRegistry.cpp
+#include "RequestRegistry.hpp"
+
+namespace margelo::nitro::http_server {
+
+RequestRegistry &RequestRegistry::shared() {
+  static RequestRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<PendingRequest>
+RequestRegistry::addRequest(const std::string &requestId,
+                            const std::string &method,
+                            const std::string &path) {
+  auto entry = std::make_shared<PendingRequest>();
+  entry->requestId = requestId;
+  entry->method = method;
+  entry->path = path;
+  entry->createdAt = Clock::now();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _requests.find(requestId);
+  if (it != _requests.end()) {
+    // 同一 ID 重复投递：替换旧节点
+    _requestList.unlink(it->second.get());
+    _requests.erase(it);
+  }
+  _requestList.pushBack(entry.get());
+  _requests.emplace(requestId, entry);
+  return entry;
+}
+
+std::shared_ptr<PendingRequest>
+RequestRegistry::findRequest(const std::string &requestId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _requests.find(requestId);
+  return it != _requests.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<PendingRequest>
+RequestRegistry::removeRequest(const std::string &requestId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _requests.find(requestId);
+  if (it == _requests.end()) {
+    return nullptr;
+  }
+  auto entry = it->second;
+  _requestList.unlink(entry.get());
+  _requests.erase(it);
+  return entry;
+}
+
+std::shared_ptr<ActiveConnection>
+RequestRegistry::addConnection(const std::string &connectionId,
+                               const std::string &protocol,
+                               const std::string &peer,
+                               const std::string &path) {
+  auto entry = std::make_shared<ActiveConnection>();
+  entry->connectionId = connectionId;
+  entry->protocol = protocol;
+  entry->peer = peer;
+  entry->path = path;
+  entry->openedAt = Clock::now();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _connections.find(connectionId);
+  if (it != _connections.end()) {
+    _connectionList.unlink(it->second.get());
+    _connections.erase(it);
+  }
+  _connectionList.pushBack(entry.get());
+  _connections.emplace(connectionId, entry);
+  return entry;
+}
+
+std::shared_ptr<ActiveConnection>
+RequestRegistry::findConnection(const std::string &connectionId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _connections.find(connectionId);
+  return it != _connections.end() ? it->second : nullptr;
+}
+
+void RequestRegistry::removeConnection(const std::string &connectionId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _connections.find(connectionId);
+  if (it == _connections.end()) {
+    return;
+  }
+  _connectionList.unlink(it->second.get());
+  _connections.erase(it);
+}
+
+void RequestRegistry::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _requestList.clear();
+  _requests.clear();
+  _connectionList.clear();
+  _connections.clear();
+}
+
+} // namespace margelo::nitro::http_server
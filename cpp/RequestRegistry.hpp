@@ -0,0 +1,189 @@
+// cpp/RequestRegistry.hpp
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::http_server {
+
+class CircuitBreaker;
+class ContentDecoder;
+class CorsPolicy;
+class ResponseCache;
+
+using Clock = std::chrono::steady_clock;
+
+// 侵入式双向链表：节点自带 prev/next 指针，插入和摘除都是 O(1)
+// 链表按插入顺序排列，表头永远是最老的节点
+template <typename T> class IntrusiveList {
+public:
+  void pushBack(T *node) {
+    node->prev = _tail;
+    node->next = nullptr;
+    if (_tail) {
+      _tail->next = node;
+    } else {
+      _head = node;
+    }
+    _tail = node;
+    _size++;
+  }
+
+  void unlink(T *node) {
+    if (node->prev) {
+      node->prev->next = node->next;
+    } else {
+      _head = node->next;
+    }
+    if (node->next) {
+      node->next->prev = node->prev;
+    } else {
+      _tail = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+    _size--;
+  }
+
+  void clear() {
+    _head = nullptr;
+    _tail = nullptr;
+    _size = 0;
+  }
+
+  T *head() const { return _head; }
+  size_t size() const { return _size; }
+
+private:
+  T *_head = nullptr;
+  T *_tail = nullptr;
+  size_t _size = 0;
+};
+
+// 请求在桥接层中的阶段
+enum class RequestStage : uint8_t {
+  Dispatched, // 已投递到 JS，处理器尚未开始执行
+  Handling,   // JS 处理器已开始执行
+  Reading,    // JS 正在分块读取请求体
+  Writing,    // JS 正在分块写入响应体
+};
+
+// 桥接层中一个尚未响应的 HTTP 请求
+struct PendingRequest {
+  std::string requestId;
+  std::string method;
+  std::string path;
+  Clock::time_point createdAt;
+  std::atomic<RequestStage> stage{RequestStage::Dispatched};
+  std::atomic<bool> handlerStarted{false};
+  std::atomic<uint64_t> bytesReceived{0};
+  std::atomic<uint64_t> bytesSent{0};
+  std::atomic<uint32_t> responseCalls{0}; // 已调用的原生响应接口次数
+  uint64_t captureSeq = 0; // 流量抓取序号，0 表示未抓取；投递到 JS 前写入
+  // 最近一次分块读写的时间（Clock 的 tick 数），0 表示还没有；
+  // 回收超时从这里（或 createdAt）开始计算
+  std::atomic<Clock::rep> lastActivity{0};
+
+  // beginResponse() 提交的状态码和响应头，提交后不可更改
+  std::mutex headMutex;
+  bool headCommitted = false;
+  int committedStatus = 0;
+  std::string committedHeadersJson;
+  int64_t declaredContentLength = -1; // 响应头中的 Content-Length，-1 表示未声明
+  // 响应体达到声明长度后桥接层已提前调用 end_response
+  std::atomic<bool> responseEnded{false};
+
+  // 跨域请求的 Origin 及其 CORS 策略（非跨域或未配置时为空），投递到 JS 前写入
+  std::string origin;
+  std::shared_ptr<const CorsPolicy> cors;
+
+  // cache 挂载点下未命中的 GET 请求：响应发出后写入该缓存，投递到 JS 前写入
+  std::shared_ptr<ResponseCache> responseCache;
+  std::string cacheKey;
+
+  // 请求所属的熔断器，响应完成时记录成功或失败；投递到 JS 前写入
+  // breakerProbe 为半开探测请求的标记（CircuitBreaker::allow 给出）
+  std::shared_ptr<CircuitBreaker> breaker;
+  uint64_t breakerProbe = 0;
+
+  // 压缩的流式请求体：readRequestBodyChunk 经它解压后返回给 JS；
+  // 投递到 JS 前写入，分块读取串行进行
+  std::shared_ptr<ContentDecoder> bodyDecoder;
+
+  // 侵入式链表指针，仅在持有 RequestRegistry 锁时访问
+  PendingRequest *prev = nullptr;
+  PendingRequest *next = nullptr;
+
+  void touch() { lastActivity = Clock::now().time_since_epoch().count(); }
+  Clock::time_point lastActiveAt() const {
+    Clock::rep ticks = lastActivity.load();
+    return ticks != 0 ? Clock::time_point(Clock::duration(ticks)) : createdAt;
+  }
+};
+
+// 桥接层可见的长连接（目前为 WebSocket 连接）
+struct ActiveConnection {
+  std::string connectionId;
+  std::string protocol;
+  std::string peer;
+  std::string path;
+  Clock::time_point openedAt;
+  std::atomic<uint64_t> bytesReceived{0};
+  std::atomic<uint64_t> bytesSent{0};
+
+  ActiveConnection *prev = nullptr;
+  ActiveConnection *next = nullptr;
+};
+
+// 活跃请求/连接注册表
+// 按 ID 查找走哈希表，遍历走侵入式链表（最老的在前），增删都是 O(1)
+class RequestRegistry {
+public:
+  static RequestRegistry &shared();
+
+  std::shared_ptr<PendingRequest> addRequest(const std::string &requestId,
+                                             const std::string &method,
+                                             const std::string &path);
+  std::shared_ptr<PendingRequest> findRequest(const std::string &requestId);
+  // 摘除请求；返回 nullptr 表示该请求已经响应过（或从未登记）
+  std::shared_ptr<PendingRequest> removeRequest(const std::string &requestId);
+
+  std::shared_ptr<ActiveConnection>
+  addConnection(const std::string &connectionId, const std::string &protocol,
+                const std::string &peer, const std::string &path);
+  std::shared_ptr<ActiveConnection>
+  findConnection(const std::string &connectionId);
+  void removeConnection(const std::string &connectionId);
+
+  void clear();
+
+  // 在持锁状态下从最老到最新遍历，回调中不得再调用注册表
+  template <typename F> void forEachRequest(F &&visit) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (PendingRequest *node = _requestList.head(); node; node = node->next) {
+      visit(*node);
+    }
+  }
+
+  template <typename F> void forEachConnection(F &&visit) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (ActiveConnection *node = _connectionList.head(); node;
+         node = node->next) {
+      visit(*node);
+    }
+  }
+
+private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<PendingRequest>> _requests;
+  IntrusiveList<PendingRequest> _requestList;
+  std::unordered_map<std::string, std::shared_ptr<ActiveConnection>>
+      _connections;
+  IntrusiveList<ActiveConnection> _connectionList;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,468 @@
+// cpp/ResponseCache.cpp
+#include "ResponseCache.hpp"
+#include "BridgeConfig.hpp"
+#include "FileReader.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+static constexpr char kIndexMagic[8] = {'R', 'N', 'H', 'T',
+                                        'R', 'C', '\0', '\0'};
+static constexpr uint32_t kIndexVersion = 1;
+static constexpr size_t kMaxKeyBytes = 208;
+
+struct IndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t slotCount;
+  uint64_t nextBlobId;
+  uint8_t reserved[40];
+};
+static_assert(sizeof(IndexHeader) == 64, "IndexHeader must be 64 bytes");
+
+struct ResponseCache::Slot {
+  uint64_t blobId; // 0 表示空槽位
+  uint64_t blobBytes;
+  int64_t storedAtMs;
+  int64_t expiresAtMs;
+  int64_t lastAccessMs; // LRU 淘汰依据
+  uint32_t statusCode;
+  uint32_t keyLen;
+  char key[kMaxKeyBytes];
+};
+
+static int64_t unixNowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static bool makeDirs(const std::string &dir) {
+  for (size_t pos = 1; pos <= dir.size(); pos++) {
+    if (pos == dir.size() || dir[pos] == '/') {
+      std::string partial = dir.substr(0, pos);
+      if (mkdir(partial.c_str(), 0755) != 0 && errno != EEXIST) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static std::string toLower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return value;
+}
+
+static std::string trim(const std::string &value) {
+  size_t start = value.find_first_not_of(" \t");
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = value.find_last_not_of(" \t");
+  return value.substr(start, end - start + 1);
+}
+
+std::optional<int64_t> sharedCacheLifetime(const std::string &headersJson) {
+  auto headers = JsonValue::parse(headersJson);
+  if (!headers || !headers->isObject()) {
+    return std::nullopt;
+  }
+  std::string cacheControl;
+  for (const auto &[name, value] : headers->members()) {
+    std::string lower = toLower(name);
+    // 条目只按路径索引：随请求头变化（Vary）或已编码的响应不能共用
+    if (lower == "set-cookie" || lower == "vary" ||
+        lower == "content-encoding") {
+      return std::nullopt;
+    }
+    if (lower == "cache-control") {
+      cacheControl += ',' + toLower(value.asString(""));
+    }
+  }
+
+  std::optional<int64_t> maxAge;
+  std::optional<int64_t> sMaxAge;
+  size_t pos = 0;
+  while (pos < cacheControl.size()) {
+    size_t comma = cacheControl.find(',', pos);
+    if (comma == std::string::npos) {
+      comma = cacheControl.size();
+    }
+    std::string directive = trim(cacheControl.substr(pos, comma - pos));
+    pos = comma + 1;
+    if (directive == "no-store" || directive == "private" ||
+        directive == "no-cache") {
+      return std::nullopt;
+    }
+    if (directive.rfind("s-maxage=", 0) == 0) {
+      sMaxAge = std::strtoll(directive.c_str() + 9, nullptr, 10);
+    } else if (directive.rfind("max-age=", 0) == 0) {
+      maxAge = std::strtoll(directive.c_str() + 8, nullptr, 10);
+    }
+  }
+  return sMaxAge ? sMaxAge : maxAge;
+}
+
+static bool cacheableStatus(int statusCode) {
+  switch (statusCode) {
+  case 200:
+  case 203:
+  case 204:
+  case 300:
+  case 301:
+  case 404:
+  case 410:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::shared_ptr<ResponseCache> ResponseCache::fromJson(const JsonValue &mount) {
+  const JsonValue *dir = mount.get("dir");
+  if (!dir || !dir->isString() || dir->asString().empty()) {
+    std::cerr << "[ResponseCache] cache mount requires 'dir'" << std::endl;
+    return nullptr;
+  }
+  Settings settings;
+  settings.dir = dir->asString();
+  if (const JsonValue *value = mount.get("max_bytes")) {
+    settings.maxBytes = static_cast<uint64_t>(std::max(
+        value->asNumber(static_cast<double>(settings.maxBytes)), 0.0));
+  }
+  if (const JsonValue *value = mount.get("max_entries")) {
+    settings.maxEntries = static_cast<uint32_t>(std::clamp(
+        value->asNumber(settings.maxEntries), 1.0, 1048576.0));
+  }
+  if (const JsonValue *value = mount.get("max_entry_bytes")) {
+    settings.maxEntryBytes = static_cast<uint64_t>(std::max(
+        value->asNumber(static_cast<double>(settings.maxEntryBytes)), 0.0));
+  }
+  const JsonValue *path = mount.get("path");
+  return open(path ? path->asString("/") : "/", settings);
+}
+
+std::shared_ptr<ResponseCache> ResponseCache::open(const std::string &mountPath,
+                                                   const Settings &settings) {
+  std::shared_ptr<ResponseCache> cache(new ResponseCache());
+  cache->_mountPath = mountPath;
+  cache->_settings = settings;
+  if (!makeDirs(cache->_settings.dir) || !cache->mapIndex()) {
+    std::cerr << "[ResponseCache] Failed to open cache in "
+              << cache->_settings.dir << std::endl;
+    return nullptr;
+  }
+  cache->loadSlots();
+  return cache;
+}
+
+ResponseCache::~ResponseCache() {
+  if (_map) {
+    munmap(_map, _mapSize);
+  }
+  if (_indexFd >= 0) {
+    close(_indexFd);
+  }
+}
+
+bool ResponseCache::mapIndex() {
+  std::string indexPath = _settings.dir + "/index.bin";
+  _indexFd = ::open(indexPath.c_str(), O_RDWR | O_CREAT, 0644);
+  if (_indexFd < 0) {
+    return false;
+  }
+  static_assert(sizeof(Slot) == 256, "Slot must be 256 bytes");
+  _mapSize = sizeof(IndexHeader) +
+             static_cast<size_t>(_settings.maxEntries) * sizeof(Slot);
+
+  IndexHeader header{};
+  struct stat st {};
+  bool valid = fstat(_indexFd, &st) == 0 &&
+               static_cast<size_t>(st.st_size) == _mapSize &&
+               pread(_indexFd, &header, sizeof(header), 0) ==
+                   static_cast<ssize_t>(sizeof(header)) &&
+               std::memcmp(header.magic, kIndexMagic, 8) == 0 &&
+               header.version == kIndexVersion &&
+               header.slotCount == _settings.maxEntries;
+  if (!valid) {
+    // 格式或容量变化：重建空索引，孤立的 blob 在 loadSlots 中清理
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kIndexMagic, 8);
+    header.version = kIndexVersion;
+    header.slotCount = _settings.maxEntries;
+    header.nextBlobId = 1;
+    if (ftruncate(_indexFd, 0) != 0 ||
+        ftruncate(_indexFd, static_cast<off_t>(_mapSize)) != 0 ||
+        pwrite(_indexFd, &header, sizeof(header), 0) !=
+            static_cast<ssize_t>(sizeof(header))) {
+      return false;
+    }
+  }
+
+  void *map = mmap(nullptr, _mapSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   _indexFd, 0);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  _map = static_cast<uint8_t *>(map);
+  return true;
+}
+
+ResponseCache::Slot &ResponseCache::slotAt(uint32_t index) const {
+  return reinterpret_cast<Slot *>(_map + sizeof(IndexHeader))[index];
+}
+
+std::string ResponseCache::blobPath(uint64_t blobId) const {
+  char name[32];
+  snprintf(name, sizeof(name), "/%016llx.blob",
+           static_cast<unsigned long long>(blobId));
+  return _settings.dir + name;
+}
+
+void ResponseCache::loadSlots() {
+  std::unordered_set<std::string> referenced;
+  std::vector<uint32_t> used;
+  for (uint32_t i = 0; i < _settings.maxEntries; i++) {
+    Slot &slot = slotAt(i);
+    if (slot.blobId == 0) {
+      continue;
+    }
+    std::string path = blobPath(slot.blobId);
+    struct stat st {};
+    bool valid = slot.keyLen <= kMaxKeyBytes &&
+                 stat(path.c_str(), &st) == 0 &&
+                 static_cast<uint64_t>(st.st_size) == slot.blobBytes;
+    std::string key(slot.key, valid ? slot.keyLen : 0);
+    if (!valid || _slotsByKey.count(key)) {
+      std::memset(&slot, 0, sizeof(Slot));
+      continue;
+    }
+    _slotsByKey.emplace(std::move(key), i);
+    _totalBytes += slot.blobBytes;
+    referenced.insert(path.substr(_settings.dir.size() + 1));
+    used.push_back(i);
+  }
+
+  // 按上次访问时间重建 LRU 链表；空闲槽位倒序入栈，先用低编号的槽位
+  std::sort(used.begin(), used.end(), [this](uint32_t a, uint32_t b) {
+    return slotAt(a).lastAccessMs > slotAt(b).lastAccessMs;
+  });
+  _lruPos.resize(_settings.maxEntries);
+  for (uint32_t index : used) {
+    _lruPos[index] = _lru.insert(_lru.end(), index);
+  }
+  for (uint32_t i = _settings.maxEntries; i-- > 0;) {
+    if (slotAt(i).blobId == 0) {
+      _freeSlots.push_back(i);
+    }
+  }
+
+  // 清理没有槽位引用的 blob 和写入中断留下的临时文件
+  if (DIR *dir = opendir(_settings.dir.c_str())) {
+    while (struct dirent *entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      bool blobLike = name.size() > 5 &&
+                      (name.compare(name.size() - 5, 5, ".blob") == 0 ||
+                       name.compare(name.size() - 4, 4, ".tmp") == 0);
+      if (blobLike && !referenced.count(name)) {
+        unlink((_settings.dir + "/" + name).c_str());
+      }
+    }
+    closedir(dir);
+  }
+}
+
+bool ResponseCache::cacheableRequest(
+    const std::string &method,
+    const std::unordered_map<std::string, std::string> &headers) {
+  return (method == "GET" || method == "HEAD") &&
+         headers.find("authorization") == headers.end() &&
+         headers.find("cookie") == headers.end();
+}
+
+// 调用方持有 _mutex
+void ResponseCache::releaseSlot(uint32_t index) {
+  Slot &slot = slotAt(index);
+  if (slot.blobId == 0) {
+    return;
+  }
+  unlink(blobPath(slot.blobId).c_str());
+  _slotsByKey.erase(std::string(slot.key, slot.keyLen));
+  _totalBytes -= slot.blobBytes;
+  std::memset(&slot, 0, sizeof(Slot));
+  _lru.erase(_lruPos[index]);
+  _freeSlots.push_back(index);
+}
+
+// 调用方持有 _mutex
+void ResponseCache::touchSlot(uint32_t index) {
+  _lru.splice(_lru.begin(), _lru, _lruPos[index]);
+}
+
+// 调用方持有 _mutex
+int64_t ResponseCache::reserveSlot(uint64_t bytes) {
+  while (_freeSlots.empty() || _totalBytes + bytes > _settings.maxBytes) {
+    if (_lru.empty()) {
+      return -1;
+    }
+    releaseSlot(_lru.back());
+    evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+  uint32_t index = _freeSlots.back();
+  _freeSlots.pop_back();
+  return index;
+}
+
+std::optional<ResponseCache::Hit>
+ResponseCache::lookup(const std::string &key) {
+  uint64_t blobId = 0;
+  uint64_t blobBytes = 0;
+  Hit hit;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _slotsByKey.find(key);
+    if (it == _slotsByKey.end()) {
+      misses.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    Slot &slot = slotAt(it->second);
+    int64_t now = unixNowMs();
+    if (slot.expiresAtMs <= now) {
+      releaseSlot(it->second);
+      misses.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    slot.lastAccessMs = now;
+    touchSlot(it->second);
+    blobId = slot.blobId;
+    blobBytes = slot.blobBytes;
+    hit.statusCode = static_cast<int>(slot.statusCode);
+    hit.ageSeconds = std::max<int64_t>((now - slot.storedAtMs) / 1000, 0);
+  }
+
+  // 在锁外读取 blob；期间被淘汰（或已被替换）时按未命中处理
+  auto contents = FileReader::shared().readFile(blobPath(blobId), blobBytes);
+  bool ok = contents && contents->size() == blobBytes;
+  uint32_t headersLen = 0;
+  if (ok && contents->size() >= sizeof(headersLen)) {
+    std::memcpy(&headersLen, contents->data(), sizeof(headersLen));
+  }
+  if (!ok || contents->size() < sizeof(headersLen) + headersLen) {
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  hit.headersJson = contents->substr(sizeof(headersLen), headersLen);
+  hit.body = contents->substr(sizeof(headersLen) + headersLen);
+  hits.fetch_add(1, std::memory_order_relaxed);
+  return hit;
+}
+
+bool ResponseCache::accepts(const std::string &key, int statusCode,
+                            const std::string &headersJson,
+                            size_t bodyLen) const {
+  if (!cacheableStatus(statusCode) || key.size() > kMaxKeyBytes) {
+    return false;
+  }
+  auto lifetime = sharedCacheLifetime(headersJson);
+  if (!lifetime || *lifetime <= 0) {
+    return false;
+  }
+  uint64_t blobBytes = sizeof(uint32_t) + headersJson.size() + bodyLen;
+  return blobBytes <= _settings.maxEntryBytes &&
+         blobBytes <= _settings.maxBytes;
+}
+
+bool ResponseCache::store(const std::string &key, int statusCode,
+                          const std::string &headersJson, const char *body,
+                          size_t bodyLen) {
+  if (!accepts(key, statusCode, headersJson, bodyLen)) {
+    return false;
+  }
+  auto lifetime = sharedCacheLifetime(headersJson);
+  uint32_t headersLen = static_cast<uint32_t>(headersJson.size());
+  uint64_t blobBytes = sizeof(headersLen) + headersLen + bodyLen;
+
+  uint64_t blobId = 0;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    blobId = reinterpret_cast<IndexHeader *>(_map)->nextBlobId++;
+  }
+
+  // 在锁外写 blob：先写临时文件再 rename，避免留下半个文件
+  std::string finalPath = blobPath(blobId);
+  std::string tmpPath = finalPath.substr(0, finalPath.size() - 5) + ".tmp";
+  FILE *file = std::fopen(tmpPath.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  bool ok =
+      std::fwrite(&headersLen, sizeof(headersLen), 1, file) == 1 &&
+      std::fwrite(headersJson.data(), 1, headersLen, file) == headersLen &&
+      (bodyLen == 0 || std::fwrite(body, 1, bodyLen, file) == bodyLen);
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok || std::rename(tmpPath.c_str(), finalPath.c_str()) != 0) {
+    unlink(tmpPath.c_str());
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto existing = _slotsByKey.find(key);
+  if (existing != _slotsByKey.end()) {
+    releaseSlot(existing->second);
+  }
+  int64_t index = reserveSlot(blobBytes);
+  if (index < 0) {
+    unlink(finalPath.c_str());
+    return false;
+  }
+
+  int64_t now = unixNowMs();
+  Slot &slot = slotAt(static_cast<uint32_t>(index));
+  slot.blobBytes = blobBytes;
+  slot.storedAtMs = now;
+  slot.expiresAtMs = now + *lifetime * 1000;
+  slot.lastAccessMs = now;
+  slot.statusCode = static_cast<uint32_t>(statusCode);
+  slot.keyLen = static_cast<uint32_t>(key.size());
+  std::memcpy(slot.key, key.data(), key.size());
+  // blobId 最后写入，非零即表示槽位完整
+  slot.blobId = blobId;
+
+  _slotsByKey[key] = static_cast<uint32_t>(index);
+  _lruPos[index] = _lru.insert(_lru.begin(), static_cast<uint32_t>(index));
+  _totalBytes += blobBytes;
+  stores.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+size_t ResponseCache::purge(const std::string &keyPrefix) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // 按路径段匹配：/api/a 包含 /api/a、/api/a/x 和 /api/a?x，不包含 /api/ab
+  std::vector<uint32_t> matched;
+  for (const auto &[key, index] : _slotsByKey) {
+    if (matchesPathPrefix(key, keyPrefix)) {
+      matched.push_back(index);
+    }
+  }
+  for (uint32_t index : matched) {
+    releaseSlot(index);
+  }
+  return matched.size();
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,106 @@
+// cpp/ResponseCache.hpp
+#pragma once
+#include "JsonValue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// cache 挂载点：把 JS 生成的、带 Cache-Control 的响应持久化到磁盘，
+// 命中时由桥接层直接应答，应用重启后仍然有效
+//
+// 目录结构：
+//   index.bin     mmap 的定长槽位表（文件头 + maxEntries 个 256 字节槽位）
+//   <blobId>.blob 单个响应：u32 响应头长度 + 响应头 JSON + 响应体
+// 先写 blob（临时文件 + rename）再写槽位；打开时丢弃 blob 缺失或大小不符的槽位
+class ResponseCache {
+public:
+  struct Settings {
+    std::string dir;
+    uint64_t maxBytes = 64ull * 1024 * 1024; // 所有 blob 的总大小上限
+    uint32_t maxEntries = 4096;
+    uint64_t maxEntryBytes = 8ull * 1024 * 1024; // 单个响应的大小上限
+  };
+
+  struct Hit {
+    int statusCode = 200;
+    std::string headersJson;
+    std::string body;
+    int64_t ageSeconds = 0;
+  };
+
+  // 从 mount 配置创建；dir 缺失或无法打开时返回 nullptr
+  static std::shared_ptr<ResponseCache> fromJson(const JsonValue &mount);
+  static std::shared_ptr<ResponseCache> open(const std::string &mountPath,
+                                             const Settings &settings);
+  ~ResponseCache();
+
+  const std::string &mountPath() const { return _mountPath; }
+
+  // 仅缓存不带凭据（Authorization / Cookie）的 GET / HEAD 请求
+  static bool cacheableRequest(
+      const std::string &method,
+      const std::unordered_map<std::string, std::string> &headers);
+
+  // 未命中或已过期时返回 std::nullopt
+  std::optional<Hit> lookup(const std::string &key);
+
+  // 响应是否会被写入：状态码可缓存、Cache-Control（s-maxage / max-age）
+  // 给出正的有效期、且大小不超过限制
+  bool accepts(const std::string &key, int statusCode,
+               const std::string &headersJson, size_t bodyLen) const;
+
+  // 按 accepts 的规则决定是否写入
+  bool store(const std::string &key, int statusCode,
+             const std::string &headersJson, const char *body,
+             size_t bodyLen);
+
+  // 删除路径在 keyPrefix 之下的条目（按路径段匹配，空前缀删除全部），
+  // 返回删除数
+  size_t purge(const std::string &keyPrefix);
+
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+  std::atomic<uint64_t> stores{0};
+  std::atomic<uint64_t> evictions{0};
+
+private:
+  struct Slot;
+
+  ResponseCache() = default;
+  bool mapIndex();
+  void loadSlots();
+  Slot &slotAt(uint32_t index) const;
+  std::string blobPath(uint64_t blobId) const;
+  void releaseSlot(uint32_t index);
+  // 从空闲槽位中取一个，空间或槽位不足时从 LRU 尾部淘汰；失败返回 -1
+  int64_t reserveSlot(uint64_t bytes);
+  void touchSlot(uint32_t index);
+
+  std::string _mountPath;
+  Settings _settings;
+  int _indexFd = -1;
+  uint8_t *_map = nullptr;
+  size_t _mapSize = 0;
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, uint32_t> _slotsByKey;
+  // 使用中的槽位按访问时间排列（头部最近），淘汰时不扫描整个槽位表
+  std::list<uint32_t> _lru;
+  std::vector<std::list<uint32_t>::iterator> _lruPos; // 槽位 → _lru 中的位置
+  std::vector<uint32_t> _freeSlots;
+  uint64_t _totalBytes = 0;
+};
+
+// 响应头 JSON 中的 Cache-Control 允许共享缓存时，返回新鲜期（秒）
+// 带 Set-Cookie、Vary 或 Content-Encoding 的响应不缓存
+std::optional<int64_t> sharedCacheLifetime(const std::string &headersJson);
+
+} // namespace margelo::nitro::http_server
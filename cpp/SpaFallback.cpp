@@ -0,0 +1,187 @@
+// cpp/SpaFallback.cpp
+#include "SpaFallback.hpp"
+#include "BridgeConfig.hpp"
+#include "FileReader.hpp"
+#include "StaticAsset.hpp"
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+
+namespace margelo::nitro::http_server {
+
+// 入口 HTML 的大小上限，超过后不做回退（正常的入口文件只有几 KB）
+static constexpr int64_t kMaxIndexBytes = 8 * 1024 * 1024;
+
+static bool underAnyPrefix(const std::string &path,
+                           const std::vector<std::string> &prefixes) {
+  for (const auto &prefix : prefixes) {
+    if (matchesPathPrefix(path, prefix)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<const SpaFallback>
+SpaFallback::fromJson(const JsonValue &json,
+                      const std::string &defaultRootDir,
+                      std::shared_ptr<FileLookupCache> lookupCache) {
+  if (!json.isObject() && !(json.isBool() && json.asBool())) {
+    return nullptr;
+  }
+
+  auto spa = std::make_shared<SpaFallback>();
+  spa->_lookupCache = std::move(lookupCache);
+  std::string rootDir = defaultRootDir;
+  std::string index = "index.html";
+  bool acceptHtmlSet = false;
+  if (json.isObject()) {
+    if (const JsonValue *value = json.get("root")) {
+      rootDir = value->asString(rootDir);
+    }
+    if (const JsonValue *value = json.get("index")) {
+      index = value->asString(index);
+    }
+    if (const JsonValue *value = json.get("prefixes")) {
+      spa->_prefixes = value->stringList();
+    }
+    if (const JsonValue *value = json.get("exclude_prefixes")) {
+      spa->_excludePrefixes = value->stringList();
+    }
+    if (const JsonValue *value = json.get("accept_html")) {
+      spa->_acceptHtml = value->asBool();
+      acceptHtmlSet = true;
+    }
+    if (const JsonValue *value = json.get("cache_control")) {
+      spa->_cacheControl = value->asString(spa->_cacheControl);
+    }
+  }
+  // 显式列出前缀时默认不再要求 Accept: text/html
+  if (!acceptHtmlSet && !spa->_prefixes.empty()) {
+    spa->_acceptHtml = false;
+  }
+
+  if (!index.empty() && index.front() == '/') {
+    spa->_indexPath = index;
+  } else if (!rootDir.empty()) {
+    spa->_indexPath = rootDir;
+    if (spa->_indexPath.back() != '/') {
+      spa->_indexPath += '/';
+    }
+    spa->_indexPath += index;
+  } else {
+    std::cerr << "[SpaFallback] No root directory for index " << index
+              << ", fallback disabled" << std::endl;
+    return nullptr;
+  }
+  return spa;
+}
+
+bool SpaFallback::matches(
+    const std::string &method, const std::string &path,
+    const std::unordered_map<std::string, std::string> &headers) const {
+  if (method != "GET" && method != "HEAD") {
+    return false;
+  }
+  if (underAnyPrefix(path, _excludePrefixes)) {
+    return false;
+  }
+  if (!_prefixes.empty() && !underAnyPrefix(path, _prefixes)) {
+    return false;
+  }
+
+  // 最后一段带扩展名的路径是缺失的资源文件（如 /assets/app.js），不回退
+  size_t end = std::min(path.find('?'), path.size());
+  size_t lastSlash = path.rfind('/', end == 0 ? 0 : end - 1);
+  size_t segmentStart = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+  if (path.find('.', segmentStart) < end) {
+    return false;
+  }
+
+  if (_acceptHtml) {
+    auto it = headers.find("accept");
+    if (it == headers.end() ||
+        it->second.find("text/html") == std::string::npos) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SpaFallback::loadIndex(CachedIndex &out) const {
+  auto fileStat = _lookupCache->stat(_indexPath);
+  if (!fileStat || fileStat->isDirectory) {
+    return false;
+  }
+  int64_t mtimeNs = fileStat->mtimeNs;
+  int64_t size = fileStat->size;
+
+  std::lock_guard<std::mutex> lock(_cacheMutex);
+  if (_cached.body && _cached.mtimeNs == mtimeNs && _cached.size == size) {
+    out = _cached;
+    return true;
+  }
+  if (size > kMaxIndexBytes) {
+    std::cerr << "[SpaFallback] Index file too large: " << _indexPath
+              << std::endl;
+    return false;
+  }
+
+  auto contents =
+      FileReader::shared().readFile(_indexPath, kMaxIndexBytes);
+  if (!contents) {
+    return false;
+  }
+
+  CachedIndex loaded;
+  loaded.body = std::make_shared<const std::string>(std::move(*contents));
+  loaded.mtimeNs = mtimeNs;
+  loaded.size = size;
+  char etag[48];
+  snprintf(etag, sizeof(etag), "W/\"%llx-%llx\"",
+           static_cast<unsigned long long>(size),
+           static_cast<unsigned long long>(mtimeNs));
+  loaded.etag = etag;
+  loaded.lastModified =
+      formatHttpDate(static_cast<time_t>(mtimeNs / 1000000000));
+  _cached = loaded;
+  out = std::move(loaded);
+  return true;
+}
+
+bool SpaFallback::respond(
+    const std::unordered_map<std::string, std::string> &headers,
+    int &statusCode, std::string &headersJson,
+    std::shared_ptr<const std::string> &body) const {
+  CachedIndex index;
+  if (!loadIndex(index)) {
+    return false;
+  }
+
+  headersJson = "{";
+  auto append = [&headersJson](const char *name, const std::string &value) {
+    if (headersJson.size() > 1) {
+      headersJson += ',';
+    }
+    appendJsonString(headersJson, name);
+    headersJson += ':';
+    appendJsonString(headersJson, value);
+  };
+  append("Content-Type", "text/html; charset=utf-8");
+  append("Cache-Control", _cacheControl);
+  append("ETag", index.etag);
+  append("Last-Modified", index.lastModified);
+  headersJson += '}';
+
+  auto it = headers.find("if-none-match");
+  if (it != headers.end() && etagMatches(it->second, index.etag)) {
+    statusCode = 304;
+    body = nullptr;
+    return true;
+  }
+  statusCode = 200;
+  body = index.body;
+  return true;
+}
+
+} // namespace margelo::nitro::http_server
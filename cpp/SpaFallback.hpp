@@ -0,0 +1,56 @@
+// cpp/SpaFallback.hpp
+#pragma once
+#include "FileLookupCache.hpp"
+#include "JsonValue.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// 单页应用回退：静态文件未命中的前端路由（如 /settings/profile）
+// 直接由桥接层返回入口 HTML，不再进入 JS 回调
+class SpaFallback {
+public:
+  // json 为 true 或对象时生效；defaultRootDir 为静态文件根目录
+  static std::shared_ptr<const SpaFallback>
+  fromJson(const JsonValue &json, const std::string &defaultRootDir,
+           std::shared_ptr<FileLookupCache> lookupCache);
+
+  // 请求是否应回退到入口 HTML
+  bool matches(const std::string &method, const std::string &path,
+               const std::unordered_map<std::string, std::string> &headers)
+      const;
+
+  // 生成回退响应；入口文件无法读取时返回 false（请求继续交给 JS）
+  bool respond(const std::unordered_map<std::string, std::string> &headers,
+               int &statusCode, std::string &headersJson,
+               std::shared_ptr<const std::string> &body) const;
+
+private:
+  struct CachedIndex {
+    std::shared_ptr<const std::string> body;
+    int64_t mtimeNs = -1;
+    int64_t size = -1;
+    std::string etag;
+    std::string lastModified;
+  };
+
+  // 按 mtime / size 判断是否需要重新读取入口文件
+  bool loadIndex(CachedIndex &out) const;
+
+  std::string _indexPath;
+  std::shared_ptr<FileLookupCache> _lookupCache;
+  std::vector<std::string> _prefixes;        // 为空表示所有路径
+  std::vector<std::string> _excludePrefixes; // 始终交给 JS（如 /api）
+  bool _acceptHtml = true;                   // 要求 Accept 包含 text/html
+  std::string _cacheControl = "no-cache";
+
+  mutable std::mutex _cacheMutex;
+  mutable CachedIndex _cached;
+};
+
+} // namespace margelo::nitro::http_server
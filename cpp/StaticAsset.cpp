@@ -0,0 +1,303 @@
+// cpp/StaticAsset.cpp
+#include "StaticAsset.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <zlib.h>
+
+namespace margelo::nitro::http_server {
+
+RangeResult parseByteRange(const std::string &header, size_t size,
+                           size_t &start, size_t &length) {
+  if (header.rfind("bytes=", 0) != 0 ||
+      header.find(',') != std::string::npos) {
+    return RangeResult::None;
+  }
+  std::string spec = header.substr(6);
+  size_t dash = spec.find('-');
+  if (dash == std::string::npos) {
+    return RangeResult::None;
+  }
+  std::string first = spec.substr(0, dash);
+  std::string last = spec.substr(dash + 1);
+  auto isDigits = [](const std::string &s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) {
+      return std::isdigit(c);
+    });
+  };
+
+  if (first.empty()) {
+    // 后缀形式：最后 N 个字节
+    if (!isDigits(last)) {
+      return RangeResult::None;
+    }
+    unsigned long long suffix = std::strtoull(last.c_str(), nullptr, 10);
+    if (suffix == 0 || size == 0) {
+      return RangeResult::Unsatisfiable;
+    }
+    length = static_cast<size_t>(std::min<unsigned long long>(suffix, size));
+    start = size - length;
+    return RangeResult::Satisfiable;
+  }
+
+  if (!isDigits(first) || (!last.empty() && !isDigits(last))) {
+    return RangeResult::None;
+  }
+  unsigned long long from = std::strtoull(first.c_str(), nullptr, 10);
+  unsigned long long to =
+      last.empty() ? size - 1 : std::strtoull(last.c_str(), nullptr, 10);
+  if (from >= size || to < from) {
+    return RangeResult::Unsatisfiable;
+  }
+  to = std::min<unsigned long long>(to, size - 1);
+  start = static_cast<size_t>(from);
+  length = static_cast<size_t>(to - from + 1);
+  return RangeResult::Satisfiable;
+}
+
+bool etagMatches(const std::string &ifNoneMatch, const std::string &etag) {
+  // 弱比较：两边都忽略 W/ 前缀
+  std::string_view bare = etag;
+  if (bare.rfind("W/", 0) == 0) {
+    bare.remove_prefix(2);
+  }
+  // If-None-Match 是逗号分隔的 entity-tag 列表，或单独的 *
+  std::string_view list = ifNoneMatch;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    if (list[pos] == ' ' || list[pos] == '\t' || list[pos] == ',') {
+      pos++;
+      continue;
+    }
+    if (list[pos] == '*') {
+      return true;
+    }
+    if (list.compare(pos, 2, "W/") == 0) {
+      pos += 2;
+    }
+    size_t end;
+    if (pos < list.size() && list[pos] == '"') {
+      // 带引号的 opaque-tag 内可以有逗号
+      end = list.find('"', pos + 1);
+      end = end == std::string_view::npos ? list.size() : end + 1;
+    } else {
+      end = std::min(list.find(',', pos), list.size());
+    }
+    std::string_view tag = list.substr(pos, end - pos);
+    while (!tag.empty() && (tag.back() == ' ' || tag.back() == '\t')) {
+      tag.remove_suffix(1);
+    }
+    if (tag == bare) {
+      return true;
+    }
+    pos = end;
+  }
+  return false;
+}
+
+// gzip 版本是另一种表示，强 ETag 需要区分："abc" -> "abc-gz"
+static std::string gzipEtag(const std::string &etag) {
+  if (etag.size() >= 2 && etag.back() == '"') {
+    return etag.substr(0, etag.size() - 1) + "-gz\"";
+  }
+  return etag + "-gz";
+}
+
+StaticReply buildStaticReply(
+    const StaticAsset &asset, const std::string &method,
+    const std::unordered_map<std::string, std::string> &requestHeaders) {
+  auto header = [&requestHeaders](const char *name) -> const std::string * {
+    auto it = requestHeaders.find(name);
+    return it == requestHeaders.end() ? nullptr : &it->second;
+  };
+
+  const std::string *range = header("range");
+  // If-Range 与当前 ETag 不一致时按完整响应处理
+  if (const std::string *ifRange = header("if-range");
+      range && ifRange && *ifRange != asset.etag) {
+    range = nullptr;
+  }
+  // 只对完整响应使用压缩版本（Range 的偏移基于原始内容）
+  const std::string *acceptEncoding = header("accept-encoding");
+  bool gzip = asset.gzipData && !range && acceptEncoding &&
+              acceptEncoding->find("gzip") != std::string::npos;
+
+  StaticReply reply;
+  HeaderList headers = asset.headers;
+  std::string etag = gzip ? gzipEtag(asset.etag) : asset.etag;
+  headers.emplace_back("ETag", etag);
+  headers.emplace_back("Accept-Ranges", "bytes");
+  if (asset.gzipData) {
+    headers.emplace_back("Vary", "Accept-Encoding");
+  }
+
+  if (const std::string *ifNoneMatch = header("if-none-match");
+      ifNoneMatch && etagMatches(*ifNoneMatch, etag)) {
+    reply.statusCode = 304;
+    reply.headersJson = "{}";
+    appendHeadersToJson(reply.headersJson, headers);
+    return reply;
+  }
+
+  const char *body = asset.data;
+  size_t bodyLen = asset.size;
+  if (gzip) {
+    headers.emplace_back("Content-Encoding", "gzip");
+    body = asset.gzipData;
+    bodyLen = asset.gzipSize;
+  } else if (range) {
+    size_t start = 0;
+    size_t length = 0;
+    switch (parseByteRange(*range, asset.size, start, length)) {
+    case RangeResult::Satisfiable:
+      reply.statusCode = 206;
+      body = asset.data + start;
+      bodyLen = length;
+      headers.emplace_back("Content-Range",
+                           "bytes " + std::to_string(start) + "-" +
+                               std::to_string(start + length - 1) + "/" +
+                               std::to_string(asset.size));
+      break;
+    case RangeResult::Unsatisfiable:
+      reply.statusCode = 416;
+      headers.emplace_back("Content-Range",
+                           "bytes */" + std::to_string(asset.size));
+      body = "";
+      bodyLen = 0;
+      break;
+    case RangeResult::None:
+      break;
+    }
+  }
+
+  reply.headersJson = "{}";
+  appendHeadersToJson(reply.headersJson, headers);
+  if (method != "HEAD") {
+    reply.body = body;
+    reply.bodyLen = bodyLen;
+  } else {
+    appendContentLength(reply.headersJson, bodyLen);
+  }
+  return reply;
+}
+
+std::string guessContentType(const std::string &path) {
+  static const std::unordered_map<std::string, std::string> kTypes = {
+      {"html", "text/html; charset=utf-8"},
+      {"htm", "text/html; charset=utf-8"},
+      {"css", "text/css; charset=utf-8"},
+      {"js", "text/javascript; charset=utf-8"},
+      {"mjs", "text/javascript; charset=utf-8"},
+      {"json", "application/json"},
+      {"map", "application/json"},
+      {"txt", "text/plain; charset=utf-8"},
+      {"xml", "application/xml"},
+      {"svg", "image/svg+xml"},
+      {"png", "image/png"},
+      {"jpg", "image/jpeg"},
+      {"jpeg", "image/jpeg"},
+      {"gif", "image/gif"},
+      {"webp", "image/webp"},
+      {"avif", "image/avif"},
+      {"ico", "image/x-icon"},
+      {"wasm", "application/wasm"},
+      {"woff", "font/woff"},
+      {"woff2", "font/woff2"},
+      {"mp4", "video/mp4"},
+      {"mp3", "audio/mpeg"},
+      {"pdf", "application/pdf"},
+  };
+  size_t end = std::min(path.find('?'), path.size());
+  size_t dot = path.rfind('.', end == 0 ? 0 : end - 1);
+  size_t slash = path.rfind('/', end == 0 ? 0 : end - 1);
+  if (dot == std::string::npos ||
+      (slash != std::string::npos && dot < slash)) {
+    return "application/octet-stream";
+  }
+  std::string ext = path.substr(dot + 1, end - dot - 1);
+  std::transform(ext.begin(), ext.end(), ext.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  auto it = kTypes.find(ext);
+  return it == kTypes.end() ? "application/octet-stream" : it->second;
+}
+
+bool isCompressibleType(const std::string &contentType) {
+  return contentType.rfind("text/", 0) == 0 ||
+         contentType.find("json") != std::string::npos ||
+         contentType.find("javascript") != std::string::npos ||
+         contentType.find("xml") != std::string::npos ||
+         contentType.rfind("application/wasm", 0) == 0;
+}
+
+std::optional<std::string> gzipCompress(const char *data, size_t size,
+                                        int level) {
+  z_stream stream{};
+  // windowBits 15 + 16 表示输出 gzip 格式
+  if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return std::nullopt;
+  }
+  std::string out;
+  out.resize(deflateBound(&stream, static_cast<uLong>(size)));
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+  stream.avail_in = static_cast<uInt>(size);
+  stream.next_out = reinterpret_cast<Bytef *>(out.data());
+  stream.avail_out = static_cast<uInt>(out.size());
+  int result = deflate(&stream, Z_FINISH);
+  size_t written = stream.total_out;
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    return std::nullopt;
+  }
+  out.resize(written);
+  return out;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+std::string percentDecode(std::string_view in) {
+  std::string out;
+  out.reserve(in.size());
+  for (size_t i = 0; i < in.size(); i++) {
+    if (in[i] == '%' && i + 2 < in.size()) {
+      int hi = hexValue(in[i + 1]);
+      int lo = hexValue(in[i + 2]);
+      if (hi >= 0 && lo >= 0) {
+        out.push_back(static_cast<char>(hi * 16 + lo));
+        i += 2;
+        continue;
+      }
+    }
+    out.push_back(in[i]);
+  }
+  return out;
+}
+
+std::string formatHttpDate(time_t seconds) {
+  static const char *kDays[] = {"Sun", "Mon", "Tue", "Wed",
+                                "Thu", "Fri", "Sat"};
+  static const char *kMonths[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  struct tm tm {};
+  gmtime_r(&seconds, &tm);
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+           kDays[tm.tm_wday], tm.tm_mday, kMonths[tm.tm_mon],
+           tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+  return buf;
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,66 @@
+// cpp/StaticAsset.hpp
+#pragma once
+#include "CorsPolicy.hpp"
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace margelo::nitro::http_server {
+
+// 由桥接层直接应答的静态资源（memory、bundle 挂载点共用）
+// data / gzipData 指向的内存由 owner（或持有该结构的 shared_ptr）保持有效
+struct StaticAsset {
+  std::shared_ptr<const void> owner;
+  const char *data = nullptr;
+  size_t size = 0;
+  const char *gzipData = nullptr; // 预先压缩的 gzip 版本，没有时为 nullptr
+  size_t gzipSize = 0;
+  std::string etag;   // 强 ETag（含引号）
+  HeaderList headers; // Content-Type 及调用方指定的响应头
+};
+
+struct StaticReply {
+  int statusCode = 200;
+  std::string headersJson;
+  const char *body = "";
+  size_t bodyLen = 0;
+};
+
+// 按请求头处理条件请求（If-None-Match → 304）、单段 Range（206 / 416）
+// 和 gzip 协商；HEAD 请求不带响应体，Content-Length 与 GET 相同
+StaticReply buildStaticReply(
+    const StaticAsset &asset, const std::string &method,
+    const std::unordered_map<std::string, std::string> &requestHeaders);
+
+// Range 解析结果
+enum class RangeResult { None, Satisfiable, Unsatisfiable };
+
+// 只支持单段 "bytes=start-end" / "bytes=start-" / "bytes=-suffix"
+// 多段或格式不对时返回 None，按完整响应处理
+RangeResult parseByteRange(const std::string &header, size_t size,
+                           size_t &start, size_t &length);
+
+// If-None-Match 是否与 etag 匹配：逐项按弱比较判断，* 匹配任意 etag
+bool etagMatches(const std::string &ifNoneMatch, const std::string &etag);
+
+// 按扩展名推断 Content-Type
+std::string guessContentType(const std::string &path);
+
+// 文本类内容才值得预先压缩
+bool isCompressibleType(const std::string &contentType);
+
+// gzip 压缩；失败返回 std::nullopt
+std::optional<std::string> gzipCompress(const char *data, size_t size,
+                                        int level = 6);
+
+// 请求路径中的 %XX 解码（文件名按原样保存）
+std::string percentDecode(std::string_view in);
+
+// HTTP 日期（Last-Modified 等），如 "Sun, 06 Nov 1994 08:49:37 GMT"
+std::string formatHttpDate(time_t seconds);
+
+} // namespace margelo::nitro::http_server
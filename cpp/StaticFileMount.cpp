@@ -0,0 +1,289 @@
+// cpp/StaticFileMount.cpp
+#include "StaticFileMount.hpp"
+#include "BridgeConfig.hpp"
+#include "StaticAsset.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+namespace margelo::nitro::http_server {
+
+static std::string toLower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return value;
+}
+
+static std::string_view trim(std::string_view value) {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+bool acceptsMediaType(const std::string &accept,
+                      const std::string &mediaType) {
+  std::string_view rest = accept;
+  while (!rest.empty()) {
+    size_t comma = rest.find(',');
+    std::string_view item = rest.substr(0, comma);
+    rest = comma == std::string_view::npos ? std::string_view()
+                                           : rest.substr(comma + 1);
+    size_t semicolon = item.find(';');
+    if (toLower(std::string(trim(item.substr(0, semicolon)))) != mediaType) {
+      continue;
+    }
+    // 参数中的 q=0 表示明确不接受
+    while (semicolon != std::string_view::npos) {
+      item = item.substr(semicolon + 1);
+      semicolon = item.find(';');
+      std::string_view param = trim(item.substr(0, semicolon));
+      if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') &&
+          param[1] == '=') {
+        return std::strtod(std::string(param.substr(2)).c_str(), nullptr) >
+               0.0;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+std::shared_ptr<const StaticFileMount>
+StaticFileMount::fromJson(const JsonValue &mount,
+                          std::shared_ptr<FileLookupCache> lookupCache) {
+  const JsonValue *variants = mount.get("image_variants");
+  bool variantsEnabled =
+      variants &&
+      (variants->isObject() || (variants->isBool() && variants->asBool()));
+  std::shared_ptr<const CacheRules> cacheRules;
+  if (const JsonValue *value = mount.get("cache_rules")) {
+    cacheRules = CacheRules::fromJson(*value);
+  }
+  if (!variantsEnabled && !cacheRules) {
+    return nullptr;
+  }
+  const JsonValue *pathValue = mount.get("path");
+  const JsonValue *rootValue = mount.get("root");
+  std::string path = pathValue ? pathValue->asString("/") : "/";
+  if (!rootValue || rootValue->asString("").empty()) {
+    std::cerr << "[StaticFileMount] static mount " << path
+              << " requires 'root'" << std::endl;
+    return nullptr;
+  }
+  if (const JsonValue *dirList = mount.get("dir_list")) {
+    const JsonValue *enabled = dirList->get("enabled");
+    if (enabled && enabled->asBool()) {
+      std::cerr << "[StaticFileMount] " << path
+                << ": dir_list is enabled, ignoring image_variants and "
+                   "cache_rules"
+                << std::endl;
+      return nullptr;
+    }
+  }
+
+  auto result = std::make_shared<StaticFileMount>();
+  result->_mountPath = path;
+  result->_root = rootValue->asString();
+  while (result->_root.size() > 1 && result->_root.back() == '/') {
+    result->_root.pop_back();
+  }
+  result->_cacheRules = std::move(cacheRules);
+  result->_lookupCache = std::move(lookupCache);
+  if (const JsonValue *value = mount.get("default_index")) {
+    result->_defaultIndex = value->stringList();
+  }
+  if (!variantsEnabled) {
+    result->_formats.clear();
+  } else if (variants->isObject()) {
+    if (const JsonValue *value = variants->get("formats")) {
+      result->_formats.clear();
+      for (const auto &format : value->stringList()) {
+        result->_formats.push_back(toLower(format));
+      }
+    }
+    if (const JsonValue *value = variants->get("extensions")) {
+      result->_extensions.clear();
+      for (const auto &extension : value->stringList()) {
+        result->_extensions.push_back(toLower(extension));
+      }
+    }
+  }
+  return result;
+}
+
+std::optional<StaticFileMount::Match>
+StaticFileMount::stat(const std::string &filePath) const {
+  auto fileStat = _lookupCache->stat(filePath);
+  if (!fileStat) {
+    return std::nullopt;
+  }
+  Match match;
+  match.filePath = filePath;
+  match.stat = *fileStat;
+  return match;
+}
+
+std::optional<StaticFileMount::Match> StaticFileMount::resolve(
+    const std::string &path,
+    const std::unordered_map<std::string, std::string> &headers) const {
+  if (!matchesPathPrefix(path, _mountPath)) {
+    return std::nullopt;
+  }
+  size_t end = std::min(path.find('?'), path.size());
+  size_t base = _mountPath.size();
+  if (base > 0 && _mountPath.back() == '/') {
+    base--;
+  }
+  std::string relative =
+      percentDecode(std::string_view(path).substr(base, end - base));
+  // 不允许跳出根目录
+  if (relative.find('\0') != std::string::npos ||
+      relative.find("/../") != std::string::npos ||
+      (relative.size() >= 3 &&
+       relative.compare(relative.size() - 3, 3, "/..") == 0)) {
+    return std::nullopt;
+  }
+  if (relative.empty() || relative.front() != '/') {
+    relative.insert(relative.begin(), '/');
+  }
+
+  std::optional<Match> match;
+  if (relative.back() != '/') {
+    match = stat(_root + relative);
+  }
+  if (!match || match->stat.isDirectory) {
+    // 目录：依次尝试 default_index
+    std::string dir = _root + relative;
+    if (dir.back() != '/') {
+      dir += '/';
+    }
+    match.reset();
+    for (const auto &index : _defaultIndex) {
+      match = stat(dir + index);
+      if (match && !match->stat.isDirectory) {
+        break;
+      }
+      match.reset();
+    }
+    if (!match) {
+      return std::nullopt;
+    }
+  }
+
+  const std::string &filePath = match->filePath;
+  match->relativePath = filePath.substr(_root.size());
+
+  // 图片：按 _formats 的顺序选第一个客户端接受且存在的兄弟文件
+  size_t slash = filePath.rfind('/');
+  size_t dot = filePath.rfind('.');
+  if (_formats.empty() || dot == std::string::npos ||
+      (slash != std::string::npos && dot < slash) ||
+      std::find(_extensions.begin(), _extensions.end(),
+                toLower(filePath.substr(dot + 1))) == _extensions.end()) {
+    return match;
+  }
+  auto acceptIt = headers.find("accept");
+  std::string stem = filePath.substr(0, dot + 1);
+  std::optional<Match> chosen;
+  for (const auto &format : _formats) {
+    auto sibling = stat(stem + format);
+    if (!sibling || sibling->stat.isDirectory) {
+      continue;
+    }
+    match->varies = true;
+    if (!chosen && acceptIt != headers.end() &&
+        acceptsMediaType(acceptIt->second, "image/" + format)) {
+      chosen = std::move(sibling);
+    }
+  }
+  if (chosen) {
+    chosen->relativePath = match->relativePath;
+    chosen->variant = true;
+    chosen->varies = true;
+    return chosen;
+  }
+  return match;
+}
+
+StaticFileMount::Reply StaticFileMount::buildReply(
+    const Match &match, uint64_t size, const std::string &method,
+    const std::unordered_map<std::string, std::string> &headers) const {
+  auto header = [&headers](const char *name) -> const std::string * {
+    auto it = headers.find(name);
+    return it == headers.end() ? nullptr : &it->second;
+  };
+
+  char etag[48];
+  snprintf(etag, sizeof(etag), "W/\"%llx-%llx\"",
+           static_cast<unsigned long long>(size),
+           static_cast<unsigned long long>(match.stat.mtimeNs));
+  HeaderList replyHeaders;
+  replyHeaders.emplace_back("Content-Type", guessContentType(match.filePath));
+  replyHeaders.emplace_back("ETag", etag);
+  replyHeaders.emplace_back(
+      "Last-Modified",
+      formatHttpDate(static_cast<time_t>(match.stat.mtimeNs / 1000000000)));
+  replyHeaders.emplace_back("Accept-Ranges", "bytes");
+  if (match.varies) {
+    replyHeaders.emplace_back("Vary", "Accept");
+  }
+  // 304 同样带上缓存头，客户端据此刷新本地副本的有效期
+  if (_cacheRules) {
+    _cacheRules->appendHeaders(match.relativePath, replyHeaders);
+  }
+
+  Reply reply;
+  if (const std::string *ifNoneMatch = header("if-none-match");
+      ifNoneMatch && etagMatches(*ifNoneMatch, etag)) {
+    reply.statusCode = 304;
+    reply.headersJson = "{}";
+    appendHeadersToJson(reply.headersJson, replyHeaders);
+    return reply;
+  }
+
+  reply.length = size;
+  const std::string *range = header("range");
+  if (const std::string *ifRange = header("if-range");
+      range && ifRange && *ifRange != etag) {
+    range = nullptr;
+  }
+  if (range) {
+    size_t start = 0;
+    size_t length = 0;
+    switch (parseByteRange(*range, static_cast<size_t>(size), start, length)) {
+    case RangeResult::Satisfiable:
+      reply.statusCode = 206;
+      reply.offset = start;
+      reply.length = length;
+      replyHeaders.emplace_back("Content-Range",
+                                "bytes " + std::to_string(start) + "-" +
+                                    std::to_string(start + length - 1) + "/" +
+                                    std::to_string(size));
+      break;
+    case RangeResult::Unsatisfiable:
+      reply.statusCode = 416;
+      reply.length = 0;
+      replyHeaders.emplace_back("Content-Range",
+                                "bytes */" + std::to_string(size));
+      break;
+    case RangeResult::None:
+      break;
+    }
+  }
+  reply.headersJson = "{}";
+  appendHeadersToJson(reply.headersJson, replyHeaders);
+  if (method == "HEAD") {
+    appendContentLength(reply.headersJson, reply.length);
+    reply.length = 0;
+  }
+  return reply;
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,77 @@
+// cpp/StaticFileMount.hpp
+#pragma once
+#include "CacheRules.hpp"
+#include "FileLookupCache.hpp"
+#include "JsonValue.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// 开启了 image_variants 或 cache_rules 的 static 挂载点：由桥接层（而非 Rust
+// 核心）提供文件
+// - image_variants：图片按 Accept 协商同目录下的兄弟文件
+//   （photo.jpg → photo.avif / photo.webp）
+// - cache_rules：按路径追加 Cache-Control / Expires
+// 文件和兄弟文件的存在性都经过 FileLookupCache，协商不额外发出 stat
+class StaticFileMount {
+public:
+  struct Match {
+    std::string filePath; // 实际发送的文件
+    FileStat stat;
+    // 协商前的文件在根目录下的路径，用于匹配 cache_rules
+    std::string relativePath;
+    bool variant = false; // 是否为协商出的兄弟文件
+    bool varies = false;  // 存在兄弟文件，响应随 Accept 变化（Vary: Accept）
+  };
+
+  // 文件响应的状态码、响应头和要发送的字节范围
+  struct Reply {
+    int statusCode = 200;
+    std::string headersJson;
+    uint64_t offset = 0;
+    uint64_t length = 0; // 为 0 时没有响应体
+  };
+
+  // 解析 { type: 'static', path, root, default_index, image_variants,
+  // cache_rules }；image_variants 为 true 或 { formats, extensions }，或者
+  // cache_rules 有有效规则时生效。两者都没有，或同时开启 dir_list（桥接层
+  // 不生成目录列表）时返回 nullptr，挂载点仍交给 Rust
+  static std::shared_ptr<const StaticFileMount>
+  fromJson(const JsonValue &mount,
+           std::shared_ptr<FileLookupCache> lookupCache);
+
+  // 按请求路径和 Accept 选择文件；文件不存在时返回 std::nullopt（交给 JS）
+  std::optional<Match>
+  resolve(const std::string &path,
+          const std::unordered_map<std::string, std::string> &headers) const;
+
+  // 处理条件请求（If-None-Match → 304）和单段 Range（206 / 416），并追加
+  // cache_rules 的响应头；size 为打开文件后的实际大小；HEAD 请求不带响应体
+  Reply
+  buildReply(const Match &match, uint64_t size, const std::string &method,
+             const std::unordered_map<std::string, std::string> &headers) const;
+
+  const std::string &mountPath() const { return _mountPath; }
+
+private:
+  std::optional<Match> stat(const std::string &filePath) const;
+
+  std::string _mountPath;
+  std::string _root;
+  std::vector<std::string> _defaultIndex{"index.html"};
+  std::vector<std::string> _formats{"avif", "webp"};       // 按优先级
+  std::vector<std::string> _extensions{"jpg", "jpeg", "png"}; // 参与协商的原图
+  std::shared_ptr<const CacheRules> _cacheRules;
+  std::shared_ptr<FileLookupCache> _lookupCache;
+};
+
+// Accept 是否明确列出 mediaType（q=0 视为不接受）
+// image/* 和 */* 不算：并非所有声明 */* 的客户端都能解码 AVIF
+bool acceptsMediaType(const std::string &accept, const std::string &mediaType);
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,166 @@
+// cpp/TrafficCapture.cpp
+#include "TrafficCapture.hpp"
+#include "CaptureFormat.hpp"
+#include <iostream>
+
+namespace margelo::nitro::http_server {
+
+// 缓冲区超过该大小时写入文件
+static constexpr size_t kFlushThreshold = 64 * 1024;
+
+static bool isRedactedHeader(const std::string &name) {
+  return name == "authorization" || name == "proxy-authorization" ||
+         name == "cookie" || name == "set-cookie";
+}
+
+TrafficCapture &TrafficCapture::shared() {
+  static TrafficCapture instance;
+  return instance;
+}
+
+bool TrafficCapture::start(const std::string &filePath,
+                           const Settings &settings) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_file) {
+    return false;
+  }
+  _file = std::fopen(filePath.c_str(), "wb");
+  if (!_file) {
+    std::cerr << "[TrafficCapture] Failed to open " << filePath << std::endl;
+    return false;
+  }
+
+  _settings = settings;
+  _summary = Summary();
+  _summary.filePath = filePath;
+  _startedAt = std::chrono::steady_clock::now();
+  _nextSeq = 1;
+  _buffer.clear();
+
+  auto unixMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+  capture::encodeFileHeader(_buffer, static_cast<uint64_t>(unixMs));
+  _summary.bytesWritten = _buffer.size();
+  flushLocked();
+
+  _active.store(true, std::memory_order_release);
+  return true;
+}
+
+TrafficCapture::Summary TrafficCapture::stop() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _active.store(false, std::memory_order_release);
+  if (!_file) {
+    return Summary();
+  }
+  flushLocked();
+  std::fclose(_file);
+  _file = nullptr;
+
+  _summary.durationMs = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - _startedAt)
+                            .count();
+  return _summary;
+}
+
+uint64_t TrafficCapture::recordRequest(
+    const std::string &method, const std::string &path,
+    const std::unordered_map<std::string, std::string> &headers,
+    const char *body, size_t bodyLen) {
+  if (!active()) {
+    return 0;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  uint64_t hash = bodyLen > 0 ? capture::hashBody(body, bodyLen) : 0;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_file) {
+    return 0;
+  }
+  bool storeBody = bodyLen > 0 && bodyLen <= _settings.maxBodyBytes;
+  size_t estimate = method.size() + path.size() + 32 + (storeBody ? bodyLen : 0);
+  if (_summary.bytesWritten + estimate > _settings.maxFileBytes) {
+    _summary.droppedRequests++;
+    return 0;
+  }
+
+  uint64_t seq = _nextSeq++;
+  std::string payload;
+  capture::Encoder enc(payload);
+  enc.varint(seq);
+  enc.varint(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - _startedAt)
+          .count()));
+  enc.str(method);
+  enc.str(path);
+  if (_settings.captureHeaders) {
+    enc.varint(headers.size());
+    for (const auto &[name, value] : headers) {
+      enc.str(name);
+      if (_settings.redactHeaders && isRedactedHeader(name)) {
+        enc.str("", 0);
+      } else {
+        enc.str(value);
+      }
+    }
+  } else {
+    enc.varint(0);
+  }
+  enc.varint(bodyLen);
+  enc.fixed(hash, 8);
+  enc.u8(storeBody ? 1 : 0);
+  if (storeBody) {
+    enc.str(body, bodyLen);
+  }
+
+  std::string record;
+  capture::appendRecord(record, capture::RecordType::Request, payload);
+  appendLocked(record);
+  _summary.requests++;
+  return seq;
+}
+
+void TrafficCapture::recordResponse(uint64_t seq, int statusCode,
+                                    uint64_t latencyUs, uint64_t bytesSent) {
+  if (seq == 0 || !active()) {
+    return;
+  }
+
+  capture::ResponseRecord response;
+  response.seq = seq;
+  response.statusCode = static_cast<uint64_t>(statusCode > 0 ? statusCode : 0);
+  response.latencyUs = latencyUs;
+  response.bytesSent = bytesSent;
+  std::string payload;
+  capture::encodeResponse(payload, response);
+  std::string record;
+  capture::appendRecord(record, capture::RecordType::Response, payload);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_file) {
+    return;
+  }
+  // 响应记录不受文件上限约束，保证已抓取的请求都有对应结果
+  appendLocked(record);
+  _summary.responses++;
+}
+
+void TrafficCapture::appendLocked(const std::string &record) {
+  _buffer += record;
+  _summary.bytesWritten += record.size();
+  if (_buffer.size() >= kFlushThreshold) {
+    flushLocked();
+  }
+}
+
+void TrafficCapture::flushLocked() {
+  if (_file && !_buffer.empty()) {
+    std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+    std::fflush(_file);
+  }
+  _buffer.clear();
+}
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,63 @@
+// cpp/TrafficCapture.hpp
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::http_server {
+
+// 将进入桥接层的请求及其响应结果写入抓取文件（格式见 CaptureFormat.hpp）
+// 未开启时 record*() 只做一次原子读，几乎没有开销
+class TrafficCapture {
+public:
+  struct Settings {
+    uint64_t maxBodyBytes = 0;            // 请求体不超过该长度时完整保存
+    bool captureHeaders = true;           // 是否保存请求头
+    bool redactHeaders = true;            // 清空 authorization / cookie 的值
+    uint64_t maxFileBytes = 64ull << 20;  // 文件达到上限后丢弃后续请求
+  };
+
+  struct Summary {
+    std::string filePath;
+    uint64_t requests = 0;
+    uint64_t responses = 0;
+    uint64_t droppedRequests = 0;
+    uint64_t bytesWritten = 0;
+    double durationMs = 0;
+  };
+
+  static TrafficCapture &shared();
+
+  // 已在抓取时返回 false
+  bool start(const std::string &filePath, const Settings &settings);
+  Summary stop();
+  bool active() const { return _active.load(std::memory_order_acquire); }
+
+  // 返回抓取序号，0 表示未抓取（未开启或已达上限）
+  uint64_t recordRequest(
+      const std::string &method, const std::string &path,
+      const std::unordered_map<std::string, std::string> &headers,
+      const char *body, size_t bodyLen);
+  void recordResponse(uint64_t seq, int statusCode, uint64_t latencyUs,
+                      uint64_t bytesSent);
+
+private:
+  // 以下方法需持有 _mutex
+  void appendLocked(const std::string &record);
+  void flushLocked();
+
+  std::atomic<bool> _active{false};
+  std::mutex _mutex;
+  FILE *_file = nullptr;
+  Settings _settings;
+  Summary _summary;
+  std::chrono::steady_clock::time_point _startedAt;
+  std::string _buffer;
+  uint64_t _nextSeq = 1;
+};
+
+} // namespace margelo::nitro::http_server
@@ -0,0 +1,176 @@
+// cpp/WorkLane.cpp
+#include "WorkLane.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace margelo::nitro::http_server {
+
+using Clock = std::chrono::steady_clock;
+
+// 唤醒频率的统计窗口
+static constexpr std::chrono::seconds kWakeupWindow{10};
+
+WorkLane::WorkLane(std::string name, size_t maxThreads)
+    : _name(std::move(name)), _maxThreads(std::max<size_t>(maxThreads, 1)),
+      _idleTimeout(WorkLanes::kDefaultIdleTimeout), _windowStart(Clock::now()) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  spawnLocked();
+}
+
+WorkLane::~WorkLane() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _stopping = true;
+  _cv.notify_all();
+  _exitCv.wait(lock, [this] { return _liveThreads == 0; });
+}
+
+void WorkLane::post(std::function<void()> task) {
+  size_t depth;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queue.push_back({std::move(task), Clock::now()});
+    depth = _queue.size();
+    // 排队任务多于空闲线程：增加一个线程
+    if (depth > _idleThreads && _liveThreads < _maxThreads) {
+      spawnLocked();
+    }
+  }
+  _cv.notify_one();
+  uint64_t prevMax = maxQueueDepth.load(std::memory_order_relaxed);
+  while (depth > prevMax &&
+         !maxQueueDepth.compare_exchange_weak(prevMax, depth,
+                                              std::memory_order_relaxed)) {
+  }
+}
+
+void WorkLane::setMaxThreads(size_t maxThreads) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _maxThreads = std::max<size_t>(maxThreads, 1);
+  // 超出上限的线程在下一次醒来时退出
+  _cv.notify_all();
+}
+
+size_t WorkLane::maxThreads() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _maxThreads;
+}
+
+void WorkLane::setIdleTimeout(std::chrono::milliseconds timeout) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _idleTimeout = std::max(timeout, std::chrono::milliseconds(0));
+}
+
+size_t WorkLane::threads() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _liveThreads;
+}
+
+size_t WorkLane::queueDepth() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _queue.size();
+}
+
+double WorkLane::wakeupsPerSec() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  rollWakeupWindowLocked(Clock::now());
+  return _lastWakeupRate;
+}
+
+void WorkLane::spawnLocked() {
+  _liveThreads++;
+  // 线程自行退出（空闲、缩减或析构时），不需要 join
+  std::thread([this] { workerLoop(); }).detach();
+}
+
+void WorkLane::noteWakeupLocked() {
+  wakeups++;
+  rollWakeupWindowLocked(Clock::now());
+  _windowWakeups++;
+}
+
+void WorkLane::rollWakeupWindowLocked(Clock::time_point now) const {
+  auto elapsed = now - _windowStart;
+  if (elapsed < kWakeupWindow) {
+    return;
+  }
+  // 超过两个窗口没有滚动，说明中间的窗口没有唤醒
+  _lastWakeupRate =
+      elapsed < 2 * kWakeupWindow
+          ? static_cast<double>(_windowWakeups) /
+                std::chrono::duration<double>(kWakeupWindow).count()
+          : 0.0;
+  _windowStart = now;
+  _windowWakeups = 0;
+}
+
+void WorkLane::workerLoop() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  for (;;) {
+    if (_queue.empty() && !_stopping && _liveThreads <= _maxThreads) {
+      auto ready = [this] {
+        return _stopping || !_queue.empty() || _liveThreads > _maxThreads;
+      };
+      _idleThreads++;
+      if (_liveThreads > 1) {
+        // 多出的线程：超时对齐到整秒，让同时空闲的线程合并唤醒
+        auto deadline = std::chrono::ceil<std::chrono::seconds>(
+            Clock::now() + _idleTimeout);
+        _cv.wait_until(lock, deadline, ready);
+      } else {
+        _cv.wait(lock, ready);
+      }
+      _idleThreads--;
+      noteWakeupLocked();
+    }
+    // 空闲超时后队列仍为空：多出的线程退出，保留最后一个
+    bool idleExpired = _queue.empty() && _liveThreads > 1;
+    if (_stopping || _liveThreads > _maxThreads || idleExpired) {
+      _liveThreads--;
+      _exitCv.notify_all();
+      return;
+    }
+    if (_queue.empty()) {
+      continue;
+    }
+    Task task = std::move(_queue.front());
+    _queue.pop_front();
+    lock.unlock();
+
+    auto waitedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - task.queuedAt);
+    queueWait.record(static_cast<uint64_t>(std::max<int64_t>(
+        waitedUs.count(), 0)));
+    active++;
+    try {
+      task.run();
+    } catch (const std::exception &e) {
+      std::cerr << "[WorkLane] " << _name << " task failed: " << e.what()
+                << std::endl;
+    } catch (...) {
+      std::cerr << "[WorkLane] " << _name << " task failed" << std::endl;
+    }
+    active--;
+    completed++;
+
+    lock.lock();
+  }
+}
+
+WorkLanes &WorkLanes::shared() {
+  // 不析构：进程退出时可能仍有线程阻塞在读取上传请求体上
+  static WorkLanes *lanes = new WorkLanes();
+  return *lanes;
+}
+
+WorkLanes::WorkLanes()
+    : _static("static", kDefaultMaxThreads),
+      _callback("callback", kDefaultMaxThreads),
+      _fs("fs", kDefaultMaxThreads),
+      _upload("upload", kDefaultMaxThreads),
+      _compute("compute", kDefaultMaxThreads) {}
+
+} // namespace margelo::nitro::http_server
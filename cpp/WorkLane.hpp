@@ -0,0 +1,121 @@
+// cpp/WorkLane.hpp
+#pragma once
+#include "LatencyHistogram.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::http_server {
+
+// 独立的工作线程池（lane）：每类工作有自己的线程和队列，慢的一类不会
+// 挡住其他类。任务按提交顺序出队
+//
+// 线程数随负载自适应：从 1 个线程开始，排队任务多于空闲线程时增加（不超过
+// 上限），多出的线程空闲超过 idleTimeout 后退出。最后一个线程无限期等待，
+// 空闲时不产生定时唤醒；多出线程的超时对齐到整秒，同一时刻到期的线程
+// 一起醒来
+class WorkLane {
+public:
+  WorkLane(std::string name, size_t maxThreads);
+  ~WorkLane();
+
+  WorkLane(const WorkLane &) = delete;
+  WorkLane &operator=(const WorkLane &) = delete;
+
+  void post(std::function<void()> task);
+
+  // 线程数上限（至少 1）；超出的线程在空闲时退出
+  void setMaxThreads(size_t maxThreads);
+  size_t maxThreads() const;
+  void setIdleTimeout(std::chrono::milliseconds timeout);
+
+  const std::string &name() const { return _name; }
+  size_t threads() const; // 当前线程数
+  size_t queueDepth() const;
+  // 最近一个统计窗口（10 秒）内平均每秒的线程唤醒次数
+  double wakeupsPerSec() const;
+
+  // 统计：历史最大队列深度、正在执行的任务数、已完成任务数、
+  // 线程唤醒总次数、排队等待时间
+  std::atomic<uint64_t> maxQueueDepth{0};
+  std::atomic<uint64_t> active{0};
+  std::atomic<uint64_t> completed{0};
+  std::atomic<uint64_t> wakeups{0};
+  LatencyHistogram queueWait;
+
+private:
+  struct Task {
+    std::function<void()> run;
+    std::chrono::steady_clock::time_point queuedAt;
+  };
+
+  void spawnLocked();
+  void noteWakeupLocked();
+  void rollWakeupWindowLocked(std::chrono::steady_clock::time_point now) const;
+  void workerLoop();
+
+  std::string _name;
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::condition_variable _exitCv;
+  std::deque<Task> _queue;
+  size_t _maxThreads = 1;
+  size_t _liveThreads = 0;
+  size_t _idleThreads = 0;
+  std::chrono::milliseconds _idleTimeout;
+  bool _stopping = false;
+
+  // 唤醒频率的统计窗口
+  mutable std::chrono::steady_clock::time_point _windowStart;
+  mutable uint64_t _windowWakeups = 0;
+  mutable double _lastWakeupRate = 0;
+};
+
+// 桥接层的五条 lane：
+//   staticLane   由桥接层直接应答的 GET/HEAD（cache、bundle、SPA），
+//                在这里做 stat 和读文件，不占用 Rust 的工作线程
+//   callbackLane JS 处理器的响应路径（写入分块、结束响应、发送二进制响应）
+//   fsLane       阻塞的文件操作（写入响应缓存、memPut 压缩、流量抓取、
+//                清除缓存、fs polyfill 和 sendFileResponse 的读文件）
+//   uploadLane   读取上传请求体；等待慢客户端时会长时间阻塞，单独一条
+//                lane，不挡住 fsLane 上的文件操作
+//   computeLane  CPU 密集的工作（zlib 流的压缩和解压）
+class WorkLanes {
+public:
+  // 每条 lane 的默认线程数上限，以及多出线程的空闲超时
+  static constexpr size_t kDefaultMaxThreads = 4;
+  static constexpr std::chrono::milliseconds kDefaultIdleTimeout{10000};
+
+  static WorkLanes &shared();
+
+  WorkLane &staticLane() { return _static; }
+  WorkLane &callbackLane() { return _callback; }
+  WorkLane &fsLane() { return _fs; }
+  WorkLane &uploadLane() { return _upload; }
+  WorkLane &computeLane() { return _compute; }
+
+  template <typename F> void forEach(F &&visit) {
+    visit(_static);
+    visit(_callback);
+    visit(_fs);
+    visit(_upload);
+    visit(_compute);
+  }
+
+private:
+  WorkLanes();
+
+  WorkLane _static;
+  WorkLane _callback;
+  WorkLane _fs;
+  WorkLane _upload;
+  WorkLane _compute;
+};
+
+} // namespace margelo::nitro::http_server
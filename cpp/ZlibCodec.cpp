@@ -0,0 +1,210 @@
+// cpp/ZlibCodec.cpp
+#include "ZlibCodec.hpp"
+#include <stdexcept>
+#include <zlib.h>
+
+namespace margelo::nitro::http_server {
+
+// 每次 deflate / inflate 调用的输出块大小
+static constexpr size_t kOutputChunk = 16 * 1024;
+
+struct ZlibCodec::Stream {
+  z_stream z{};
+  bool compress = false;
+
+  ~Stream() {
+    if (compress) {
+      deflateEnd(&z);
+    } else {
+      inflateEnd(&z);
+    }
+  }
+};
+
+std::optional<ZlibMode> parseZlibMode(const std::string &name) {
+  static const std::pair<const char *, ZlibMode> kModes[] = {
+      {"deflate", ZlibMode::Deflate},       {"inflate", ZlibMode::Inflate},
+      {"gzip", ZlibMode::Gzip},             {"gunzip", ZlibMode::Gunzip},
+      {"deflateRaw", ZlibMode::DeflateRaw}, {"inflateRaw", ZlibMode::InflateRaw},
+      {"unzip", ZlibMode::Unzip},
+  };
+  for (const auto &[modeName, mode] : kModes) {
+    if (name == modeName) {
+      return mode;
+    }
+  }
+  return std::nullopt;
+}
+
+const char *zlibModeName(ZlibMode mode) {
+  switch (mode) {
+  case ZlibMode::Deflate:
+    return "deflate";
+  case ZlibMode::Inflate:
+    return "inflate";
+  case ZlibMode::Gzip:
+    return "gzip";
+  case ZlibMode::Gunzip:
+    return "gunzip";
+  case ZlibMode::DeflateRaw:
+    return "deflateRaw";
+  case ZlibMode::InflateRaw:
+    return "inflateRaw";
+  case ZlibMode::Unzip:
+    return "unzip";
+  }
+  return "";
+}
+
+bool ZlibCodec::compresses() const {
+  return _mode == ZlibMode::Deflate || _mode == ZlibMode::Gzip ||
+         _mode == ZlibMode::DeflateRaw;
+}
+
+ZlibCodec::ZlibCodec(ZlibMode mode, const ZlibParams &params)
+    : _mode(mode), _stream(std::make_unique<Stream>()) {
+  if (params.windowBits < 8 || params.windowBits > 15) {
+    throw std::invalid_argument("Invalid windowBits: " +
+                                std::to_string(params.windowBits));
+  }
+  int windowBits = params.windowBits;
+  switch (mode) {
+  case ZlibMode::Gzip:
+  case ZlibMode::Gunzip:
+    windowBits += 16;
+    break;
+  case ZlibMode::DeflateRaw:
+  case ZlibMode::InflateRaw:
+    windowBits = -windowBits;
+    break;
+  case ZlibMode::Unzip:
+    windowBits += 32;
+    break;
+  default:
+    break;
+  }
+  // zlib 不接受 raw deflate 的 8 位窗口
+  if (windowBits == -8) {
+    windowBits = -9;
+  }
+  int result;
+  if (compresses()) {
+    result = deflateInit2(&_stream->z, params.level, Z_DEFLATED, windowBits,
+                          params.memLevel, params.strategy);
+  } else {
+    result = inflateInit2(&_stream->z, windowBits);
+  }
+  if (result != Z_OK) {
+    throw std::invalid_argument(_stream->z.msg ? _stream->z.msg
+                                               : "Invalid zlib options");
+  }
+  _stream->compress = compresses();
+}
+
+ZlibCodec::~ZlibCodec() = default;
+
+// gunzip / unzip 在一个 member 结束后，是否紧跟着下一个 gzip member
+static bool isGzipMagic(const uint8_t *data) {
+  return data[0] == 0x1f && data[1] == 0x8b;
+}
+
+std::vector<uint8_t> ZlibCodec::process(const uint8_t *data, size_t len,
+                                        int flush) {
+  std::vector<uint8_t> out;
+  if (_ended) {
+    return out;
+  }
+  z_stream &z = _stream->z;
+  // 上一个 gzip member 已结束：下一个 member 可能从这次输入才开始
+  std::vector<uint8_t> carried;
+  if (_memberEnded) {
+    carried = std::move(_carry);
+    carried.insert(carried.end(), data, data + len);
+    if (carried.size() < 2) {
+      if (!carried.empty() && carried[0] == 0x1f && flush != Z_FINISH) {
+        _carry = std::move(carried);
+      } else if (!carried.empty() || flush == Z_FINISH) {
+        _ended = true;
+      }
+      return out;
+    }
+    if (!isGzipMagic(carried.data()) || inflateReset(&z) != Z_OK) {
+      // 流结束后的其他数据被丢弃（与 Node 一致）
+      _ended = true;
+      return out;
+    }
+    _memberEnded = false;
+    data = carried.data();
+    len = carried.size();
+  }
+  z.next_in = const_cast<Bytef *>(data);
+  z.avail_in = static_cast<uInt>(len);
+  for (;;) {
+    size_t offset = out.size();
+    out.resize(offset + kOutputChunk);
+    z.next_out = out.data() + offset;
+    z.avail_out = static_cast<uInt>(kOutputChunk);
+    int result = _stream->compress ? deflate(&z, flush) : inflate(&z, flush);
+    out.resize(offset + kOutputChunk - z.avail_out);
+
+    if (result == Z_STREAM_END) {
+      if (_mode != ZlibMode::Gunzip && _mode != ZlibMode::Unzip) {
+        _ended = true;
+        break;
+      }
+      if (z.avail_in >= 2 && isGzipMagic(z.next_in)) {
+        if (inflateReset(&z) == Z_OK) {
+          continue;
+        }
+        _ended = true;
+        break;
+      }
+      // 输入已用完（或只剩半个 magic）：等下一次输入再判断
+      if (z.avail_in == 0 || (z.avail_in == 1 && z.next_in[0] == 0x1f)) {
+        _memberEnded = flush != Z_FINISH;
+        _ended = flush == Z_FINISH;
+        _carry.assign(z.next_in, z.next_in + z.avail_in);
+      } else {
+        _ended = true;
+      }
+      break;
+    }
+    if (result == Z_BUF_ERROR) {
+      // Z_FINISH 时输出块写满也返回 Z_BUF_ERROR：扩大输出继续
+      if (z.avail_out == 0) {
+        continue;
+      }
+      // 没有进展：输入已用完，或 flush 已完成
+      if (flush == Z_FINISH && !_stream->compress && z.avail_in == 0) {
+        throw std::runtime_error("unexpected end of file");
+      }
+      break;
+    }
+    if (result != Z_OK) {
+      throw std::runtime_error(z.msg ? z.msg : "zlib error");
+    }
+    if (z.avail_in == 0 && z.avail_out != 0) {
+      // 输入已用完，且输出没有填满（zlib 没有积压的输出）
+      if (flush == Z_FINISH && !_stream->compress) {
+        throw std::runtime_error("unexpected end of file");
+      }
+      if (flush != Z_FINISH) {
+        break;
+      }
+    }
+  }
+  return out;
+}
+
+void ZlibCodec::reset() {
+  if (_stream->compress) {
+    deflateReset(&_stream->z);
+  } else {
+    inflateReset(&_stream->z);
+  }
+  _ended = false;
+  _memberEnded = false;
+  _carry.clear();
+}
+
+} // namespace margelo::nitro::http_server
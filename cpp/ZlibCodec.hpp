@@ -0,0 +1,68 @@
+// cpp/ZlibCodec.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::http_server {
+
+// 与 Node zlib 的类同名：deflate / inflate（zlib 头）、gzip / gunzip、
+// deflateRaw / inflateRaw（无头）、unzip（自动识别 gzip / zlib 头）
+enum class ZlibMode : uint8_t {
+  Deflate,
+  Inflate,
+  Gzip,
+  Gunzip,
+  DeflateRaw,
+  InflateRaw,
+  Unzip,
+};
+
+std::optional<ZlibMode> parseZlibMode(const std::string &name);
+const char *zlibModeName(ZlibMode mode);
+
+// 与 Node 的 zlib options 同名同默认值
+struct ZlibParams {
+  int level = -1;      // Z_DEFAULT_COMPRESSION
+  int windowBits = 15;
+  int memLevel = 8;
+  int strategy = 0;    // Z_DEFAULT_STRATEGY
+};
+
+// 一个压缩或解压流；不是线程安全的，调用方负责串行调用
+class ZlibCodec {
+public:
+  // 参数无效时抛出 std::invalid_argument
+  ZlibCodec(ZlibMode mode, const ZlibParams &params);
+  ~ZlibCodec();
+  ZlibCodec(const ZlibCodec &) = delete;
+  ZlibCodec &operator=(const ZlibCodec &) = delete;
+
+  ZlibMode mode() const { return _mode; }
+
+  // 输入一段数据，返回这次产生的输出。flush 取 zlib 的 Z_NO_FLUSH、
+  // Z_SYNC_FLUSH、Z_FULL_FLUSH、Z_FINISH 等；数据损坏时抛出
+  // std::runtime_error。流结束后的输入被忽略（gunzip / unzip 遇到下一个
+  // gzip member 时继续解压）
+  std::vector<uint8_t> process(const uint8_t *data, size_t len, int flush);
+
+  // 回到初始状态，参数不变
+  void reset();
+
+private:
+  struct Stream;
+
+  bool compresses() const;
+
+  ZlibMode _mode;
+  std::unique_ptr<Stream> _stream;
+  bool _ended = false;
+  // gunzip / unzip：当前 gzip member 已结束，下一次输入决定是否还有 member
+  bool _memberEnded = false;
+  std::vector<uint8_t> _carry; // 半个 gzip magic（0x1f）
+};
+
+} // namespace margelo::nitro::http_server
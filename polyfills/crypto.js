@@ -1,13 +1,112 @@
-module.exports = {
-  createHmac: (algorithm, key) => {
-    return {
-      update: (data) => {
-        return {
-          digest: (encoding) => {
-            return data;
-          }
-        }
-      }
+// Node crypto 的哈希 / HMAC 部分，由原生 Crypto HybridObject 实现
+const { NitroModules } = require('react-native-nitro-modules');
+
+let nativeCrypto = null;
+
+function getNativeCrypto() {
+  if (!nativeCrypto) {
+    nativeCrypto = NitroModules.createHybridObject('Crypto');
+  }
+  return nativeCrypto;
+}
+
+function isUtf8(encoding) {
+  return !encoding || encoding === 'utf8' || encoding === 'utf-8';
+}
+
+// string / Buffer / TypedArray / DataView 转为 ArrayBuffer，能不复制时不复制
+function toArrayBuffer(data, encoding) {
+  if (data instanceof ArrayBuffer) {
+    return data;
+  }
+  const view = typeof data === 'string' ? Buffer.from(data, encoding || 'utf8') : data;
+  if (!ArrayBuffer.isView(view)) {
+    throw new TypeError('The "data" argument must be of type string or an instance of Buffer, TypedArray, or DataView');
+  }
+  if (view.byteOffset === 0 && view.byteLength === view.buffer.byteLength) {
+    return view.buffer;
+  }
+  return view.buffer.slice(view.byteOffset, view.byteOffset + view.byteLength);
+}
+
+function encodeDigest(result, outputEncoding) {
+  const buffer = Buffer.from(result);
+  return outputEncoding && outputEncoding !== 'buffer' ? buffer.toString(outputEncoding) : buffer;
+}
+
+class Hash {
+  constructor(context) {
+    this._context = context;
+  }
+
+  update(data, inputEncoding) {
+    if (typeof data === 'string' && isUtf8(inputEncoding)) {
+      this._context.updateString(data);
+    } else {
+      this._context.update(toArrayBuffer(data, inputEncoding));
     }
+    return this;
+  }
+
+  digest(outputEncoding) {
+    return encodeDigest(this._context.digest(), outputEncoding);
+  }
+
+  copy() {
+    return new Hash(this._context.copy());
   }
-};
\ No newline at end of file
+}
+
+class Hmac {
+  constructor(context) {
+    this._context = context;
+  }
+
+  update(data, inputEncoding) {
+    if (typeof data === 'string' && isUtf8(inputEncoding)) {
+      this._context.updateString(data);
+    } else {
+      this._context.update(toArrayBuffer(data, inputEncoding));
+    }
+    return this;
+  }
+
+  digest(outputEncoding) {
+    return encodeDigest(this._context.digest(), outputEncoding);
+  }
+}
+
+function createHash(algorithm) {
+  return new Hash(getNativeCrypto().createHash(algorithm));
+}
+
+function createHmac(algorithm, key) {
+  return new Hmac(getNativeCrypto().createHmac(algorithm, toArrayBuffer(key)));
+}
+
+function getHashes() {
+  return getNativeCrypto().getHashes();
+}
+
+// 比较耗时与内容无关，用于校验签名
+function timingSafeEqual(a, b) {
+  const left = new Uint8Array(toArrayBuffer(a));
+  const right = new Uint8Array(toArrayBuffer(b));
+  if (left.length !== right.length) {
+    throw new RangeError('Input buffers must have the same byte length');
+  }
+  let diff = 0;
+  for (let i = 0; i < left.length; i++) {
+    diff |= left[i] ^ right[i];
+  }
+  return diff === 0;
+}
+
+module.exports = {
+  Hash,
+  Hmac,
+  createHash,
+  createHmac,
+  getHashes,
+  timingSafeEqual,
+};
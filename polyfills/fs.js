@@ -1,5 +1,202 @@
-module.exports = {
-    ReadStream: () => {
+// Node fs 的 createReadStream / stat 部分，由原生 FileSystem HybridObject 实现
+// 文件在桥接层的 fs lane 上打开和读取；ReadStream pipe 到 http.ServerResponse
+// 时整个文件交给原生发送，数据不进入 JS。依赖 stream 模块（如 readable-stream）
+const { Readable } = require('stream');
+const { NitroModules } = require('react-native-nitro-modules');
+
+// 与 src/http.ts 中 ServerResponse 的同名 Symbol 对应
+const kSendFile = Symbol.for('react-native-nitro-http-server.sendFile');
+
+let nativeFs = null;
+
+function getNativeFs() {
+  if (!nativeFs) {
+    nativeFs = NitroModules.createHybridObject('FileSystem');
+  }
+  return nativeFs;
+}
+
+// 原生错误消息形如 "ENOENT: ..., open '<path>'"，补上 Node 的 code / syscall / path
+function toFsError(error) {
+  const err = error instanceof Error ? error : new Error(String(error));
+  const match = /\b(E[A-Z]+|UNKNOWN): .*, (\w+) '(.*)'$/.exec(err.message);
+  if (match) {
+    err.code = match[1];
+    err.syscall = match[2];
+    err.path = match[3];
+  }
+  return err;
+}
+
+class Stats {
+  constructor(stats) {
+    this.size = stats.size;
+    this.mode = stats.mode;
+    this.ino = stats.ino;
+    this.mtimeMs = stats.mtimeMs;
+    this.atimeMs = stats.mtimeMs;
+    this.ctimeMs = stats.mtimeMs;
+    this.birthtimeMs = stats.mtimeMs;
+    this.mtime = new Date(stats.mtimeMs);
+    this.atime = this.mtime;
+    this.ctime = this.mtime;
+    this.birthtime = this.mtime;
+    this._isFile = stats.isFile;
+    this._isDirectory = stats.isDirectory;
+  }
+
+  isFile() {
+    return this._isFile;
+  }
+
+  isDirectory() {
+    return this._isDirectory;
+  }
+
+  isSymbolicLink() {
+    return false;
+  }
+}
 
+class ReadStream extends Readable {
+  constructor(path, options) {
+    const opts = typeof options === 'string' ? { encoding: options } : { ...options };
+    super({
+      highWaterMark: opts.highWaterMark || 64 * 1024,
+      encoding: opts.encoding,
+      emitClose: opts.emitClose !== false,
+    });
+    this.path = String(path);
+    this.fd = null;
+    this.flags = opts.flags || 'r';
+    this.start = opts.start;
+    this.end = opts.end === undefined ? Infinity : opts.end;
+    this.pos = this.start || 0;
+    this.bytesRead = 0;
+    this.pending = true;
+    this._handle = null;
+    // 打开失败时流以错误结束，resolve 为 null
+    this._opening = getNativeFs().open(this.path).then(
+      (handle) => {
+        if (this.destroyed) {
+          handle.close();
+          return null;
+        }
+        this._handle = handle;
+        this.pending = false;
+        this.emit('open', this.fd);
+        this.emit('ready');
+        return handle;
+      },
+      (error) => {
+        this.destroy(toFsError(error));
+        return null;
+      }
+    );
+  }
+
+  _read(size) {
+    this._opening.then((handle) => {
+      if (!handle || this.destroyed) {
+        return;
+      }
+      const length = Math.min(size, this.end - this.pos + 1);
+      if (length <= 0) {
+        this.push(null);
+        return;
+      }
+      handle.read(this.pos, length).then(
+        (data) => {
+          if (data.byteLength === 0) {
+            this.push(null);
+            return;
+          }
+          this.pos += data.byteLength;
+          this.bytesRead += data.byteLength;
+          this.push(Buffer.from(data));
+        },
+        (error) => this.destroy(toFsError(error))
+      );
+    });
+  }
+
+  _destroy(error, callback) {
+    this._opening.then((handle) => {
+      if (handle) {
+        handle.close();
+        this._handle = null;
+      }
+      callback(error);
+    });
+  }
+
+  close(callback) {
+    if (callback) {
+      this.once('close', callback);
+    }
+    this.destroy();
+  }
+
+  // 目标是 ServerResponse 且还没有读过数据时，把文件交给原生发送；
+  // 其他目标（或响应已经写过数据）照常逐块读取
+  // 原生发送时流由原生消费：不产生 'data' 事件，发送完成后以 push(null)
+  // 正常结束，'end' 和 'close' 由 stream 模块按通常顺序触发；出错时只 destroy
+  pipe(destination, options) {
+    const sendFile = destination && destination[kSendFile];
+    if (typeof sendFile !== 'function' || (options && options.end === false) ||
+        this.readableFlowing !== null || this.bytesRead > 0 || this.readableEncoding) {
+      return super.pipe(destination, options);
     }
-};
\ No newline at end of file
+    destination.emit('pipe', this);
+    this._opening.then((handle) => {
+      if (!handle || this.destroyed) {
+        return;
+      }
+      const end = this.end === Infinity ? undefined : this.end;
+      const accepted = sendFile.call(destination, handle, this.start, end, (error) => {
+        if (error) {
+          // 桥接层已经结束了响应，这里只关闭文件
+          this.destroy();
+          return;
+        }
+        this.bytesRead = Math.max(0, Math.min(this.end, handle.size - 1) - (this.start || 0) + 1);
+        this.pos += this.bytesRead;
+        // 流已结束，resume 只用于让 stream 模块发出 'end'，不会再调用 _read
+        this.once('end', () => this.destroy());
+        this.push(null);
+        this.resume();
+      });
+      if (!accepted) {
+        super.pipe(destination, options);
+      }
+    });
+    return destination;
+  }
+}
+
+function createReadStream(path, options) {
+  return new ReadStream(path, options);
+}
+
+function stat(path, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+  }
+  getNativeFs().stat(String(path)).then(
+    (stats) => callback(null, new Stats(stats)),
+    (error) => callback(toFsError(error))
+  );
+}
+
+module.exports = {
+  ReadStream,
+  Stats,
+  createReadStream,
+  stat,
+  promises: {
+    stat: (path) => getNativeFs().stat(String(path)).then(
+      (stats) => new Stats(stats),
+      (error) => Promise.reject(toFsError(error))
+    ),
+  },
+};
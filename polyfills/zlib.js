@@ -1,2 +1,228 @@
+// Node zlib 的 deflate / inflate / gzip 部分，由原生 Zlib HybridObject 实现
+// 流式接口在桥接层的 compute lane 上压缩，不阻塞 JS 线程；依赖 stream 模块
+// （如 readable-stream）。不提供 brotli：createBrotliCompress 等不存在时，
+// compression 等中间件会退回 gzip
+const { Transform } = require('stream');
+const { NitroModules } = require('react-native-nitro-modules');
+
+const constants = {
+  Z_NO_FLUSH: 0,
+  Z_PARTIAL_FLUSH: 1,
+  Z_SYNC_FLUSH: 2,
+  Z_FULL_FLUSH: 3,
+  Z_FINISH: 4,
+  Z_BLOCK: 5,
+  Z_OK: 0,
+  Z_STREAM_END: 1,
+  Z_NEED_DICT: 2,
+  Z_ERRNO: -1,
+  Z_STREAM_ERROR: -2,
+  Z_DATA_ERROR: -3,
+  Z_MEM_ERROR: -4,
+  Z_BUF_ERROR: -5,
+  Z_VERSION_ERROR: -6,
+  Z_NO_COMPRESSION: 0,
+  Z_BEST_SPEED: 1,
+  Z_BEST_COMPRESSION: 9,
+  Z_DEFAULT_COMPRESSION: -1,
+  Z_FILTERED: 1,
+  Z_HUFFMAN_ONLY: 2,
+  Z_RLE: 3,
+  Z_FIXED: 4,
+  Z_DEFAULT_STRATEGY: 0,
+  DEFLATE: 1,
+  INFLATE: 2,
+  GZIP: 3,
+  GUNZIP: 4,
+  DEFLATERAW: 5,
+  INFLATERAW: 6,
+  UNZIP: 7,
+};
+
+let nativeZlib = null;
+
+function getNativeZlib() {
+  if (!nativeZlib) {
+    nativeZlib = NitroModules.createHybridObject('Zlib');
+  }
+  return nativeZlib;
+}
+
+// string / Buffer / TypedArray / DataView 转为 ArrayBuffer，能不复制时不复制
+function toArrayBuffer(data, encoding) {
+  if (data instanceof ArrayBuffer) {
+    return data;
+  }
+  const view = typeof data === 'string' ? Buffer.from(data, encoding || 'utf8') : data;
+  if (!ArrayBuffer.isView(view)) {
+    throw new TypeError('The "buffer" argument must be of type string or an instance of Buffer, TypedArray, DataView, or ArrayBuffer');
+  }
+  if (view.byteOffset === 0 && view.byteLength === view.buffer.byteLength) {
+    return view.buffer;
+  }
+  return view.buffer.slice(view.byteOffset, view.byteOffset + view.byteLength);
+}
+
+function nativeOptions(options) {
+  const { level, windowBits, memLevel, strategy } = options || {};
+  return { level, windowBits, memLevel, strategy };
+}
+
+// flush() 写入一个带标记的空块，与之前写入的数据按顺序处理
+const kFlushFlag = Symbol('kFlushFlag');
+
+class ZlibBase extends Transform {
+  constructor(mode, options) {
+    super(options);
+    this._opts = options || {};
+    this._native = getNativeZlib().createStream(mode, nativeOptions(this._opts));
+    this._defaultFlush = this._opts.flush !== undefined ? this._opts.flush : constants.Z_NO_FLUSH;
+    this._finishFlush = this._opts.finishFlush !== undefined ? this._opts.finishFlush : constants.Z_FINISH;
+    this.bytesWritten = 0;
+  }
+
+  _processChunk(chunk, flush, callback) {
+    this._native.write(chunk, flush).then(
+      (output) => {
+        if (output.byteLength > 0) {
+          this.push(Buffer.from(output));
+        }
+        callback();
+      },
+      (error) => callback(error)
+    );
+  }
+
+  _transform(chunk, encoding, callback) {
+    const flush = chunk[kFlushFlag] !== undefined ? chunk[kFlushFlag] : this._defaultFlush;
+    const data = toArrayBuffer(chunk, encoding);
+    this.bytesWritten += data.byteLength;
+    this._processChunk(data, flush, callback);
+  }
+
+  _flush(callback) {
+    this._processChunk(new ArrayBuffer(0), this._finishFlush, callback);
+  }
+
+  flush(kind, callback) {
+    if (typeof kind === 'function' || kind === undefined) {
+      callback = kind;
+      kind = constants.Z_FULL_FLUSH;
+    }
+    const marker = Buffer.alloc(0);
+    marker[kFlushFlag] = kind;
+    this.write(marker, callback);
+  }
+
+  reset() {
+    this._native.reset();
+  }
+
+  close(callback) {
+    if (callback) {
+      process.nextTick(callback);
+    }
+    this.destroy();
+  }
+}
+
+class Deflate extends ZlibBase {
+  constructor(options) {
+    super('deflate', options);
+  }
+}
+
+class Inflate extends ZlibBase {
+  constructor(options) {
+    super('inflate', options);
+  }
+}
+
+class Gzip extends ZlibBase {
+  constructor(options) {
+    super('gzip', options);
+  }
+}
+
+class Gunzip extends ZlibBase {
+  constructor(options) {
+    super('gunzip', options);
+  }
+}
+
+class DeflateRaw extends ZlibBase {
+  constructor(options) {
+    super('deflateRaw', options);
+  }
+}
+
+class InflateRaw extends ZlibBase {
+  constructor(options) {
+    super('inflateRaw', options);
+  }
+}
+
+class Unzip extends ZlibBase {
+  constructor(options) {
+    super('unzip', options);
+  }
+}
+
+function processSync(mode, buffer, options) {
+  const stream = getNativeZlib().createStream(mode, nativeOptions(options));
+  const finishFlush = options && options.finishFlush !== undefined ? options.finishFlush : constants.Z_FINISH;
+  return Buffer.from(stream.writeSync(toArrayBuffer(buffer), finishFlush));
+}
+
+function processAsync(mode, buffer, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = {};
+  }
+  let stream;
+  let data;
+  try {
+    stream = getNativeZlib().createStream(mode, nativeOptions(options));
+    data = toArrayBuffer(buffer);
+  } catch (error) {
+    process.nextTick(callback, error);
+    return;
+  }
+  const finishFlush = options && options.finishFlush !== undefined ? options.finishFlush : constants.Z_FINISH;
+  stream.write(data, finishFlush).then(
+    (output) => callback(null, Buffer.from(output)),
+    (error) => callback(error)
+  );
+}
+
 module.exports = {
-};
\ No newline at end of file
+  constants,
+  Deflate,
+  Inflate,
+  Gzip,
+  Gunzip,
+  DeflateRaw,
+  InflateRaw,
+  Unzip,
+  createDeflate: (options) => new Deflate(options),
+  createInflate: (options) => new Inflate(options),
+  createGzip: (options) => new Gzip(options),
+  createGunzip: (options) => new Gunzip(options),
+  createDeflateRaw: (options) => new DeflateRaw(options),
+  createInflateRaw: (options) => new InflateRaw(options),
+  createUnzip: (options) => new Unzip(options),
+  deflate: (buffer, options, callback) => processAsync('deflate', buffer, options, callback),
+  inflate: (buffer, options, callback) => processAsync('inflate', buffer, options, callback),
+  gzip: (buffer, options, callback) => processAsync('gzip', buffer, options, callback),
+  gunzip: (buffer, options, callback) => processAsync('gunzip', buffer, options, callback),
+  deflateRaw: (buffer, options, callback) => processAsync('deflateRaw', buffer, options, callback),
+  inflateRaw: (buffer, options, callback) => processAsync('inflateRaw', buffer, options, callback),
+  unzip: (buffer, options, callback) => processAsync('unzip', buffer, options, callback),
+  deflateSync: (buffer, options) => processSync('deflate', buffer, options),
+  inflateSync: (buffer, options) => processSync('inflate', buffer, options),
+  gzipSync: (buffer, options) => processSync('gzip', buffer, options),
+  gunzipSync: (buffer, options) => processSync('gunzip', buffer, options),
+  deflateRawSync: (buffer, options) => processSync('deflateRaw', buffer, options),
+  inflateRawSync: (buffer, options) => processSync('inflateRaw', buffer, options),
+  unzipSync: (buffer, options) => processSync('unzip', buffer, options),
+};
@@ -0,0 +1,58 @@
+// src/Crypto.nitro.ts
+import { type HybridObject } from 'react-native-nitro-modules'
+
+// 一次哈希 / HMAC 计算的流式状态（由 Crypto.createHash / createHmac 创建）
+export interface HashContext extends HybridObject<{
+    ios: 'c++',
+    android: 'c++'
+}> {
+    readonly algorithm: string     // 规范化后的算法名，如 'sha256'
+
+    /**
+     * 追加数据
+     * @param data 二进制数据
+     */
+    update(data: ArrayBuffer): void
+
+    /**
+     * 追加字符串（按 UTF-8 编码），省去 JS 侧的编码和复制
+     * @param data 字符串
+     */
+    updateString(data: string): void
+
+    /**
+     * 计算结果，之后不能再调用 update / digest
+     * @returns 摘要的原始字节
+     */
+    digest(): ArrayBuffer
+
+    /**
+     * 复制当前状态（Node 的 hash.copy()），HMAC 不支持
+     */
+    copy(): HashContext
+}
+
+// 原生哈希 / HMAC，支持 md5、sha1、sha256、sha384、sha512
+// SHA-1 / SHA-256 在 CPU 支持时使用硬件指令
+export interface Crypto extends HybridObject<{
+    ios: 'c++',
+    android: 'c++'
+}> {
+    /**
+     * 创建哈希计算
+     * @param algorithm 算法名，如 'sha256'、'SHA-256'
+     */
+    createHash(algorithm: string): HashContext
+
+    /**
+     * 创建 HMAC 计算
+     * @param algorithm 算法名
+     * @param key 密钥
+     */
+    createHmac(algorithm: string, key: ArrayBuffer): HashContext
+
+    /**
+     * 支持的算法名
+     */
+    getHashes(): string[]
+}
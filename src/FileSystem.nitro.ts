@@ -0,0 +1,52 @@
+// src/FileSystem.nitro.ts
+import { type HybridObject } from 'react-native-nitro-modules'
+
+// fs.stat 需要的文件信息
+export interface FileStats {
+    size: number
+    mtimeMs: number
+    mode: number
+    ino: number
+    isFile: boolean
+    isDirectory: boolean
+}
+
+// 一个已打开的只读文件（由 FileSystem.open 创建）
+// 可交给 HttpServer.sendFileResponse 直接作为响应体发送，数据不经过 JS
+export interface FileHandle extends HybridObject<{
+    ios: 'c++',
+    android: 'c++'
+}> {
+    readonly size: number          // 打开时的文件大小
+
+    /**
+     * 在桥接层的 fs lane 上读取一段数据
+     * @param position 起始偏移
+     * @param length 最多读取的字节数
+     * @returns 读到的数据，到达文件末尾时为空
+     */
+    read(position: number, length: number): Promise<ArrayBuffer>
+
+    /**
+     * 关闭文件；进行中的读取和发送完成后才真正关闭
+     */
+    close(): void
+}
+
+// 原生文件读取，用于 fs polyfill 的 createReadStream / stat
+export interface FileSystem extends HybridObject<{
+    ios: 'c++',
+    android: 'c++'
+}> {
+    /**
+     * 在 fs lane 上打开文件
+     * @param path 文件路径
+     */
+    open(path: string): Promise<FileHandle>
+
+    /**
+     * 在 fs lane 上获取文件信息
+     * @param path 文件路径
+     */
+    stat(path: string): Promise<FileStats>
+}
@@ -1,5 +1,6 @@
 // src/HttpServer.nitro.ts
 import { type HybridObject } from 'react-native-nitro-modules'
+import { type FileHandle } from './FileSystem.nitro'
 
 // HTTP 请求接口
 export interface HttpRequest {
@@ -19,6 +20,10 @@ export interface HttpResponse {
 
 }
 
+// 流式/二进制响应的响应头：数组值按逗号拼接成一个头（Rust 核心不支持同名头）；
+// Set-Cookie 不能拼接，只发送最后一个值
+export type ResponseHeaders = Record<string, string | string[]>
+
 // 服务器统计信息接口
 export interface ServerStats {
     totalRequests: number
@@ -29,9 +34,210 @@ export interface ServerStats {
     errorCount: number
 }
 
+// 桥接层中待处理请求的阶段
+export type PendingRequestStage = 'dispatched' | 'handling' | 'reading' | 'writing'
+
+// 待处理请求快照
+export interface PendingRequestInfo {
+    requestId: string
+    method: string
+    path: string
+    stage: PendingRequestStage
+    ageMs: number                  // 自投递到 JS 以来经过的毫秒数
+    bytesReceived: number
+    bytesSent: number
+}
+
+// 活跃连接快照（桥接层目前只能看到 WebSocket 连接）
+export interface ConnectionInfo {
+    connectionId: string
+    protocol: string               // 例如 'websocket'
+    peer: string                   // 对端地址（来自握手头，未知时为空字符串）
+    path: string                   // 建立连接的请求路径
+    ageMs: number
+    bytesReceived: number
+    bytesSent: number
+}
+
+// 服务器当前活动快照
+export interface ServerActivity {
+    connections: ConnectionInfo[]
+    pendingRequests: PendingRequestInfo[]  // 按等待时间从长到短排列
+}
+
+// 延迟直方图中的一个桶
+export interface LatencyBucket {
+    upperBoundMs: number
+    count: number
+}
+
+// 桥接层（C++ ↔ JS）统计信息
+export interface BridgeStats {
+    dispatchedRequests: number     // 已投递到 JS 的请求总数
+    dispatchQueueDepth: number     // 已投递但 JS 处理器尚未开始执行的请求数
+    dispatchDelayMeanMs: number    // 投递到处理器开始执行之间的平均等待
+    dispatchDelayP50Ms: number
+    dispatchDelayP90Ms: number
+    dispatchDelayP99Ms: number
+    dispatchDelayMaxMs: number
+    dispatchDelayHistogram: LatencyBucket[]  // 仅包含非空桶
+    completedResponses: number     // 已完成的 JS 回调响应数
+    nativeCallsPerResponseMean: number  // 平均每个响应调用原生响应接口的次数（写入合并的效果）
+    nativeCallsPerResponseMax: number
+    corsPreflightsAnswered: number // 由桥接层直接应答的 CORS 预检请求数
+    spaFallbacksServed: number     // 由桥接层直接返回入口 HTML 的 SPA 回退请求数
+    staticLookupCacheHits: number  // 桥接层文件探测直接由缓存应答的次数
+    staticLookupProbes: number     // 桥接层文件探测实际发出的 stat 次数
+    responseCacheHits: number      // 由 cache 挂载点直接应答的请求数
+    responseCacheStores: number    // 写入 cache 挂载点的响应数
+    memoryMountHits: number        // 由 memory 挂载点直接应答的请求数
+    memoryStoreBytes: number       // memPut 写入的内容（含压缩版本）占用的内存
+    bundleHits: number             // 由 bundle 挂载点直接应答的请求数
+    uringFileReads: number         // 通过 io_uring 完成的桥接层文件读取次数
+    failedRequests: number         // 桥接层处理出错、直接返回 500 的请求数
+    decompressedRequests: number   // 由桥接层解压后交给 JS 的请求体数
+    rejectedCompressedRequests: number // 损坏（400）或超过解压限制（413）的压缩请求体数
+    fileResponses: number          // 通过 sendFileResponse 直接从文件发送的响应数
+    imageVariantHits: number       // static 挂载点协商后返回 AVIF / WebP 兄弟文件的响应数
+    reapedRequests: number         // 超过 request_timeout_ms 未响应、被回收的请求数
+    leakedRoutes: LeakedRoute[]    // 被回收请求按路由的统计（最多 64 条，其余计入 '*'）
+    circuitBreakers: CircuitBreakerStats[]
+    lanes: LaneStats[]             // 桥接层各 lane（static / callback / fs / upload / compute）的状态
+    listeners: ListenerStats[]     // ServerConfig.listen 中各额外监听地址的状态
+}
+
+// 超时未响应、被回收的请求按路由的统计
+export interface LeakedRoute {
+    route: string                  // 'GET /api/items'（不含查询字符串）
+    stage: PendingRequestStage     // 最近一次回收时请求所处的阶段
+    count: number
+}
+
+export type CircuitState = 'closed' | 'open' | 'half_open'
+
+// 熔断器状态
+export interface CircuitBreakerStats {
+    path: string
+    state: CircuitState
+    opens: number                  // 打开的次数
+    shortCircuited: number         // 直接返回 fallback、未投递到 JS 的请求数
+    failures: number               // 记录到的失败总数（Promise 被拒绝或 5xx 响应）
+    msSinceStateChange: number
+}
+
+// 额外监听地址的状态（主监听地址由 Rust 处理，不在其中）
+export interface ListenerStats {
+    address: string                // 配置中的写法，如 '[::1]:8080'
+    acceptedConnections: number
+    activeConnections: number
+    failedConnections: number      // 转发到主监听地址失败的连接数
+    bytesReceived: number          // 客户端 → 服务器
+    bytesSent: number              // 服务器 → 客户端
+}
+
+// 桥接层工作线程池（lane）的状态
+export interface LaneStats {
+    name: string                   // 'static' | 'callback' | 'fs' | 'upload' | 'compute'
+    threads: number                // 当前线程数（随负载在 1 与 maxThreads 之间变化）
+    maxThreads: number
+    queueDepth: number             // 当前排队的任务数
+    maxQueueDepth: number          // 历史最大排队数
+    active: number                 // 正在执行任务的线程数
+    completed: number
+    queueWaitP99Ms: number         // 任务排队等待时间的 P99
+    wakeups: number                // 线程唤醒总次数
+    wakeupsPerSec: number          // 最近 10 秒内平均每秒的唤醒次数，空闲时为 0
+}
+
+// 调度延迟超过阈值时的事件
+export interface DispatchDelayEvent {
+    requestId: string
+    method: string
+    path: string
+    delayMs: number
+    queueDepth: number             // 此刻仍在排队等待 JS 的请求数
+}
+
+export type DispatchDelayHandler = (event: DispatchDelayEvent) => void
+
+// 流量抓取选项
+export interface TrafficCaptureOptions {
+    maxBodyBytes?: number          // 请求体不超过该长度时完整保存，否则只记录长度和哈希，默认 0
+    captureHeaders?: boolean       // 是否保存请求头，默认 true
+    redactHeaders?: boolean        // 是否清空 authorization / cookie 等敏感头的值，默认 true
+    maxFileBytes?: number          // 抓取文件大小上限，超过后丢弃后续请求，默认 64MB
+}
+
+// 流量抓取结果
+export interface TrafficCaptureSummary {
+    filePath: string
+    requests: number               // 已写入的请求数
+    responses: number              // 已写入的响应数
+    droppedRequests: number        // 因文件大小上限丢弃的请求数
+    bytesWritten: number
+    durationMs: number
+}
+
+// CORS 配置（预检请求由桥接层直接应答，不进入 JS）
+export interface CorsConfig {
+    origins?: string[]          // 允许的来源，支持 "*" 和 "https://*.example.com"，默认 ["*"]
+    methods?: string[]          // 默认 GET, HEAD, PUT, PATCH, POST, DELETE
+    allowed_headers?: string[]  // 未设置时回显预检请求中的 Access-Control-Request-Headers
+    exposed_headers?: string[]
+    credentials?: boolean       // 默认 false
+    max_age?: number            // 预检结果缓存时间（秒），默认 600
+}
+
+// SPA 回退配置：静态文件未命中的前端路由直接返回入口 HTML，不进入 JS
+// 最后一段带扩展名的路径（如 /assets/app.js）视为缺失的资源文件，不回退
+export interface SpaFallbackConfig {
+    index?: string              // 入口文件，相对于 root，默认 'index.html'
+    root?: string               // 默认使用 root_dir / AppServer 的 rootDir
+    prefixes?: string[]         // 只对这些路径前缀回退，默认所有路径
+    exclude_prefixes?: string[] // 始终交给 JS 的路径前缀，如 ['/api']
+    accept_html?: boolean       // 要求 Accept 包含 text/html，未设置 prefixes 时默认 true
+    cache_control?: string      // 默认 'no-cache'
+}
+
+// 桥接层文件探测配置（SPA 入口及桥接层挂载点）
+// Rust 核心对 root_dir 的静态文件探测不受此配置影响
+export interface StaticLookupConfig {
+    exclude_prefixes?: string[] // 跳过桥接层静态处理、直接交给 JS 的路径前缀，如 ['/api']
+    max_entries?: number        // 缓存条目上限，默认 4096
+    revalidate_ms?: number      // 缓存结果的重新检查间隔（毫秒），默认 1000
+}
+
+// JS 处理器的熔断器：window_ms 内失败（Promise 被拒绝或 5xx 响应）达到
+// failures 次后打开，cooldown_ms 内由桥接层直接返回 fallback 响应；之后半开，
+// 放行 half_open_probes 个探测请求，成功则关闭，失败则重新打开
+export interface CircuitBreakerConfig {
+    path?: string               // 仅用于 circuit_breakers 列表；挂载点上的熔断器使用挂载点路径
+    failures?: number           // 默认 5
+    window_ms?: number          // 默认 10000
+    cooldown_ms?: number        // 默认 30000
+    half_open_probes?: number   // 默认 1
+    fallback?: CircuitBreakerFallback
+}
+
+// 熔断器打开时由桥接层返回的响应
+export interface CircuitBreakerFallback {
+    status?: number             // 默认 503
+    headers?: Record<string, string>  // 默认带 Content-Type: text/plain 和 Retry-After
+    body?: string               // 默认 'Service Unavailable'
+}
+
+// 请求体解压：Content-Encoding 为 gzip / deflate 的请求体由桥接层解压后
+// 交给 JS（含 readRequestBodyChunk 分块读取），超过限制时拒绝
+export interface RequestDecompressionConfig {
+    max_bytes?: number          // 解压后的最大字节数，默认 33554432（32MB）
+    max_ratio?: number          // 解压后与压缩前的最大倍数（超过 1MB 后检查），默认 100
+}
+
 // 基础挂载接口
 interface BaseMount {
     path: string
+    cors?: CorsConfig | boolean  // 覆盖全局 cors（仅对进入 JS 处理器的请求生效）
+    circuit_breaker?: CircuitBreakerConfig  // 该挂载点下 JS 处理器的熔断器
 }
 
 // WebDAV 挂载
@@ -52,12 +258,33 @@ export interface DirListConfig {
     show_hidden?: boolean
 }
 
+// 图片格式协商：photo.jpg 请求按 Accept 返回同目录下的 photo.avif / photo.webp
+export interface ImageVariantsConfig {
+    formats?: string[]     // 候选格式，按优先级排列（默认 ['avif', 'webp']）
+    extensions?: string[]  // 参与协商的原图扩展名（默认 ['jpg', 'jpeg', 'png']）
+}
+
+// 静态文件缓存规则：路径匹配 match（glob）或 regex 时追加缓存响应头
+// 按顺序取第一条匹配的规则；不含 / 的 glob 只匹配文件名
+export interface CacheRule {
+    match?: string | string[]  // glob，支持 * ** ? [a-f] {js,css}，如 '*.[0-9a-f]*.js'
+    regex?: string             // 匹配挂载点内的路径（以 / 开头），如 '^/assets/'
+    cache_control?: string     // 原样写入 Cache-Control（优先于 max_age）
+    max_age?: number           // 秒；生成 'public, max-age=N' 和对应的 Expires
+    immutable?: boolean        // 追加 immutable；未给出 max_age 时有效期为一年
+    expires?: number           // Expires 距响应时间的秒数（默认同 max_age）
+}
+
 // 静态文件挂载
 export interface StaticMount extends BaseMount {
     type: 'static'
     root: string
     dir_list?: DirListConfig
     default_index?: string[]
+    // 开启 image_variants 或 cache_rules 后该挂载点改由桥接层提供
+    // （与 dir_list 不兼容），未命中的请求交给 JS
+    image_variants?: boolean | ImageVariantsConfig
+    cache_rules?: CacheRule[]
 }
 
 // 上传插件挂载
@@ -89,7 +316,53 @@ export interface WebSocketMount extends BaseMount {
     max_message_size?: number  // 最大消息大小（字节），默认 64MB
 }
 
-export type Mountable = WebDavMount | ZipMount | StaticMount | UploadMount | BufferUploadMount | RewriteMount | WebSocketMount
+// 响应缓存挂载（由桥接层处理）：JS 返回的带 Cache-Control: max-age / s-maxage 的
+// GET 响应写入磁盘，有效期内由原生层直接应答，应用重启后仍然有效
+export interface CacheMount extends BaseMount {
+    type: 'cache'
+    dir: string                // 缓存目录
+    max_bytes?: number         // 总大小上限，超过后按 LRU 淘汰，默认 64MB
+    max_entries?: number       // 条目数上限，默认 4096
+    max_entry_bytes?: number   // 单个响应的大小上限，默认 8MB
+}
+
+// 内存文件挂载（由桥接层处理）：内容通过 memPut 写入，按路径直接应答
+// 写入时预先计算 ETag 和 gzip 版本，支持 Range 和条件请求
+export interface MemoryMount extends BaseMount {
+    type: 'memory'
+    max_bytes?: number         // memPut 内容的总大小上限，默认 64MB
+    fallthrough?: boolean      // 未命中时交给 JS，默认 true；false 时返回 404
+}
+
+// 静态资源包挂载（由桥接层处理）：rn-http-bundle 生成的只读包，整体内存映射
+// 响应头、ETag 和 gzip 版本在打包时已生成，请求时不再读文件或压缩
+export interface BundleMount extends BaseMount {
+    type: 'bundle'
+    file: string               // 资源包文件路径
+    fallthrough?: boolean      // 未命中时交给 JS，默认 true；false 时返回 404
+}
+
+export type Mountable = WebDavMount | ZipMount | StaticMount | UploadMount | BufferUploadMount | RewriteMount | WebSocketMount | CacheMount | MemoryMount | BundleMount
+
+// 桥接层读取文件（cache 条目、SPA 入口等）的后端
+// 'io_uring' 仅在 Linux（不含 Android）上可用，不可用时自动退回 'posix'（pread）
+export type FileIoBackend = 'posix' | 'io_uring'
+
+// 桥接层各 lane 的线程数上限（默认各 4，范围 1–64）
+// 每个 lane 从 1 个线程开始，排队任务多于空闲线程时增加，多出的线程空闲
+// idle_ms 后退出；空闲时只保留一个无限期等待的线程，不产生定时唤醒
+// static：桥接层直接应答、需要读文件的 GET/HEAD（bundle、cache、SPA 回退）
+// callback：JS 处理器的响应调用（writeResponseChunk、endResponse 等）
+// fs：阻塞的文件操作（写入响应缓存、memPut、流量抓取、fs polyfill 读文件）
+// upload：读取上传请求体，慢客户端不挡住 fs 上的文件操作
+export interface LaneConfig {
+    static?: number
+    callback?: number
+    fs?: number
+    upload?: number
+    compute?: number
+    idle_ms?: number            // 多出线程的空闲超时（毫秒），默认 10000
+}
 
 // 服务器插件配置
 export interface ServerConfig {
@@ -97,6 +370,30 @@ export interface ServerConfig {
     verbose?: boolean | 'off' | 'error' | 'warn' | 'info' | 'debug'  // 日志等级
     mime_types?: Record<string, string>     // 自定义 MIME types
     mounts?: Mountable[]                    // 统一挂载列表
+    cors?: CorsConfig | boolean             // 全局 CORS 策略，true 表示使用默认值
+    spa_fallback?: SpaFallbackConfig | boolean  // SPA 回退，true 表示使用默认值
+    static_lookup?: StaticLookupConfig      // 桥接层文件探测缓存
+    file_io?: FileIoBackend                 // 桥接层读取文件的方式，默认 'posix'
+    lanes?: LaneConfig                      // 桥接层各 lane 的线程数
+    request_timeout_ms?: number             // 未响应请求的回收超时，默认 300000，0 表示不回收
+    circuit_breakers?: CircuitBreakerConfig[]  // 按路径前缀的熔断器（最长前缀优先）
+    request_decompression?: RequestDecompressionConfig | boolean  // 解压请求体，true 表示使用默认值
+    // 额外监听地址，如 ['[::1]:8080', '192.168.1.5:8080', 'unix:/path/to/socket']
+    // 由桥接层转发到 start() 的 host:port，共用同一个服务器和挂载表
+    listen?: string[]
+}
+
+// AppServer 的桥接层选项
+export interface AppServerOptions {
+    cors?: CorsConfig | boolean
+    spa_fallback?: SpaFallbackConfig | boolean
+    static_lookup?: StaticLookupConfig
+    file_io?: FileIoBackend
+    lanes?: LaneConfig
+    request_timeout_ms?: number
+    circuit_breakers?: CircuitBreakerConfig[]
+    request_decompression?: RequestDecompressionConfig | boolean
+    listen?: string[]
 }
 
 // WebSocket 事件类型
@@ -161,6 +458,69 @@ export interface HttpServer extends HybridObject<{
      */
     isRunning(): Promise<boolean>
 
+    /**
+     * 获取当前活跃连接和待处理请求的快照（用于排查卡住的处理器）
+     * @returns 活动快照
+     */
+    getActivity(): Promise<ServerActivity>
+
+    /**
+     * 标记 JS 处理器开始执行（由 JS 包装层在处理器入口同步调用）
+     * @param requestId 请求 ID
+     */
+    markHandlerStart(requestId: string): void
+
+    /**
+     * 设置调度延迟告警：处理器开始执行时若等待超过阈值，则在 JS 线程上回调
+     * @param thresholdMs 阈值（毫秒）
+     * @param handler 回调，不传则关闭告警
+     */
+    setDispatchDelayThreshold(thresholdMs: number, handler?: DispatchDelayHandler): void
+
+    /**
+     * 获取桥接层统计信息（调度延迟直方图、JS 队列深度等）
+     * @returns 统计信息
+     */
+    getBridgeStats(): Promise<BridgeStats>
+
+    /**
+     * 开始抓取进入 JS 回调的请求（时间、方法、路径、请求头、请求体或其哈希）及响应结果
+     * 抓取文件可用 tools/replay 回放
+     * @param filePath 抓取文件路径（会被覆盖）
+     * @param options 抓取选项
+     * @returns 是否开始抓取（已在抓取时返回 false）
+     */
+    startTrafficCapture(filePath: string, options?: TrafficCaptureOptions): Promise<boolean>
+
+    /**
+     * 停止抓取并关闭文件
+     * @returns 抓取结果
+     */
+    stopTrafficCapture(): Promise<TrafficCaptureSummary>
+
+    /**
+     * 清除 cache 挂载点中的响应
+     * @param pathPrefix 只清除该路径前缀下的响应（按路径段匹配，'/a' 不包含 '/ab'），
+     *                   不传则清除全部
+     * @returns 清除的条目数
+     */
+    purgeResponseCache(pathPrefix?: string): Promise<number>
+
+    /**
+     * 写入（覆盖）memory 挂载点中的文件
+     * @param path 完整请求路径，如 '/generated/config.json'
+     * @param data 文件内容
+     * @param headers 响应头，未给出 Content-Type 时按扩展名推断
+     * @returns 是否写入成功（超过 max_bytes 时返回 false）
+     */
+    memPut(path: string, data: ArrayBuffer, headers?: Record<string, string>): Promise<boolean>
+
+    /**
+     * 删除 memory 挂载点中的文件
+     * @returns 文件是否存在
+     */
+    memDelete(path: string): boolean
+
     /**
      * 启动静态文件服务器
      * @param port 端口号
@@ -191,24 +551,48 @@ export interface HttpServer extends HybridObject<{
     writeResponseChunk(requestId: string, chunk: string): Promise<boolean>
 
     /**
-     * 结束响应
+     * 提前提交状态码和响应头（之后不可再修改），后续仍通过 writeResponseChunk / endResponse 完成响应
+     * 若响应头声明了 Content-Length，响应体写满该长度时桥接层立即发出响应，不必等待 endResponse
+     * 注意：Rust 核心在 end_response 时才发出响应头，因此提交的响应头不会早于响应体到达客户端
      * @param requestId 请求 ID
      * @param statusCode HTTP 状态码
-     * @param headersJson 响应头 JSON 字符串
+     * @param headers 响应头
+     * @returns 是否提交成功（已提交过或请求不存在时返回 false）
+     */
+    beginResponse(requestId: string, statusCode: number, headers: string | ResponseHeaders): Promise<boolean>
+
+    /**
+     * 结束响应（已调用 beginResponse 时使用当时提交的状态码和响应头）
+     * @param requestId 请求 ID
+     * @param statusCode HTTP 状态码
+     * @param headers 响应头（推荐直接传对象，由原生层转换；也兼容旧的 JSON 字符串）
      * @returns 是否成功
      */
-    endResponse(requestId: string, statusCode: number, headersJson: string): Promise<boolean>
+    endResponse(requestId: string, statusCode: number, headers: string | ResponseHeaders): Promise<boolean>
 
     /**
      * 写入二进制响应体并发送响应（同步复制数据）
      * 此方法在 JS 线程上安全地复制 ArrayBuffer 数据，避免跨线程访问问题
      * @param requestId 请求 ID
      * @param statusCode HTTP 状态码
-     * @param headersJson 响应头 JSON 字符串
+     * @param headers 响应头（推荐直接传对象，由原生层转换；也兼容旧的 JSON 字符串）
      * @param body 二进制响应体
      * @returns 是否成功
      */
-    sendBinaryResponse(requestId: string, statusCode: number, headersJson: string, body: ArrayBuffer): Promise<boolean>
+    sendBinaryResponse(requestId: string, statusCode: number, headers: string | ResponseHeaders, body: ArrayBuffer): Promise<boolean>
+
+    /**
+     * 以已打开文件（或其中一段）作为响应体发送，数据在 fs lane 上读取，不经过 JS
+     * 不超过 1MB 时一次发送，更大的文件分块写入
+     * @param requestId 请求 ID
+     * @param statusCode HTTP 状态码
+     * @param headers 响应头
+     * @param file FileSystem.open 打开的文件
+     * @param start 起始偏移（默认 0）
+     * @param end 结束偏移，包含该字节（与 fs.createReadStream 相同，默认到文件末尾）
+     * @returns 是否成功；读取文件出错时由桥接层结束响应（尚未发送数据时返回 500）并拒绝
+     */
+    sendFileResponse(requestId: string, statusCode: number, headers: string | ResponseHeaders, file: FileHandle, start?: number, end?: number): Promise<boolean>
 
     /**
      * 启动App HTTP服务器（混合静态文件和回调）
@@ -216,9 +600,10 @@ export interface HttpServer extends HybridObject<{
      * @param rootDir 静态文件根目录路径
      * @param handler 请求处理器
      * @param host 监听的IP地址,默认为 127.0.0.1
+     * @param configJson AppServerOptions JSON 字符串（SPA 回退、CORS）
      * @returns 是否启动成功
      */
-    startAppServer(port: number, rootDir: string, handler: RequestHandler, host?: string): Promise<boolean>
+    startAppServer(port: number, rootDir: string, handler: RequestHandler, host?: string, configJson?: string): Promise<boolean>
 
     /**
      * 停止App HTTP服务器
@@ -0,0 +1,50 @@
+// src/Zlib.nitro.ts
+import { type HybridObject } from 'react-native-nitro-modules'
+
+// 与 Node zlib 的 options 同名同默认值
+export interface ZlibOptions {
+    level?: number              // 默认 -1（Z_DEFAULT_COMPRESSION）
+    windowBits?: number         // 8 - 15，默认 15
+    memLevel?: number           // 1 - 9，默认 8
+    strategy?: number           // 默认 0（Z_DEFAULT_STRATEGY）
+}
+
+// 一个压缩或解压流（由 Zlib.createStream 创建）
+// 同一个流的 write / writeSync 需要串行调用，上一次完成后再调用下一次
+export interface ZlibStream extends HybridObject<{
+    ios: 'c++',
+    android: 'c++'
+}> {
+    readonly mode: string
+
+    /**
+     * 在桥接层的 compute lane 上处理一段数据，不阻塞 JS 线程
+     * @param chunk 输入数据（调用时复制）
+     * @param flush zlib 的 flush 标志，如 Z_NO_FLUSH(0)、Z_SYNC_FLUSH(2)、Z_FINISH(4)
+     * @returns 这次产生的输出
+     */
+    write(chunk: ArrayBuffer, flush: number): Promise<ArrayBuffer>
+
+    /**
+     * 同 write，但在 JS 线程上同步执行（用于 deflateSync 等）
+     */
+    writeSync(chunk: ArrayBuffer, flush: number): ArrayBuffer
+
+    /**
+     * 回到初始状态，参数不变
+     */
+    reset(): void
+}
+
+// 原生 zlib：deflate / inflate、gzip / gunzip、deflateRaw / inflateRaw、unzip
+export interface Zlib extends HybridObject<{
+    ios: 'c++',
+    android: 'c++'
+}> {
+    /**
+     * 创建压缩或解压流
+     * @param mode 'deflate' | 'inflate' | 'gzip' | 'gunzip' | 'deflateRaw' | 'inflateRaw' | 'unzip'
+     * @param options zlib 参数
+     */
+    createStream(mode: string, options?: ZlibOptions): ZlibStream
+}
@@ -3,7 +3,8 @@
 
 import { EventEmitter } from 'eventemitter3';
 import { NitroModules } from 'react-native-nitro-modules';
-import type { HttpServer as NitroHttpServer, HttpRequest, HttpResponse } from './HttpServer.nitro';
+import type { HttpServer as NitroHttpServer, HttpRequest, HttpResponse, ResponseHeaders } from './HttpServer.nitro';
+import type { FileHandle } from './FileSystem.nitro';
 
 // ========== Types ==========
 
@@ -23,6 +24,10 @@ interface AddressInfo {
     port: number;
 }
 
+// The fs polyfill's ReadStream looks this method up on the pipe destination to
+// hand the file to the native send path (see polyfills/fs.js)
+const kSendFile = Symbol.for('react-native-nitro-http-server.sendFile');
+
 // ========== STATUS_CODES ==========
 
 export const STATUS_CODES: Record<number, string> = {
@@ -231,6 +236,26 @@ export class IncomingMessage extends EventEmitter {
 
 // ========== ServerResponse ==========
 
+// Buffered writes are flushed immediately once they reach this many UTF-8
+// bytes, otherwise at the end of the current tick
+const WRITE_COALESCE_THRESHOLD = 16 * 1024;
+
+// The Rust core keeps one value per header name and Set-Cookie cannot be
+// comma-joined, so only the last of several cookies reaches the client.
+// Warn the first time a response sets more than one
+let warnedMultipleSetCookie = false;
+
+function warnMultipleSetCookie(count: number): void {
+    if (warnedMultipleSetCookie) {
+        return;
+    }
+    warnedMultipleSetCookie = true;
+    console.warn(
+        `[http] Set-Cookie was given ${count} values; only the last one is sent ` +
+        'because the native server keeps one value per header. Set one cookie per response.'
+    );
+}
+
 /**
  * Node.js compatible ServerResponse implementation
  * Implements a subset of http.ServerResponse interface
@@ -250,6 +275,17 @@ export class ServerResponse extends EventEmitter {
     private _finished: boolean = false;
     private _resolveNativeRequest: (response: HttpResponse) => void;
 
+    // Write coalescing: small writes are buffered and sent to native in one call
+    private _pendingChunks: string[] = [];
+    private _pendingBytes: number = 0;
+    private _pendingCallbacks: (() => void)[] = [];
+    private _corked: number = 0;
+    private _flushScheduled: boolean = false;
+    private _headCommitted: boolean = false;
+    private _bodyWritten: boolean = false;
+    // Native writes are chained so chunks reach native in order
+    private _writeChain: Promise<void> = Promise.resolve();
+
     // Writable stream
     writable: boolean = true;
     writableEnded: boolean = false;
@@ -273,7 +309,11 @@ export class ServerResponse extends EventEmitter {
         if (this.headersSent) {
             throw new Error('Cannot set headers after they are sent');
         }
-        this._headers.set(name.toLowerCase(), value);
+        const key = name.toLowerCase();
+        if (key === 'set-cookie' && Array.isArray(value) && value.length > 1) {
+            warnMultipleSetCookie(value.length);
+        }
+        this._headers.set(key, value);
         return this;
     }
 
@@ -385,17 +425,64 @@ export class ServerResponse extends EventEmitter {
 
         // Mark headers as sent conceptually (though we send them at the end internally)
         this.headersSent = true;
+        this._bodyWritten = true;
+
+        // Buffer the chunk; it is sent together with other writes of this tick
+        this._pendingChunks.push(strChunk);
+        // UTF-8 bytes, as sent to native; string length counts UTF-16 units
+        this._pendingBytes += Buffer.byteLength(strChunk, 'utf8');
+        if (cb) this._pendingCallbacks.push(cb);
+
+        if (this._corked === 0) {
+            if (this._pendingBytes >= WRITE_COALESCE_THRESHOLD) {
+                this._flushWrites();
+            } else {
+                this._scheduleFlush();
+            }
+        }
+
+        return true;
+    }
+
+    private _scheduleFlush(): void {
+        if (this._flushScheduled) {
+            return;
+        }
+        this._flushScheduled = true;
+        Promise.resolve().then(() => {
+            this._flushScheduled = false;
+            if (this._corked === 0) {
+                this._flushWrites();
+            }
+        });
+    }
 
-        // Perform async write to native layer
-        this._nativeServer.writeResponseChunk(this._requestId, strChunk)
+    /**
+     * Sends all buffered chunks to native as a single writeResponseChunk call.
+     * Returns a promise that settles once every write issued so far is done.
+     */
+    private _flushWrites(): Promise<void> {
+        if (this._pendingChunks.length === 0) {
+            return this._writeChain;
+        }
+
+        const data = this._pendingChunks.length === 1
+            ? this._pendingChunks[0]
+            : this._pendingChunks.join('');
+        const callbacks = this._pendingCallbacks;
+        this._pendingChunks = [];
+        this._pendingBytes = 0;
+        this._pendingCallbacks = [];
+
+        this._writeChain = this._writeChain
+            .then(() => data.length > 0 ? this._nativeServer.writeResponseChunk(this._requestId, data) : true)
             .then(() => {
-                if (cb) cb();
+                for (const cb of callbacks) cb();
             })
             .catch(err => {
                 this.emit('error', err);
             });
-
-        return true;
+        return this._writeChain;
     }
 
     // Flag to track ended state
@@ -442,28 +529,19 @@ export class ServerResponse extends EventEmitter {
                     : chunk.buffer.slice(chunk.byteOffset, chunk.byteOffset + chunk.byteLength);
 
             // Use internal binary response path
-            // Collect headers
-            const headers: Record<string, string> = {};
-            for (const [key, value] of this._headers) {
-                if (Array.isArray(value)) {
-                    headers[key] = value.join(', ');
-                } else {
-                    headers[key] = String(value);
-                }
-            }
+            const headers = this._collectHeaders();
 
-            const headersJson = JSON.stringify(headers);
-
-            this._nativeServer.sendBinaryResponse(this._requestId, this.statusCode, headersJson, buffer as ArrayBuffer)
+            this._corked = 0;
+            this._flushWrites()
+                .then(() => this._nativeServer.sendBinaryResponse(this._requestId, this.statusCode, headers, buffer as ArrayBuffer))
                 .then(() => {
                     this._finished = true;
                     this.writableFinished = true;
                     this.emit('finish');
 
-                    // Resolve the native request promise
+                    // Resolve the native request promise (headers were already sent natively)
                     this._resolveNativeRequest({
                         statusCode: this.statusCode,
-                        headers: headers,
                         body: ''
                     });
 
@@ -480,20 +558,15 @@ export class ServerResponse extends EventEmitter {
             return this;
         }
 
-        // Write final chunk if provided (String legacy path)
+        // Append the final chunk to any buffered writes (String legacy path),
+        // flush them in one native call, then end the response
         if (chunk !== undefined) {
-            // We can't use write() here directly because we want to sequence it with endResponse
-            // But write() is fire-and-forget.
-            // Ideally we should wait, but the node API is sync.
-            // We'll call native writeResponseChunk then endResponse.
-
-            let strChunk = Buffer.isBuffer(chunk) ? chunk.toString(encoding) : String(chunk);
-            this._nativeServer.writeResponseChunk(this._requestId, strChunk)
-                .then(() => this._finalizeResponse(cb))
-                .catch(err => this.emit('error', err));
-        } else {
-            this._finalizeResponse(cb);
+            const strChunk = Buffer.isBuffer(chunk) ? chunk.toString(encoding) : String(chunk);
+            this._pendingChunks.push(strChunk);
+            this._pendingBytes += Buffer.byteLength(strChunk, 'utf8');
         }
+        this._corked = 0;
+        this._flushWrites().then(() => this._finalizeResponse(cb));
 
         this._ended = true;
         this.writableEnded = true;
@@ -503,20 +576,76 @@ export class ServerResponse extends EventEmitter {
         return this;
     }
 
-    private _finalizeResponse(cb?: () => void) {
-        // Collect headers
-        const headers: Record<string, string> = {};
+    /**
+     * Sends an open native file (or the inclusive byte range start..end of it)
+     * as the body and ends the response. The file is read and sent natively,
+     * so its bytes never enter JS. Returns false without doing anything once
+     * body data has been written; the caller then streams the file instead.
+     */
+    [kSendFile](file: FileHandle, start: number | undefined, end: number | undefined, callback: (err?: Error) => void): boolean {
+        if (this._ended || this._bodyWritten) {
+            return false;
+        }
+
+        const headers = this._collectHeaders();
+
+        this._corked = 0;
+        this._flushWrites()
+            .then(() => this._nativeServer.sendFileResponse(this._requestId, this.statusCode, headers, file, start, end))
+            .then(() => {
+                this._finished = true;
+                this.writableFinished = true;
+                this.emit('finish');
+
+                // Resolve the native request promise (the response was sent natively)
+                this._resolveNativeRequest({
+                    statusCode: this.statusCode,
+                    body: ''
+                });
+
+                callback();
+            })
+            .catch((err) => {
+                // Settle the handler promise so it does not stay pending. The
+                // bridge usually answered 500 already and ignores this; if it
+                // failed before that, this 500 is what the client gets
+                this._resolveNativeRequest({
+                    statusCode: 500,
+                    body: ''
+                });
+
+                callback(err);
+                this.emit('error', err);
+            });
+
+        this._ended = true;
+        this.writableEnded = true;
+        this.headersSent = true;
+        this.writable = false;
+        return true;
+    }
+
+    /**
+     * Collects headers for the native layer. Multi-value headers stay arrays; the
+     * bridge joins them with commas because the Rust core keeps one value per
+     * header name. Set-Cookie cannot be joined, so only its last value is sent.
+     */
+    private _collectHeaders(): ResponseHeaders {
+        const headers: ResponseHeaders = {};
         for (const [key, value] of this._headers) {
             if (Array.isArray(value)) {
-                headers[key] = value.join(', ');
+                headers[key] = value.map(String);
             } else {
                 headers[key] = String(value);
             }
         }
+        return headers;
+    }
 
-        const headersJson = JSON.stringify(headers);
+    private _finalizeResponse(cb?: () => void) {
+        const headers = this._collectHeaders();
 
-        this._nativeServer.endResponse(this._requestId, this.statusCode, headersJson)
+        this._nativeServer.endResponse(this._requestId, this.statusCode, headers)
             .then(() => {
                 this._finished = true;
                 this.writableFinished = true;
@@ -526,8 +655,7 @@ export class ServerResponse extends EventEmitter {
                 // We send a dummy response because we handled it via streaming
                 this._resolveNativeRequest({
                     statusCode: this.statusCode,
-                    headers: headers,
-                    body: '' // Body handled via streaming
+                    body: '' // Body and headers handled via streaming
                 });
 
                 if (cb) cb();
@@ -538,17 +666,51 @@ export class ServerResponse extends EventEmitter {
     }
 
     /**
-     * Flushes headers (no-op in our implementation)
+     * Commits status and headers to the native layer. They can no longer be
+     * changed; body chunks written afterwards follow them. If Content-Length
+     * is set, the response is handed off as soon as that many bytes are written.
      */
     flushHeaders(): void {
+        if (this._headCommitted || this._ended) {
+            return;
+        }
+        this._headCommitted = true;
         this.headersSent = true;
+
+        // Queued on the write chain so the head reaches native before any later chunk
+        const statusCode = this.statusCode;
+        const headers = this._collectHeaders();
+        this._writeChain = this._writeChain
+            .then(() => this._nativeServer.beginResponse(this._requestId, statusCode, headers))
+            .then(() => undefined)
+            .catch(err => {
+                this.emit('error', err);
+            });
+    }
+
+    /**
+     * Buffers all writes until a matching uncork() (or end()).
+     */
+    cork(): void {
+        this._corked++;
     }
 
     /**
-     * Cork/Uncork (no-op in our implementation)
+     * Sends writes buffered since the first cork() once every cork() is matched.
      */
-    cork(): void { }
-    uncork(): void { }
+    uncork(): void {
+        if (this._corked === 0) {
+            return;
+        }
+        this._corked--;
+        if (this._corked === 0) {
+            this._flushWrites();
+        }
+    }
+
+    get writableCorked(): number {
+        return this._corked;
+    }
 
     get finished(): boolean {
         return this._finished;
@@ -691,6 +853,7 @@ export class Server extends EventEmitter {
      * Handle incoming request from native layer
      */
     private _handleNativeRequest(request: HttpRequest): HttpResponse | Promise<HttpResponse> {
+        this._nativeServer.markHandlerStart(request.requestId);
         return new Promise((resolve) => {
             // Create Node.js compatible request/response objects
             // Pass the native server instance for streaming data access
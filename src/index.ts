@@ -1,5 +1,5 @@
 import { NitroModules } from 'react-native-nitro-modules'
-import type { HttpServer as NitroHttpServer, HttpRequest, HttpResponse as NitroHttpResponse, ServerConfig } from './HttpServer.nitro'
+import type { HttpServer as NitroHttpServer, HttpRequest, HttpResponse as NitroHttpResponse, ServerConfig, AppServerOptions, ServerActivity, BridgeStats, DispatchDelayHandler, TrafficCaptureOptions, TrafficCaptureSummary } from './HttpServer.nitro'
 import { createServer } from 'http'
 
 // Redefine HttpResponse for User (User sees unified body)
@@ -16,6 +16,7 @@ const HttpServerModule = NitroModules.createHybridObject<NitroHttpServer>("HttpS
 // Helper function to wrap handler and intercept binary body
 const wrapHandler = (handler: RequestHandler): (request: HttpRequest) => Promise<NitroHttpResponse> => {
   return async (request: HttpRequest) => {
+    HttpServerModule.markHandlerStart(request.requestId)
     const response = await handler(request)
 
     // If response body is binary (ArrayBuffer or View), send it safely via the direct API
@@ -29,13 +30,12 @@ const wrapHandler = (handler: RequestHandler): (request: HttpRequest) => Promise
           ? binaryBody.buffer
           : binaryBody.buffer.slice(binaryBody.byteOffset, binaryBody.byteOffset + binaryBody.byteLength);
 
-      const headers = response.headers || {}
-      const headersJson = JSON.stringify(headers)
       // Use the safe native method that copies data on JS thread
+      // (headers are converted natively, no JSON round-trip)
       await HttpServerModule.sendBinaryResponse(
         request.requestId,
         response.statusCode,
-        headersJson,
+        response.headers || {},
         buffer as ArrayBuffer
       )
       // Return a dummy response to satisfy the native promise
@@ -77,6 +77,11 @@ export class HttpServer {
     return await HttpServerModule.getStats()
   }
 
+  /** 获取活跃连接和待处理请求快照 */
+  async getActivity(): Promise<ServerActivity> {
+    return await HttpServerModule.getActivity()
+  }
+
   isRunning(): boolean {
     return this._isRunning
   }
@@ -112,13 +117,14 @@ export class StaticServer {
 export class AppServer {
   private _isRunning = false
 
-  async start(port: number, rootDir: string, handler: RequestHandler, host?: string): Promise<boolean> {
+  async start(port: number, rootDir: string, handler: RequestHandler, host?: string, options?: AppServerOptions): Promise<boolean> {
     if (this._isRunning) {
       throw new Error('App server is already running')
     }
 
     const wrappedHandler = wrapHandler(handler)
-    const success = await HttpServerModule.startAppServer(port, rootDir, wrappedHandler, host)
+    const configJson = options ? JSON.stringify(options) : undefined
+    const success = await HttpServerModule.startAppServer(port, rootDir, wrappedHandler, host, configJson)
     this._isRunning = success
     return success
   }
@@ -133,6 +139,11 @@ export class AppServer {
   isRunning(): boolean {
     return this._isRunning
   }
+
+  /** 获取活跃连接和待处理请求快照 */
+  async getActivity(): Promise<ServerActivity> {
+    return await HttpServerModule.getActivity()
+  }
 }
 
 // WebSocket 连接请求信息（包含握手信息）
@@ -263,6 +274,76 @@ export class ConfigServer {
   isRunning(): boolean {
     return this._isRunning
   }
+
+  /** 获取活跃连接和待处理请求快照 */
+  async getActivity(): Promise<ServerActivity> {
+    return await HttpServerModule.getActivity()
+  }
+}
+
+/**
+ * 获取桥接层统计信息（JS 调度延迟直方图、当前 JS 队列深度）
+ */
+export async function getBridgeStats(): Promise<BridgeStats> {
+  return await HttpServerModule.getBridgeStats()
+}
+
+/**
+ * 当请求从进入桥接层到 JS 处理器开始执行的等待超过阈值时回调
+ * @param thresholdMs 阈值（毫秒）
+ * @param handler 回调（在 JS 线程上执行），不传则关闭
+ */
+export function setDispatchDelayThreshold(thresholdMs: number, handler?: DispatchDelayHandler): void {
+  HttpServerModule.setDispatchDelayThreshold(thresholdMs, handler)
+}
+
+/**
+ * 开始抓取进入 JS 回调的流量，抓取文件可用 tools/replay 在主机上回放
+ * @param filePath 抓取文件路径（会被覆盖）
+ * @param options 抓取选项
+ */
+export async function startTrafficCapture(filePath: string, options?: TrafficCaptureOptions): Promise<boolean> {
+  return await HttpServerModule.startTrafficCapture(filePath, options)
+}
+
+/**
+ * 停止流量抓取
+ */
+export async function stopTrafficCapture(): Promise<TrafficCaptureSummary> {
+  return await HttpServerModule.stopTrafficCapture()
+}
+
+/**
+ * 清除 cache 挂载点中的响应
+ * @param pathPrefix 只清除该路径前缀下的响应，不传则清除全部
+ * @returns 清除的条目数
+ */
+export async function purgeResponseCache(pathPrefix?: string): Promise<number> {
+  return await HttpServerModule.purgeResponseCache(pathPrefix)
+}
+
+/**
+ * 写入（覆盖）memory 挂载点中的文件，之后对该路径的请求由原生层直接应答
+ * @param path 完整请求路径，如 '/generated/config.json'
+ * @param data 文件内容（字符串按 UTF-8 编码）
+ * @param headers 响应头，未给出 Content-Type 时按扩展名推断
+ */
+export async function memPut(path: string, data: ArrayBuffer | string, headers?: Record<string, string>): Promise<boolean> {
+  let buffer: ArrayBuffer
+  if (typeof data === 'string') {
+    const bytes = new TextEncoder().encode(data)
+    buffer = bytes.buffer.slice(bytes.byteOffset, bytes.byteOffset + bytes.byteLength) as ArrayBuffer
+  } else {
+    buffer = data
+  }
+  return await HttpServerModule.memPut(path, buffer, headers)
+}
+
+/**
+ * 删除 memory 挂载点中的文件
+ */
+export function memDelete(path: string): boolean {
+  return HttpServerModule.memDelete(path)
 }
 
 /**
@@ -295,10 +376,11 @@ export async function createStaticServer(port: number, rootDir: string, host?: s
  * @param rootDir 静态文件根目录路径
  * @param handler 请求处理器
  * @param host 监听的IP地址
+ * @param options 桥接层选项（SPA 回退、CORS）
  */
-export async function createAppServer(port: number, rootDir: string, handler: RequestHandler, host?: string): Promise<AppServer> {
+export async function createAppServer(port: number, rootDir: string, handler: RequestHandler, host?: string, options?: AppServerOptions): Promise<AppServer> {
   const server = new AppServer()
-  await server.start(port, rootDir, handler, host)
+  await server.start(port, rootDir, handler, host, options)
   return server
 }
 
@@ -316,7 +398,11 @@ export async function createConfigServer(port: number, handler: RequestHandler,
 }
 
 // 导出类型和实例
-export type { HttpRequest, ServerConfig, DirListConfig, Mountable, WebDavMount, ZipMount, StaticMount, UploadMount, BufferUploadMount, RewriteMount, RewriteRule, WebSocketMount, WebSocketEvent, WebSocketEventType, WebSocketHandler } from './HttpServer.nitro'
+export type { HttpRequest, ServerConfig, DirListConfig, Mountable, WebDavMount, ZipMount, StaticMount, ImageVariantsConfig, CacheRule, UploadMount, BufferUploadMount, RewriteMount, RewriteRule, WebSocketMount, CacheMount, MemoryMount, BundleMount, FileIoBackend, LaneConfig, WebSocketEvent, WebSocketEventType, WebSocketHandler, ServerActivity, ConnectionInfo, PendingRequestInfo, PendingRequestStage, BridgeStats, LaneStats, ListenerStats, LeakedRoute, CircuitBreakerConfig, CircuitBreakerFallback, CircuitBreakerStats, CircuitState, RequestDecompressionConfig, CorsConfig, SpaFallbackConfig, StaticLookupConfig, AppServerOptions, LatencyBucket, DispatchDelayEvent, DispatchDelayHandler, ResponseHeaders, TrafficCaptureOptions, TrafficCaptureSummary } from './HttpServer.nitro'
+
+export type { Crypto, HashContext } from './Crypto.nitro'
+export type { Zlib, ZlibStream, ZlibOptions } from './Zlib.nitro'
+export type { FileSystem, FileHandle, FileStats } from './FileSystem.nitro'
 
 export { HttpServerModule }
 
@@ -456,4 +542,4 @@ export * from './http'
 export { createServer, Server, IncomingMessage, ServerResponse, STATUS_CODES, METHODS } from './http'
 
 import { Server, IncomingMessage, ServerResponse, STATUS_CODES, METHODS } from './http'
-export default { createHttpServer, createStaticServer, createAppServer, createConfigServer, HttpServer, StaticServer, AppServer, ConfigServer, createServer, Server, IncomingMessage, ServerResponse, STATUS_CODES, METHODS, ServerWebSocket, setupWebSocketHandler, getWebSocketConnections, getWebSocket }
\ No newline at end of file
+export default { createHttpServer, createStaticServer, createAppServer, createConfigServer, getBridgeStats, setDispatchDelayThreshold, startTrafficCapture, stopTrafficCapture, purgeResponseCache, memPut, memDelete, HttpServer, StaticServer, AppServer, ConfigServer, createServer, Server, IncomingMessage, ServerResponse, STATUS_CODES, METHODS, ServerWebSocket, setupWebSocketHandler, getWebSocketConnections, getWebSocket }
\ No newline at end of file
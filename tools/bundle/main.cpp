@@ -0,0 +1,288 @@
+// tools/bundle/main.cpp
+// rn-http-bundle：把一个目录打包成 bundle 挂载点使用的资源包
+//
+// 每个文件的 Content-Type、ETag（内容哈希）和 gzip 版本都在打包时生成，
+// 应用内只需内存映射整个文件，请求时不再打开文件、计算哈希或压缩。
+// 格式见 cpp/BundleFormat.hpp；--list 输出已有资源包的条目。
+
+#include "BundleFormat.hpp"
+#include "CaptureFormat.hpp"
+#include "StaticAsset.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace bundle = margelo::nitro::http_server::bundle;
+namespace capture = margelo::nitro::http_server::capture;
+namespace fs = std::filesystem;
+using margelo::nitro::http_server::gzipCompress;
+using margelo::nitro::http_server::guessContentType;
+using margelo::nitro::http_server::isCompressibleType;
+
+namespace {
+
+struct Options {
+  std::string input;
+  std::string output;
+  bool gzip = true;
+  int level = 9;
+  size_t minGzipBytes = 1024;
+  std::vector<std::string> headers; // 附加到每个条目的 "名称: 值"
+  bool list = false;
+};
+
+struct InputFile {
+  std::string path; // 相对路径，"/" 分隔
+  std::string data;
+  std::string gzip;
+  std::string headers;
+};
+
+void usage() {
+  std::fprintf(
+      stderr,
+      "usage: rn-http-bundle [options] SOURCE_DIR OUTPUT_FILE\n"
+      "       rn-http-bundle --list BUNDLE_FILE\n"
+      "  --no-gzip            do not store gzip variants\n"
+      "  --level N            gzip level 1-9 (default 9)\n"
+      "  --min-gzip-bytes N   smallest file to compress (default 1024)\n"
+      "  --header 'K: V'      add a response header to every entry "
+      "(repeatable)\n"
+      "  --list               print the entries of an existing bundle\n");
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  std::vector<std::string> positional;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&](const char *name) -> const char * {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", name);
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--no-gzip") {
+      opts.gzip = false;
+    } else if (arg == "--level") {
+      opts.level = std::atoi(next("--level"));
+    } else if (arg == "--min-gzip-bytes") {
+      opts.minGzipBytes =
+          static_cast<size_t>(std::atol(next("--min-gzip-bytes")));
+    } else if (arg == "--header") {
+      std::string header = next("--header");
+      if (header.find(':') == std::string::npos) {
+        std::fprintf(stderr, "invalid header: %s\n", header.c_str());
+        return false;
+      }
+      opts.headers.push_back(header);
+    } else if (arg == "--list") {
+      opts.list = true;
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      std::exit(0);
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+      return false;
+    } else {
+      positional.push_back(arg);
+    }
+  }
+  if (opts.list) {
+    if (positional.size() != 1) {
+      return false;
+    }
+    opts.input = positional[0];
+    return true;
+  }
+  if (positional.size() != 2 || opts.level < 1 || opts.level > 9) {
+    return false;
+  }
+  opts.input = positional[0];
+  opts.output = positional[1];
+  return true;
+}
+
+bool readFile(const fs::path &path, std::string &out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  out.assign(std::istreambuf_iterator<char>(in),
+             std::istreambuf_iterator<char>());
+  return true;
+}
+
+bool collectFiles(const Options &opts, std::vector<InputFile> &files) {
+  std::error_code ec;
+  fs::path root(opts.input);
+  if (!fs::is_directory(root, ec)) {
+    std::fprintf(stderr, "%s is not a directory\n", opts.input.c_str());
+    return false;
+  }
+  for (fs::recursive_directory_iterator it(root, ec), end; it != end;
+       it.increment(ec)) {
+    if (ec) {
+      std::fprintf(stderr, "cannot read %s: %s\n", opts.input.c_str(),
+                   ec.message().c_str());
+      return false;
+    }
+    if (!it->is_regular_file(ec)) {
+      continue;
+    }
+    InputFile file;
+    file.path = it->path().lexically_relative(root).generic_string();
+    if (!readFile(it->path(), file.data)) {
+      std::fprintf(stderr, "cannot read %s\n", it->path().c_str());
+      return false;
+    }
+    std::string contentType = guessContentType(file.path);
+    file.headers = "Content-Type: " + contentType + "\n";
+    for (const auto &header : opts.headers) {
+      file.headers += header + "\n";
+    }
+    if (opts.gzip && file.data.size() >= opts.minGzipBytes &&
+        isCompressibleType(contentType)) {
+      auto gzip =
+          gzipCompress(file.data.data(), file.data.size(), opts.level);
+      // 与 memPut 相同：压缩收益不足 10% 时不保留
+      if (gzip && gzip->size() < file.data.size() / 10 * 9) {
+        file.gzip = std::move(*gzip);
+      }
+    }
+    files.push_back(std::move(file));
+  }
+  // 条目表按路径的字节序排列，运行时二分查找
+  std::sort(files.begin(), files.end(),
+            [](const InputFile &a, const InputFile &b) {
+              return a.path < b.path;
+            });
+  return true;
+}
+
+void align(std::string &out) {
+  while (out.size() % bundle::kDataAlignment != 0) {
+    out.push_back('\0');
+  }
+}
+
+int pack(const Options &opts) {
+  std::vector<InputFile> files;
+  if (!collectFiles(opts, files)) {
+    return 1;
+  }
+
+  std::string strings;
+  std::vector<bundle::Entry> entries(files.size());
+  for (size_t i = 0; i < files.size(); i++) {
+    entries[i].pathOffset = static_cast<uint32_t>(strings.size());
+    entries[i].pathLength = static_cast<uint32_t>(files[i].path.size());
+    strings += files[i].path;
+    entries[i].headersOffset = static_cast<uint32_t>(strings.size());
+    entries[i].headersLength = static_cast<uint32_t>(files[i].headers.size());
+    strings += files[i].headers;
+    entries[i].hash =
+        capture::hashBody(files[i].data.data(), files[i].data.size());
+  }
+
+  bundle::FileHeader header;
+  header.entryCount = static_cast<uint32_t>(files.size());
+  header.stringsOffset =
+      bundle::kFileHeaderSize + files.size() * bundle::kEntrySize;
+  header.stringsSize = strings.size();
+
+  // 先按偏移排好内容区，再回填条目表
+  std::string data;
+  uint64_t dataStart = header.stringsOffset + header.stringsSize;
+  uint64_t padding =
+      (bundle::kDataAlignment - dataStart % bundle::kDataAlignment) %
+      bundle::kDataAlignment;
+  dataStart += padding;
+  uint64_t rawBytes = 0;
+  uint64_t gzipBytes = 0;
+  for (size_t i = 0; i < files.size(); i++) {
+    entries[i].dataOffset = dataStart + data.size();
+    entries[i].dataSize = files[i].data.size();
+    data += files[i].data;
+    align(data);
+    rawBytes += files[i].data.size();
+    if (!files[i].gzip.empty()) {
+      entries[i].gzipOffset = dataStart + data.size();
+      entries[i].gzipSize = files[i].gzip.size();
+      data += files[i].gzip;
+      align(data);
+      gzipBytes += files[i].gzip.size();
+    }
+  }
+
+  std::string out;
+  bundle::encodeFileHeader(out, header);
+  for (const auto &entry : entries) {
+    bundle::encodeEntry(out, entry);
+  }
+  out += strings;
+  out.append(static_cast<size_t>(padding), '\0');
+  out += data;
+
+  std::ofstream file(opts.output, std::ios::binary | std::ios::trunc);
+  if (!file || !file.write(out.data(), static_cast<std::streamsize>(
+                                           out.size()))) {
+    std::fprintf(stderr, "cannot write %s\n", opts.output.c_str());
+    return 1;
+  }
+  std::printf("{\"entries\": %zu, \"raw_bytes\": %llu, \"gzip_bytes\": %llu, "
+              "\"bundle_bytes\": %zu}\n",
+              files.size(), static_cast<unsigned long long>(rawBytes),
+              static_cast<unsigned long long>(gzipBytes), out.size());
+  return 0;
+}
+
+int list(const Options &opts) {
+  std::string data;
+  bundle::FileHeader header;
+  if (!readFile(opts.input, data) || data.size() < bundle::kFileHeaderSize ||
+      !bundle::decodeFileHeader(data.data(), header) ||
+      header.version != bundle::kVersion) {
+    std::fprintf(stderr, "%s is not a bundle file\n", opts.input.c_str());
+    return 1;
+  }
+  if (bundle::kFileHeaderSize + uint64_t(header.entryCount) *
+                                    bundle::kEntrySize >
+          data.size() ||
+      header.stringsOffset + header.stringsSize > data.size()) {
+    std::fprintf(stderr, "%s is truncated\n", opts.input.c_str());
+    return 1;
+  }
+  const char *strings = data.data() + header.stringsOffset;
+  for (uint32_t i = 0; i < header.entryCount; i++) {
+    bundle::Entry entry = bundle::decodeEntry(
+        data.data() + bundle::kFileHeaderSize + i * bundle::kEntrySize);
+    if (uint64_t(entry.pathOffset) + entry.pathLength > header.stringsSize) {
+      std::fprintf(stderr, "entry %u is corrupt\n", i);
+      return 1;
+    }
+    std::string path(strings + entry.pathOffset, entry.pathLength);
+    std::printf("%016llx %10llu %10llu  %s\n",
+                static_cast<unsigned long long>(entry.hash),
+                static_cast<unsigned long long>(entry.dataSize),
+                static_cast<unsigned long long>(entry.gzipSize), path.c_str());
+  }
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts)) {
+    usage();
+    return 2;
+  }
+  return opts.list ? list(opts) : pack(opts);
+}
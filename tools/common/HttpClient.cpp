@@ -0,0 +1,350 @@
+// tools/common/HttpClient.cpp
+#include "HttpClient.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace rn_http_tools {
+
+static std::string toLower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return s;
+}
+
+static std::string trim(const std::string &s) {
+  size_t start = s.find_first_not_of(" \t");
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(start, end - start + 1);
+}
+
+Connection::~Connection() { close(); }
+
+bool Connection::connect(const std::string &host, int port, int timeoutMs) {
+  close();
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *result = nullptr;
+  std::string portStr = std::to_string(port);
+  if (getaddrinfo(host.c_str(), portStr.c_str(), &hints, &result) != 0) {
+    return false;
+  }
+
+  for (addrinfo *ai = result; ai; ai = ai->ai_next) {
+    int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    timeval tv{};
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      _fd = fd;
+      break;
+    }
+    ::close(fd);
+  }
+  freeaddrinfo(result);
+  return _fd >= 0;
+}
+
+void Connection::close() {
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+  _buffer.clear();
+  _offset = 0;
+}
+
+bool Connection::sendAll(const char *data, size_t len) {
+  while (len > 0) {
+    ssize_t n = ::send(_fd, data, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+bool Connection::fill() {
+  if (_offset > 0 && _offset == _buffer.size()) {
+    _buffer.clear();
+    _offset = 0;
+  }
+  char chunk[16 * 1024];
+  for (;;) {
+    ssize_t n = ::recv(_fd, chunk, sizeof(chunk), 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    _buffer.append(chunk, static_cast<size_t>(n));
+    return true;
+  }
+}
+
+bool Connection::readExact(size_t len, std::string *out) {
+  while (_buffer.size() - _offset < len) {
+    if (!fill()) {
+      return false;
+    }
+  }
+  if (out) {
+    out->append(_buffer, _offset, len);
+  }
+  _offset += len;
+  return true;
+}
+
+bool Connection::readLine(std::string &line) {
+  for (;;) {
+    size_t pos = _buffer.find("\r\n", _offset);
+    if (pos != std::string::npos) {
+      line.assign(_buffer, _offset, pos - _offset);
+      _offset = pos + 2;
+      return true;
+    }
+    if (!fill()) {
+      return false;
+    }
+  }
+}
+
+bool Connection::readResponse(HttpResponse &out, bool headRequest,
+                              bool keepBody) {
+  out = HttpResponse();
+  std::string line;
+  if (!readLine(line)) {
+    return false;
+  }
+  // HTTP/1.1 200 OK
+  size_t sp = line.find(' ');
+  if (sp == std::string::npos || line.compare(0, 5, "HTTP/") != 0) {
+    return false;
+  }
+  out.statusCode = std::atoi(line.c_str() + sp + 1);
+  bool http10 = line.compare(0, 8, "HTTP/1.0") == 0;
+
+  for (;;) {
+    if (!readLine(line)) {
+      return false;
+    }
+    if (line.empty()) {
+      break;
+    }
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    out.headers[toLower(line.substr(0, colon))] = trim(line.substr(colon + 1));
+  }
+
+  auto connection = out.headers.find("connection");
+  if (connection != out.headers.end()) {
+    out.keepAlive = toLower(connection->second) != "close";
+  } else {
+    out.keepAlive = !http10;
+  }
+
+  std::string *body = keepBody ? &out.body : nullptr;
+  bool noBody = headRequest || out.statusCode == 204 ||
+                out.statusCode == 304 ||
+                (out.statusCode >= 100 && out.statusCode < 200);
+  if (noBody) {
+    return true;
+  }
+
+  auto te = out.headers.find("transfer-encoding");
+  if (te != out.headers.end() &&
+      toLower(te->second).find("chunked") != std::string::npos) {
+    for (;;) {
+      if (!readLine(line)) {
+        return false;
+      }
+      size_t size = std::strtoul(line.c_str(), nullptr, 16);
+      if (size == 0) {
+        // 跳过 trailer
+        do {
+          if (!readLine(line)) {
+            return false;
+          }
+        } while (!line.empty());
+        return true;
+      }
+      if (!readExact(size, body) || !readLine(line)) {
+        return false;
+      }
+      out.bodyBytes += size;
+    }
+  }
+
+  auto cl = out.headers.find("content-length");
+  if (cl != out.headers.end()) {
+    size_t size = std::strtoul(cl->second.c_str(), nullptr, 10);
+    if (!readExact(size, body)) {
+      return false;
+    }
+    out.bodyBytes = size;
+    return true;
+  }
+
+  // 没有长度信息：读到连接关闭
+  out.keepAlive = false;
+  for (;;) {
+    size_t available = _buffer.size() - _offset;
+    out.bodyBytes += available;
+    if (body) {
+      body->append(_buffer, _offset, available);
+    }
+    _offset = _buffer.size();
+    if (!fill()) {
+      return true;
+    }
+  }
+}
+
+// ==================== WebSocket ====================
+
+bool Connection::upgradeWebSocket(const std::string &host, int port,
+                                  const std::string &path) {
+  // 服务端不校验 key 的随机性，这里使用固定的合法 key
+  std::string request = "GET " + path + " HTTP/1.1\r\n" + "Host: " + host +
+                        ":" + std::to_string(port) + "\r\n" +
+                        "Upgrade: websocket\r\n"
+                        "Connection: Upgrade\r\n"
+                        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                        "Sec-WebSocket-Version: 13\r\n\r\n";
+  if (!sendAll(request)) {
+    return false;
+  }
+  HttpResponse response;
+  return readResponse(response, true) && response.statusCode == 101;
+}
+
+static void appendFrameHeader(std::string &frame, uint8_t opcode,
+                              size_t len) {
+  frame.push_back(static_cast<char>(0x80 | opcode));
+  if (len < 126) {
+    frame.push_back(static_cast<char>(0x80 | len));
+  } else if (len <= 0xFFFF) {
+    frame.push_back(static_cast<char>(0x80 | 126));
+    frame.push_back(static_cast<char>((len >> 8) & 0xFF));
+    frame.push_back(static_cast<char>(len & 0xFF));
+  } else {
+    frame.push_back(static_cast<char>(0x80 | 127));
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      frame.push_back(static_cast<char>((static_cast<uint64_t>(len) >> shift) &
+                                        0xFF));
+    }
+  }
+}
+
+static bool sendFrame(Connection &conn, uint8_t opcode,
+                      const std::string &payload) {
+  static thread_local std::mt19937 rng(std::random_device{}());
+  std::string frame;
+  frame.reserve(payload.size() + 14);
+  appendFrameHeader(frame, opcode, payload.size());
+  uint32_t maskKey = rng();
+  char mask[4];
+  std::memcpy(mask, &maskKey, 4);
+  frame.append(mask, 4);
+  for (size_t i = 0; i < payload.size(); i++) {
+    frame.push_back(static_cast<char>(payload[i] ^ mask[i % 4]));
+  }
+  return conn.sendAll(frame);
+}
+
+bool Connection::sendWebSocketText(const std::string &payload) {
+  return sendFrame(*this, 0x1, payload);
+}
+
+bool Connection::readWebSocketMessage(std::string &payload) {
+  payload.clear();
+  for (;;) {
+    std::string header;
+    if (!readExact(2, &header)) {
+      return false;
+    }
+    auto b0 = static_cast<uint8_t>(header[0]);
+    auto b1 = static_cast<uint8_t>(header[1]);
+    uint8_t opcode = b0 & 0x0F;
+    uint64_t len = b1 & 0x7F;
+    if (len >= 126) {
+      std::string ext;
+      size_t extLen = len == 126 ? 2 : 8;
+      if (!readExact(extLen, &ext)) {
+        return false;
+      }
+      len = 0;
+      for (char c : ext) {
+        len = (len << 8) | static_cast<uint8_t>(c);
+      }
+    }
+    std::string mask;
+    if ((b1 & 0x80) && !readExact(4, &mask)) {
+      return false;
+    }
+    std::string data;
+    if (!readExact(static_cast<size_t>(len), &data)) {
+      return false;
+    }
+    if (!mask.empty()) {
+      for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<char>(data[i] ^ mask[i % 4]);
+      }
+    }
+
+    if (opcode == 0x8) { // close
+      return false;
+    }
+    if (opcode == 0x9) { // ping
+      sendFrame(*this, 0xA, data);
+      continue;
+    }
+    if (opcode == 0xA) { // pong
+      continue;
+    }
+    payload += data;
+    if (b0 & 0x80) {
+      return true;
+    }
+  }
+}
+
+} // namespace rn_http_tools
@@ -0,0 +1,58 @@
+// tools/common/HttpClient.hpp
+// 压测/回放工具共用的最小阻塞式 HTTP/1.1 与 WebSocket 客户端（仅 POSIX）
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace rn_http_tools {
+
+struct HttpResponse {
+  int statusCode = 0;
+  std::map<std::string, std::string> headers; // 键为小写
+  uint64_t bodyBytes = 0;
+  std::string body; // 仅在 keepBody 为 true 时填充
+  bool keepAlive = true;
+};
+
+class Connection {
+public:
+  Connection() = default;
+  ~Connection();
+  Connection(const Connection &) = delete;
+  Connection &operator=(const Connection &) = delete;
+
+  bool connect(const std::string &host, int port, int timeoutMs);
+  void close();
+  bool isOpen() const { return _fd >= 0; }
+
+  bool sendAll(const char *data, size_t len);
+  bool sendAll(const std::string &data) {
+    return sendAll(data.data(), data.size());
+  }
+
+  // 读取一个完整响应（支持 Content-Length / chunked / 读到连接关闭）
+  bool readResponse(HttpResponse &out, bool headRequest = false,
+                    bool keepBody = false);
+
+  // ==================== WebSocket ====================
+
+  // 发送升级请求并等待 101
+  bool upgradeWebSocket(const std::string &host, int port,
+                        const std::string &path);
+  // 发送一个带掩码的文本帧
+  bool sendWebSocketText(const std::string &payload);
+  // 读取一个数据帧（自动应答 ping），返回 false 表示连接已关闭或出错
+  bool readWebSocketMessage(std::string &payload);
+
+private:
+  bool fill();
+  bool readExact(size_t len, std::string *out);
+  bool readLine(std::string &line);
+
+  int _fd = -1;
+  std::string _buffer;
+  size_t _offset = 0;
+};
+
+} // namespace rn_http_tools
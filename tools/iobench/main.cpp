@@ -0,0 +1,214 @@
+// tools/iobench/main.cpp
+// rn-http-iobench：在高并发下比较桥接层文件读取后端（pread / io_uring）
+//
+// 对目录中的文件（或 --create 生成的测试文件）用 N 个线程反复调用
+// FileReader::readFile，统计吞吐和延迟分布。默认依次测试两个后端，
+// 便于在目标设备（如 Linux 信息亭）上直接比较。结果以 JSON 输出到 stdout。
+// 建议先用 --create 生成数据，再清空页缓存分别测试冷、热两种情况。
+
+#include "FileReader.hpp"
+#include "LatencyHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using margelo::nitro::http_server::FileReader;
+using margelo::nitro::http_server::LatencyHistogram;
+using margelo::nitro::http_server::parseFileIoBackend;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+  std::string dir;
+  std::string backend = "both";
+  int concurrency = 64;
+  double durationSec = 10;
+  size_t createCount = 0;
+  size_t createBytes = 16 * 1024;
+};
+
+void usage() {
+  std::fprintf(
+      stderr,
+      "usage: rn-http-iobench [options] DIR\n"
+      "  --backend NAME       posix, io_uring or both (default both)\n"
+      "  -c, --concurrency N  reader threads (default 64)\n"
+      "  -d, --duration SEC   seconds per backend (default 10)\n"
+      "  --create N           first write N test files into DIR\n"
+      "  --file-bytes N       size of created files (default 16384)\n");
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&](const char *name) -> const char * {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", name);
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--backend") {
+      opts.backend = next("--backend");
+    } else if (arg == "-c" || arg == "--concurrency") {
+      opts.concurrency = std::atoi(next("--concurrency"));
+    } else if (arg == "-d" || arg == "--duration") {
+      opts.durationSec = std::atof(next("--duration"));
+    } else if (arg == "--create") {
+      opts.createCount = static_cast<size_t>(std::atol(next("--create")));
+    } else if (arg == "--file-bytes") {
+      opts.createBytes = static_cast<size_t>(std::atol(next("--file-bytes")));
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      std::exit(0);
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+      return false;
+    } else {
+      opts.dir = arg;
+    }
+  }
+  bool backendOk = opts.backend == "both" ||
+                   parseFileIoBackend(opts.backend).has_value();
+  return !opts.dir.empty() && backendOk && opts.concurrency > 0 &&
+         opts.durationSec > 0;
+}
+
+bool createFiles(const Options &opts) {
+  std::error_code ec;
+  fs::create_directories(opts.dir, ec);
+  std::mt19937 rng(42);
+  std::string data(opts.createBytes, '\0');
+  for (size_t i = 0; i < opts.createCount; i++) {
+    for (auto &c : data) {
+      c = static_cast<char>(rng());
+    }
+    std::ofstream out(fs::path(opts.dir) / ("bench-" + std::to_string(i)),
+                      std::ios::binary | std::ios::trunc);
+    if (!out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+      std::fprintf(stderr, "cannot write into %s\n", opts.dir.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::string> listFiles(const std::string &dir) {
+  std::vector<std::string> files;
+  std::error_code ec;
+  for (fs::directory_iterator it(dir, ec), end; it != end; it.increment(ec)) {
+    if (!ec && it->is_regular_file(ec)) {
+      files.push_back(it->path().string());
+    }
+  }
+  return files;
+}
+
+void runBackend(const Options &opts, const std::vector<std::string> &files,
+                FileReader::Backend requested, bool first) {
+  FileReader &reader = FileReader::shared();
+  FileReader::Backend actual = reader.setBackend(requested);
+  // io_uring 不可用时 FileReader 退回 pread，结果中注明实际使用的后端
+  const char *requestedName =
+      requested == FileReader::Backend::IoUring ? "io_uring" : "posix";
+  const char *actualName =
+      actual == FileReader::Backend::IoUring ? "io_uring" : "posix";
+
+  auto histogram = std::make_unique<LatencyHistogram>();
+  std::atomic<uint64_t> reads{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> errors{0};
+  auto deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double>(opts.durationSec));
+
+  auto worker = [&](unsigned seed) {
+    std::minstd_rand rng(seed);
+    while (Clock::now() < deadline) {
+      const std::string &file = files[rng() % files.size()];
+      auto start = Clock::now();
+      auto contents = reader.readFile(file);
+      auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - start)
+                    .count();
+      if (!contents) {
+        errors++;
+        continue;
+      }
+      histogram->record(static_cast<uint64_t>(us));
+      reads++;
+      bytes += contents->size();
+    }
+  };
+
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < opts.concurrency; i++) {
+    threads.emplace_back(worker, static_cast<unsigned>(i + 1));
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  double elapsedSec =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+  std::printf("%s\"%s\": {\"backend\": \"%s\", \"reads\": %llu, "
+              "\"errors\": %llu, "
+              "\"reads_per_sec\": %.1f, \"mb_per_sec\": %.2f, "
+              "\"latency\": {\"mean_ms\": %.3f, \"p50_ms\": %.3f, "
+              "\"p99_ms\": %.3f, \"p999_ms\": %.3f, \"max_ms\": %.3f}}",
+              first ? "" : ", ", requestedName, actualName,
+              static_cast<unsigned long long>(reads.load()),
+              static_cast<unsigned long long>(errors.load()),
+              static_cast<double>(reads.load()) / elapsedSec,
+              static_cast<double>(bytes.load()) / elapsedSec / 1e6,
+              histogram->mean() / 1000.0, ms(histogram->percentile(50)),
+              ms(histogram->percentile(99)), ms(histogram->percentile(99.9)),
+              ms(histogram->max()));
+  std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts)) {
+    usage();
+    return 2;
+  }
+  if (opts.createCount > 0 && !createFiles(opts)) {
+    return 1;
+  }
+  std::vector<std::string> files = listFiles(opts.dir);
+  if (files.empty()) {
+    std::fprintf(stderr, "%s contains no files (try --create N)\n",
+                 opts.dir.c_str());
+    return 1;
+  }
+
+  std::printf("{\"files\": %zu, \"concurrency\": %d, ", files.size(),
+              opts.concurrency);
+  bool first = true;
+  for (const char *name : {"posix", "io_uring"}) {
+    if (opts.backend != "both" && opts.backend != name) {
+      continue;
+    }
+    runBackend(opts, files, *parseFileIoBackend(name), first);
+    first = false;
+  }
+  std::printf("}\n");
+  FileReader::shared().setBackend(FileReader::Backend::Posix);
+  return 0;
+}
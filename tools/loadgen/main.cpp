@@ -0,0 +1,435 @@
+// tools/loadgen/main.cpp
+// rn-http-loadgen：针对本机运行的 rn_http_server 实例的可复现压测工具
+//
+// 每个并发 worker 持有一条连接，按权重从请求组合中选取请求类型：
+//   static   GET 静态文件
+//   callback POST 到 JS 回调
+//   stream   以 chunked 编码分块上传请求体（走 readRequestBodyChunk）
+//   ws       WebSocket 文本回显
+// 指定 --rate 时按固定节奏开环发压，延迟从计划发送时刻开始计算
+// （避免 coordinated omission）；否则为闭环满负荷压测。
+// 结果以 JSON 输出到 stdout。
+
+#include "HttpClient.hpp"
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using margelo::nitro::http_server::LatencyHistogram;
+using rn_http_tools::Connection;
+using rn_http_tools::HttpResponse;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+enum RequestKind { kStatic = 0, kCallback, kStream, kWebSocket, kKindCount };
+const char *const kKindNames[kKindCount] = {"static", "callback", "stream",
+                                            "ws"};
+
+struct Options {
+  std::string host = "127.0.0.1";
+  int port = 8080;
+  int concurrency = 16;
+  double durationSec = 10;
+  double warmupSec = 1;
+  double rate = 0; // 总请求速率（次/秒），0 表示闭环
+  bool keepAlive = true;
+  int timeoutMs = 5000;
+  size_t bodySize = 256;
+  std::string staticPath = "/index.html";
+  std::string callbackPath = "/api/echo";
+  std::string streamPath = "/api/upload";
+  std::string wsPath = "/ws";
+  int weights[kKindCount] = {100, 0, 0, 0};
+};
+
+struct KindStats {
+  LatencyHistogram latency;
+  std::atomic<uint64_t> requests{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> bytesReceived{0};
+};
+
+struct SharedStats {
+  KindStats kinds[kKindCount];
+  std::mutex statusMutex;
+  std::map<int, uint64_t> statusCodes;
+};
+
+void usage() {
+  std::fprintf(
+      stderr,
+      "usage: rn-http-loadgen [options]\n"
+      "  --host HOST            target host (default 127.0.0.1)\n"
+      "  --port PORT            target port (default 8080)\n"
+      "  -c, --concurrency N    concurrent connections (default 16)\n"
+      "  -d, --duration SEC     measured duration (default 10)\n"
+      "  --warmup SEC           warmup before measuring (default 1)\n"
+      "  --rate RPS             total open-loop request rate, 0 = closed "
+      "loop\n"
+      "  --no-keep-alive        new connection per HTTP request\n"
+      "  --timeout-ms MS        socket timeout (default 5000)\n"
+      "  --body-size BYTES      POST/stream body size (default 256)\n"
+      "  --mix SPEC             e.g. static=60,callback=30,stream=5,ws=5\n"
+      "  --static-path PATH     (default /index.html)\n"
+      "  --callback-path PATH   (default /api/echo)\n"
+      "  --stream-path PATH     (default /api/upload)\n"
+      "  --ws-path PATH         (default /ws)\n");
+}
+
+bool parseMix(const std::string &spec, int weights[kKindCount]) {
+  for (int i = 0; i < kKindCount; i++) {
+    weights[i] = 0;
+  }
+  size_t pos = 0;
+  while (pos < spec.size()) {
+    size_t comma = spec.find(',', pos);
+    std::string item = spec.substr(pos, comma == std::string::npos
+                                            ? std::string::npos
+                                            : comma - pos);
+    size_t eq = item.find('=');
+    std::string name = item.substr(0, eq);
+    int weight = eq == std::string::npos ? 1 : std::atoi(item.c_str() + eq + 1);
+    bool known = false;
+    for (int i = 0; i < kKindCount; i++) {
+      if (name == kKindNames[i]) {
+        weights[i] = weight;
+        known = true;
+      }
+    }
+    if (!known) {
+      std::fprintf(stderr, "unknown request kind in --mix: %s\n", name.c_str());
+      return false;
+    }
+    if (comma == std::string::npos) {
+      break;
+    }
+    pos = comma + 1;
+  }
+  int total = 0;
+  for (int i = 0; i < kKindCount; i++) {
+    total += weights[i];
+  }
+  return total > 0;
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&](const char *name) -> const char * {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", name);
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--host") {
+      opts.host = next("--host");
+    } else if (arg == "--port") {
+      opts.port = std::atoi(next("--port"));
+    } else if (arg == "-c" || arg == "--concurrency") {
+      opts.concurrency = std::atoi(next("--concurrency"));
+    } else if (arg == "-d" || arg == "--duration") {
+      opts.durationSec = std::atof(next("--duration"));
+    } else if (arg == "--warmup") {
+      opts.warmupSec = std::atof(next("--warmup"));
+    } else if (arg == "--rate") {
+      opts.rate = std::atof(next("--rate"));
+    } else if (arg == "--no-keep-alive") {
+      opts.keepAlive = false;
+    } else if (arg == "--timeout-ms") {
+      opts.timeoutMs = std::atoi(next("--timeout-ms"));
+    } else if (arg == "--body-size") {
+      opts.bodySize = static_cast<size_t>(std::atol(next("--body-size")));
+    } else if (arg == "--mix") {
+      if (!parseMix(next("--mix"), opts.weights)) {
+        return false;
+      }
+    } else if (arg == "--static-path") {
+      opts.staticPath = next("--static-path");
+    } else if (arg == "--callback-path") {
+      opts.callbackPath = next("--callback-path");
+    } else if (arg == "--stream-path") {
+      opts.streamPath = next("--stream-path");
+    } else if (arg == "--ws-path") {
+      opts.wsPath = next("--ws-path");
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      std::exit(0);
+    } else {
+      std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+      return false;
+    }
+  }
+  return opts.concurrency > 0 && opts.durationSec > 0 && opts.port > 0;
+}
+
+std::string buildRequest(const Options &opts, RequestKind kind,
+                         const std::string &body) {
+  std::string hostHeader = opts.host + ":" + std::to_string(opts.port);
+  std::string connection = opts.keepAlive ? "keep-alive" : "close";
+  switch (kind) {
+  case kStatic:
+    return "GET " + opts.staticPath + " HTTP/1.1\r\nHost: " + hostHeader +
+           "\r\nConnection: " + connection + "\r\n\r\n";
+  case kCallback:
+    return "POST " + opts.callbackPath + " HTTP/1.1\r\nHost: " + hostHeader +
+           "\r\nConnection: " + connection +
+           "\r\nContent-Type: application/json\r\nContent-Length: " +
+           std::to_string(body.size()) + "\r\n\r\n" + body;
+  case kStream: {
+    std::string request = "POST " + opts.streamPath +
+                          " HTTP/1.1\r\nHost: " + hostHeader +
+                          "\r\nConnection: " + connection +
+                          "\r\nContent-Type: application/octet-stream"
+                          "\r\nTransfer-Encoding: chunked\r\n\r\n";
+    // 分 4 块发送
+    size_t chunkSize = (body.size() + 3) / 4;
+    for (size_t off = 0; off < body.size(); off += chunkSize) {
+      size_t n = std::min(chunkSize, body.size() - off);
+      char sizeLine[32];
+      std::snprintf(sizeLine, sizeof(sizeLine), "%zx\r\n", n);
+      request += sizeLine;
+      request.append(body, off, n);
+      request += "\r\n";
+    }
+    request += "0\r\n\r\n";
+    return request;
+  }
+  default:
+    return "";
+  }
+}
+
+class Worker {
+public:
+  Worker(const Options &opts, SharedStats &stats, int index,
+         Clock::time_point measureStart, Clock::time_point deadline)
+      : _opts(opts), _stats(stats), _measureStart(measureStart),
+        _deadline(deadline), _rng(static_cast<uint32_t>(index) * 7919u + 17u) {
+    for (int i = 0; i < kKindCount; i++) {
+      _totalWeight += opts.weights[i];
+    }
+    _body.assign(opts.bodySize, 'x');
+    if (opts.bodySize >= 2) {
+      // 回调路径发送合法 JSON
+      _jsonBody = "\"" + std::string(opts.bodySize - 2, 'x') + "\"";
+    } else {
+      _jsonBody = "0";
+    }
+  }
+
+  void run() {
+    double perWorkerRate = _opts.rate / _opts.concurrency;
+    auto interval = perWorkerRate > 0
+                        ? std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(1.0 / perWorkerRate))
+                        : Clock::duration::zero();
+    auto scheduled = Clock::now();
+
+    while (Clock::now() < _deadline) {
+      if (interval > Clock::duration::zero()) {
+        std::this_thread::sleep_until(scheduled);
+      } else {
+        scheduled = Clock::now();
+      }
+
+      RequestKind kind = pickKind();
+      bool ok = execute(kind);
+      auto finished = Clock::now();
+
+      if (scheduled >= _measureStart) {
+        KindStats &k = _stats.kinds[kind];
+        k.requests++;
+        k.bytesReceived += _lastBytes;
+        if (_lastStatus > 0) {
+          std::lock_guard<std::mutex> lock(_stats.statusMutex);
+          _stats.statusCodes[_lastStatus]++;
+        }
+        if (ok) {
+          auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        finished - scheduled)
+                        .count();
+          k.latency.record(static_cast<uint64_t>(us));
+        } else {
+          k.errors++;
+        }
+      }
+      if (interval > Clock::duration::zero()) {
+        scheduled += interval;
+      }
+    }
+  }
+
+private:
+  RequestKind pickKind() {
+    int roll = static_cast<int>(_rng() % static_cast<uint32_t>(_totalWeight));
+    for (int i = 0; i < kKindCount; i++) {
+      if (roll < _opts.weights[i]) {
+        return static_cast<RequestKind>(i);
+      }
+      roll -= _opts.weights[i];
+    }
+    return kStatic;
+  }
+
+  bool execute(RequestKind kind) {
+    _lastStatus = 0;
+    _lastBytes = 0;
+    if (kind == kWebSocket) {
+      return executeWebSocket();
+    }
+
+    if (!_http.isOpen() &&
+        !_http.connect(_opts.host, _opts.port, _opts.timeoutMs)) {
+      return false;
+    }
+    std::string request =
+        buildRequest(_opts, kind, kind == kCallback ? _jsonBody : _body);
+    HttpResponse response;
+    bool ok = _http.sendAll(request) && _http.readResponse(response);
+    if (!ok || !response.keepAlive || !_opts.keepAlive) {
+      _http.close();
+    }
+    if (!ok) {
+      return false;
+    }
+    _lastStatus = response.statusCode;
+    _lastBytes = response.bodyBytes;
+    return response.statusCode < 500;
+  }
+
+  bool executeWebSocket() {
+    if (!_ws.isOpen()) {
+      if (!_ws.connect(_opts.host, _opts.port, _opts.timeoutMs) ||
+          !_ws.upgradeWebSocket(_opts.host, _opts.port, _opts.wsPath)) {
+        _ws.close();
+        return false;
+      }
+    }
+    std::string reply;
+    if (!_ws.sendWebSocketText(_body) || !_ws.readWebSocketMessage(reply)) {
+      _ws.close();
+      return false;
+    }
+    _lastBytes = reply.size();
+    return true;
+  }
+
+  const Options &_opts;
+  SharedStats &_stats;
+  Clock::time_point _measureStart;
+  Clock::time_point _deadline;
+  std::mt19937 _rng;
+  int _totalWeight = 0;
+  std::string _body;
+  std::string _jsonBody;
+  Connection _http;
+  Connection _ws;
+  int _lastStatus = 0;
+  uint64_t _lastBytes = 0;
+};
+
+void printLatency(const LatencyHistogram &h) {
+  auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+  std::printf("{\"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p90_ms\": %.3f, "
+              "\"p99_ms\": %.3f, \"p999_ms\": %.3f, \"max_ms\": %.3f}",
+              h.mean() / 1000.0, ms(h.percentile(50)), ms(h.percentile(90)),
+              ms(h.percentile(99)), ms(h.percentile(99.9)), ms(h.max()));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts)) {
+    usage();
+    return 2;
+  }
+
+  auto stats = std::make_unique<SharedStats>();
+  auto start = Clock::now();
+  auto measureStart =
+      start + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(opts.warmupSec));
+  auto deadline = measureStart +
+                  std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<double>(opts.durationSec));
+
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<size_t>(opts.concurrency));
+  for (int i = 0; i < opts.concurrency; i++) {
+    threads.emplace_back([&, i]() {
+      Worker worker(opts, *stats, i, measureStart, deadline);
+      worker.run();
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  auto total = std::make_unique<LatencyHistogram>();
+  uint64_t requests = 0;
+  uint64_t errors = 0;
+  uint64_t bytes = 0;
+  for (auto &k : stats->kinds) {
+    total->merge(k.latency);
+    requests += k.requests;
+    errors += k.errors;
+    bytes += k.bytesReceived;
+  }
+
+  std::printf("{\n");
+  std::printf("  \"target\": \"%s:%d\",\n", opts.host.c_str(), opts.port);
+  std::printf("  \"concurrency\": %d,\n", opts.concurrency);
+  std::printf("  \"keep_alive\": %s,\n", opts.keepAlive ? "true" : "false");
+  std::printf("  \"mode\": \"%s\",\n", opts.rate > 0 ? "open" : "closed");
+  std::printf("  \"target_rate\": %.1f,\n", opts.rate);
+  std::printf("  \"duration_s\": %.3f,\n", opts.durationSec);
+  std::printf("  \"requests\": %llu,\n",
+              static_cast<unsigned long long>(requests));
+  std::printf("  \"errors\": %llu,\n", static_cast<unsigned long long>(errors));
+  std::printf("  \"throughput_rps\": %.1f,\n",
+              static_cast<double>(requests - errors) / opts.durationSec);
+  std::printf("  \"bytes_received\": %llu,\n",
+              static_cast<unsigned long long>(bytes));
+  std::printf("  \"latency\": ");
+  printLatency(*total);
+  std::printf(",\n  \"by_kind\": {");
+  bool first = true;
+  for (int i = 0; i < kKindCount; i++) {
+    if (opts.weights[i] == 0) {
+      continue;
+    }
+    const KindStats &k = stats->kinds[i];
+    std::printf("%s\n    \"%s\": {\"requests\": %llu, \"errors\": %llu, "
+                "\"latency\": ",
+                first ? "" : ",", kKindNames[i],
+                static_cast<unsigned long long>(k.requests.load()),
+                static_cast<unsigned long long>(k.errors.load()));
+    printLatency(k.latency);
+    std::printf("}");
+    first = false;
+  }
+  std::printf("\n  },\n  \"status_codes\": {");
+  first = true;
+  for (const auto &[code, count] : stats->statusCodes) {
+    std::printf("%s\"%d\": %llu", first ? "" : ", ", code,
+                static_cast<unsigned long long>(count));
+    first = false;
+  }
+  std::printf("}\n}\n");
+  return errors == requests && requests > 0 ? 1 : 0;
+}
@@ -0,0 +1,442 @@
+// tools/replay/main.cpp
+// rn-http-replay：回放 startTrafficCapture() 抓取的流量并对比延迟分布
+//
+// 按抓取时的到达间隔（可用 --speed 缩放）开环重放每个请求，延迟从计划发送
+// 时刻开始计算。未保存请求体的请求用相同长度的填充数据代替。
+// 抓取端记录的是桥接层耗时（请求进入桥接层到响应交给 Rust），回放端记录的
+// 是端到端耗时，两者之差即为网络和 Rust 层的开销。
+// 结果以 JSON 输出到 stdout；--dump 则把抓取文件逐条输出为 JSON Lines。
+
+#include "CaptureFormat.hpp"
+#include "HttpClient.hpp"
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace capture = margelo::nitro::http_server::capture;
+using margelo::nitro::http_server::LatencyHistogram;
+using rn_http_tools::Connection;
+using rn_http_tools::HttpResponse;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+  std::string file;
+  std::string host = "127.0.0.1";
+  int port = 8080;
+  int concurrency = 32;
+  double speed = 1; // 0 表示不等待，尽快发出
+  bool keepAlive = true;
+  int timeoutMs = 5000;
+  size_t limit = 0;
+  size_t topRoutes = 10;
+  bool dump = false;
+};
+
+struct Capture {
+  uint64_t startUnixMs = 0;
+  std::vector<capture::RequestRecord> requests;
+  std::unordered_map<uint64_t, capture::ResponseRecord> responses;
+};
+
+struct RouteStats {
+  LatencyHistogram captured;
+  LatencyHistogram replayed;
+  std::atomic<uint64_t> requests{0};
+};
+
+void usage() {
+  std::fprintf(
+      stderr,
+      "usage: rn-http-replay [options] CAPTURE_FILE\n"
+      "  --host HOST          target host (default 127.0.0.1)\n"
+      "  --port PORT          target port (default 8080)\n"
+      "  --speed X            timing scale, 2 = twice as fast, 0 = no "
+      "pacing (default 1)\n"
+      "  -c, --concurrency N  max in-flight requests (default 32)\n"
+      "  --no-keep-alive      new connection per request\n"
+      "  --timeout-ms MS      socket timeout (default 5000)\n"
+      "  --limit N            replay only the first N requests\n"
+      "  --top N              routes listed in by_route (default 10)\n"
+      "  --dump               print the capture as JSON lines and exit\n");
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&](const char *name) -> const char * {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", name);
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--host") {
+      opts.host = next("--host");
+    } else if (arg == "--port") {
+      opts.port = std::atoi(next("--port"));
+    } else if (arg == "--speed") {
+      opts.speed = std::atof(next("--speed"));
+    } else if (arg == "-c" || arg == "--concurrency") {
+      opts.concurrency = std::atoi(next("--concurrency"));
+    } else if (arg == "--no-keep-alive") {
+      opts.keepAlive = false;
+    } else if (arg == "--timeout-ms") {
+      opts.timeoutMs = std::atoi(next("--timeout-ms"));
+    } else if (arg == "--limit") {
+      opts.limit = static_cast<size_t>(std::atol(next("--limit")));
+    } else if (arg == "--top") {
+      opts.topRoutes = static_cast<size_t>(std::atol(next("--top")));
+    } else if (arg == "--dump") {
+      opts.dump = true;
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      std::exit(0);
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+      return false;
+    } else {
+      opts.file = arg;
+    }
+  }
+  return !opts.file.empty() && opts.concurrency > 0 && opts.speed >= 0 &&
+         opts.port > 0;
+}
+
+bool loadCapture(const std::string &path, Capture &out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::fprintf(stderr, "cannot open %s\n", path.c_str());
+    return false;
+  }
+  std::string data((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+
+  capture::Decoder dec(data.data(), data.size());
+  if (!capture::decodeFileHeader(dec, out.startUnixMs)) {
+    std::fprintf(stderr, "%s is not a capture file\n", path.c_str());
+    return false;
+  }
+  while (!dec.atEnd()) {
+    auto type = static_cast<capture::RecordType>(dec.u8());
+    std::string payload = dec.str();
+    if (!dec.ok()) {
+      // 抓取过程中被中断时最后一条记录可能不完整
+      std::fprintf(stderr, "warning: truncated record at offset %zu\n",
+                   dec.position());
+      break;
+    }
+    if (type == capture::RecordType::Request) {
+      capture::RequestRecord r;
+      if (capture::decodeRequest(payload, r)) {
+        out.requests.push_back(std::move(r));
+      }
+    } else if (type == capture::RecordType::Response) {
+      capture::ResponseRecord r;
+      if (capture::decodeResponse(payload, r)) {
+        out.responses[r.seq] = r;
+      }
+    }
+    // 未知类型直接跳过，便于以后扩展
+  }
+  std::sort(out.requests.begin(), out.requests.end(),
+            [](const capture::RequestRecord &a,
+               const capture::RequestRecord &b) {
+              return a.offsetUs < b.offsetUs;
+            });
+  return true;
+}
+
+std::string jsonEscape(const std::string &s) {
+  std::string out;
+  for (unsigned char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += static_cast<char>(c);
+    } else if (c < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += static_cast<char>(c);
+    }
+  }
+  return out;
+}
+
+void dumpCapture(const Capture &cap) {
+  for (const auto &r : cap.requests) {
+    std::printf("{\"seq\": %llu, \"offset_ms\": %.3f, \"method\": \"%s\", "
+                "\"path\": \"%s\", \"headers\": {",
+                static_cast<unsigned long long>(r.seq),
+                static_cast<double>(r.offsetUs) / 1000.0,
+                jsonEscape(r.method).c_str(), jsonEscape(r.path).c_str());
+    for (size_t i = 0; i < r.headers.size(); i++) {
+      std::printf("%s\"%s\": \"%s\"", i ? ", " : "",
+                  jsonEscape(r.headers[i].first).c_str(),
+                  jsonEscape(r.headers[i].second).c_str());
+    }
+    std::printf("}, \"body_length\": %llu, \"body_hash\": \"%016llx\", "
+                "\"body_stored\": %s",
+                static_cast<unsigned long long>(r.bodyLength),
+                static_cast<unsigned long long>(r.bodyHash),
+                r.bodyStored ? "true" : "false");
+    auto it = cap.responses.find(r.seq);
+    if (it != cap.responses.end()) {
+      std::printf(", \"status\": %llu, \"latency_ms\": %.3f",
+                  static_cast<unsigned long long>(it->second.statusCode),
+                  static_cast<double>(it->second.latencyUs) / 1000.0);
+    }
+    std::printf("}\n");
+  }
+}
+
+// 逐跳头部和由回放端重新生成的头部不原样转发
+bool isSkippedHeader(const std::string &name) {
+  static const char *const kSkipped[] = {
+      "host",    "content-length", "transfer-encoding", "connection",
+      "upgrade", "keep-alive",     "expect",            "te"};
+  for (const char *skipped : kSkipped) {
+    if (name == skipped) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string buildRequest(const Options &opts,
+                         const capture::RequestRecord &r) {
+  std::string body = r.body;
+  if (!r.bodyStored) {
+    uint64_t length = r.bodyLength;
+    if (length == 0) {
+      // 流式上传的请求体不经过回调入口，只能从 content-length 得知长度
+      for (const auto &[name, value] : r.headers) {
+        if (name == "content-length") {
+          length = std::strtoull(value.c_str(), nullptr, 10);
+        }
+      }
+    }
+    body.assign(static_cast<size_t>(length), 'x');
+  }
+
+  std::string request = r.method + " " + r.path + " HTTP/1.1\r\nHost: " +
+                        opts.host + ":" + std::to_string(opts.port) + "\r\n";
+  for (const auto &[name, value] : r.headers) {
+    if (isSkippedHeader(name) || value.empty()) {
+      continue;
+    }
+    request += name + ": " + value + "\r\n";
+  }
+  request += opts.keepAlive ? "Connection: keep-alive\r\n"
+                            : "Connection: close\r\n";
+  if (!body.empty() || r.method == "POST" || r.method == "PUT" ||
+      r.method == "PATCH") {
+    request += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  }
+  request += "\r\n";
+  request += body;
+  return request;
+}
+
+std::string routeOf(const std::string &path) {
+  return path.substr(0, path.find('?'));
+}
+
+void printLatency(const LatencyHistogram &h) {
+  auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+  std::printf("{\"count\": %llu, \"mean_ms\": %.3f, \"p50_ms\": %.3f, "
+              "\"p90_ms\": %.3f, \"p99_ms\": %.3f, \"p999_ms\": %.3f, "
+              "\"max_ms\": %.3f}",
+              static_cast<unsigned long long>(h.count()), h.mean() / 1000.0,
+              ms(h.percentile(50)), ms(h.percentile(90)), ms(h.percentile(99)),
+              ms(h.percentile(99.9)), ms(h.max()));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts)) {
+    usage();
+    return 2;
+  }
+
+  Capture cap;
+  if (!loadCapture(opts.file, cap)) {
+    return 1;
+  }
+  if (opts.dump) {
+    dumpCapture(cap);
+    return 0;
+  }
+  if (opts.limit > 0 && cap.requests.size() > opts.limit) {
+    cap.requests.resize(opts.limit);
+  }
+  if (cap.requests.empty()) {
+    std::fprintf(stderr, "capture contains no requests\n");
+    return 1;
+  }
+
+  // 预先建立每个路由的统计，回放期间只做原子计数
+  std::map<std::string, std::unique_ptr<RouteStats>> routes;
+  std::vector<RouteStats *> routeOfRequest;
+  auto captured = std::make_unique<LatencyHistogram>();
+  for (const auto &r : cap.requests) {
+    auto &slot = routes[routeOf(r.path)];
+    if (!slot) {
+      slot = std::make_unique<RouteStats>();
+    }
+    routeOfRequest.push_back(slot.get());
+    auto it = cap.responses.find(r.seq);
+    if (it != cap.responses.end()) {
+      captured->record(it->second.latencyUs);
+      slot->captured.record(it->second.latencyUs);
+    }
+  }
+
+  auto replayed = std::make_unique<LatencyHistogram>();
+  std::atomic<size_t> nextIndex{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> statusMismatches{0};
+  std::atomic<uint64_t> lateStarts{0};
+  std::mutex statusMutex;
+  std::map<int, uint64_t> statusCodes;
+
+  auto start = Clock::now() + std::chrono::milliseconds(50);
+  uint64_t firstOffsetUs = cap.requests.front().offsetUs;
+
+  auto worker = [&]() {
+    Connection conn;
+    for (;;) {
+      size_t index = nextIndex++;
+      if (index >= cap.requests.size()) {
+        return;
+      }
+      const auto &r = cap.requests[index];
+      Clock::time_point scheduled;
+      if (opts.speed > 0) {
+        auto offset = std::chrono::duration<double, std::micro>(
+            static_cast<double>(r.offsetUs - firstOffsetUs) / opts.speed);
+        scheduled =
+            start + std::chrono::duration_cast<Clock::duration>(offset);
+        std::this_thread::sleep_until(scheduled);
+        if (Clock::now() - scheduled > std::chrono::milliseconds(10)) {
+          // 所有 worker 都忙，无法按原始节奏发出
+          lateStarts++;
+        }
+      } else {
+        scheduled = Clock::now();
+      }
+
+      std::string request = buildRequest(opts, r);
+      HttpResponse response;
+      bool ok = (conn.isOpen() ||
+                 conn.connect(opts.host, opts.port, opts.timeoutMs)) &&
+                conn.sendAll(request) &&
+                conn.readResponse(response, r.method == "HEAD");
+      if (!ok || !response.keepAlive || !opts.keepAlive) {
+        conn.close();
+      }
+      if (!ok) {
+        errors++;
+        continue;
+      }
+
+      auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - scheduled)
+                    .count();
+      replayed->record(static_cast<uint64_t>(us));
+      RouteStats *route = routeOfRequest[index];
+      route->replayed.record(static_cast<uint64_t>(us));
+      route->requests++;
+
+      auto it = cap.responses.find(r.seq);
+      if (it != cap.responses.end() &&
+          static_cast<int>(it->second.statusCode) != response.statusCode) {
+        statusMismatches++;
+      }
+      std::lock_guard<std::mutex> lock(statusMutex);
+      statusCodes[response.statusCode]++;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  int threadCount = std::min<int>(
+      opts.concurrency, static_cast<int>(cap.requests.size()));
+  for (int i = 0; i < threadCount; i++) {
+    threads.emplace_back(worker);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  double elapsedSec =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  // 按请求数排序的前 N 个路由
+  std::vector<std::pair<std::string, RouteStats *>> topRoutes;
+  for (auto &[route, stats] : routes) {
+    topRoutes.emplace_back(route, stats.get());
+  }
+  std::sort(topRoutes.begin(), topRoutes.end(),
+            [](const auto &a, const auto &b) {
+              return a.second->requests > b.second->requests;
+            });
+  if (topRoutes.size() > opts.topRoutes) {
+    topRoutes.resize(opts.topRoutes);
+  }
+
+  double capturedSec =
+      static_cast<double>(cap.requests.back().offsetUs - firstOffsetUs) / 1e6;
+  std::printf("{\n");
+  std::printf("  \"target\": \"%s:%d\",\n", opts.host.c_str(), opts.port);
+  std::printf("  \"capture\": \"%s\",\n", jsonEscape(opts.file).c_str());
+  std::printf("  \"speed\": %.3f,\n", opts.speed);
+  std::printf("  \"requests\": %zu,\n", cap.requests.size());
+  std::printf("  \"errors\": %llu,\n",
+              static_cast<unsigned long long>(errors.load()));
+  std::printf("  \"status_mismatches\": %llu,\n",
+              static_cast<unsigned long long>(statusMismatches.load()));
+  std::printf("  \"late_starts\": %llu,\n",
+              static_cast<unsigned long long>(lateStarts.load()));
+  std::printf("  \"captured_span_s\": %.3f,\n", capturedSec);
+  std::printf("  \"replay_span_s\": %.3f,\n", elapsedSec);
+  std::printf("  \"captured_latency\": ");
+  printLatency(*captured);
+  std::printf(",\n  \"replay_latency\": ");
+  printLatency(*replayed);
+  std::printf(",\n  \"by_route\": {");
+  bool first = true;
+  for (const auto &[route, stats] : topRoutes) {
+    std::printf("%s\n    \"%s\": {\"captured\": ", first ? "" : ",",
+                jsonEscape(route).c_str());
+    printLatency(stats->captured);
+    std::printf(", \"replay\": ");
+    printLatency(stats->replayed);
+    std::printf("}");
+    first = false;
+  }
+  std::printf("\n  },\n  \"status_codes\": {");
+  first = true;
+  for (const auto &[code, count] : statusCodes) {
+    std::printf("%s\"%d\": %llu", first ? "" : ", ", code,
+                static_cast<unsigned long long>(count));
+    first = false;
+  }
+  std::printf("}\n}\n");
+  return errors.load() == cap.requests.size() ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+// 主机端 ContentDecoder 回归测试：ctest --test-dir build/tools
+#include "ContentDecoder.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <zlib.h>
+
+using namespace margelo::nitro::http_server;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                   #cond);                                                     \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+using Status = ContentDecoder::Status;
+using Encoding = ContentDecoder::Encoding;
+
+static std::string sample(size_t size) {
+  std::string data(size, '\0');
+  uint32_t x = 12345;
+  for (auto &byte : data) {
+    x = x * 1103515245 + 12345;
+    byte = static_cast<char>('a' + (x >> 16) % 8);
+  }
+  return data;
+}
+
+// windowBits：15 + 16 为 gzip，15 为带 zlib 头的 deflate，-15 为裸 deflate
+static std::string compress(const std::string &input, int windowBits) {
+  z_stream z{};
+  deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8,
+               Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&z, static_cast<uLong>(input.size())), '\0');
+  z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+  z.avail_in = static_cast<uInt>(input.size());
+  z.next_out = reinterpret_cast<Bytef *>(&out[0]);
+  z.avail_out = static_cast<uInt>(out.size());
+  deflate(&z, Z_FINISH);
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+}
+
+static std::string gzip(const std::string &input) {
+  return compress(input, 15 + 16);
+}
+
+// 按 chunk 字节分段输入，最后一段带 last；中途出错即返回
+static Status feedInPieces(ContentDecoder &decoder, const std::string &input,
+                           size_t chunk, std::string &out) {
+  size_t offset = 0;
+  do {
+    size_t len = std::min(chunk, input.size() - offset);
+    bool last = offset + len == input.size();
+    Status status = decoder.feed(input.data() + offset, len, last, out);
+    if (status != Status::Ok) {
+      return status;
+    }
+    offset += len;
+  } while (offset < input.size());
+  return Status::Ok;
+}
+
+static Status decodeInPieces(Encoding encoding, const std::string &input,
+                             size_t chunk, std::string &out,
+                             const DecompressionLimits &limits = {}) {
+  ContentDecoder decoder(encoding, limits);
+  return feedInPieces(decoder, input, chunk, out);
+}
+
+static void testParseEncoding() {
+  CHECK(ContentDecoder::parseEncoding("gzip") == Encoding::Gzip);
+  CHECK(ContentDecoder::parseEncoding(" X-Gzip ") == Encoding::Gzip);
+  CHECK(ContentDecoder::parseEncoding("Deflate") == Encoding::Deflate);
+  CHECK(!ContentDecoder::parseEncoding(""));
+  CHECK(!ContentDecoder::parseEncoding("identity"));
+  CHECK(!ContentDecoder::parseEncoding("br"));
+  CHECK(!ContentDecoder::parseEncoding("gzip, deflate"));
+}
+
+static void testLimitsFromJson() {
+  CHECK(!DecompressionLimits::fromJson(*JsonValue::parse("false")));
+  CHECK(!DecompressionLimits::fromJson(*JsonValue::parse("1")));
+  auto defaults = DecompressionLimits::fromJson(*JsonValue::parse("true"));
+  CHECK(defaults && defaults->maxBytes == DecompressionLimits{}.maxBytes);
+  auto custom = DecompressionLimits::fromJson(
+      *JsonValue::parse(R"({"max_bytes": 4096, "max_ratio": 0})"));
+  CHECK(custom && custom->maxBytes == 4096);
+  CHECK(custom && custom->maxRatio == 1); // 不低于 1 倍
+}
+
+// gzip、带 zlib 头的 deflate、裸 deflate 在各种分段下都能还原；1 字节分段
+// 覆盖 deflate 头判断前缓存输入的路径
+static void testRoundTrip() {
+  const std::string input = sample(200000);
+  const std::pair<Encoding, int> cases[] = {
+      {Encoding::Gzip, 15 + 16},
+      {Encoding::Gzip, 15}, // gzip 也接受 zlib 头
+      {Encoding::Deflate, 15},
+      {Encoding::Deflate, -15},
+  };
+  for (const auto &[encoding, windowBits] : cases) {
+    std::string packed = compress(input, windowBits);
+    for (size_t chunk : {size_t(1), size_t(2), size_t(7), size_t(4096),
+                         packed.size()}) {
+      std::string out;
+      CHECK(decodeInPieces(encoding, packed, chunk, out) == Status::Ok);
+      CHECK(out == input);
+    }
+  }
+
+  std::string out;
+  CHECK(ContentDecoder::decodeAll(Encoding::Deflate, {}, nullptr, 0, out) ==
+        Status::Ok);
+  CHECK(out.empty());
+}
+
+// 多个 gzip member 首尾相接，分界落在分段中间；deflate 流后不能再有数据
+static void testMultiMember() {
+  const std::string first = sample(50000);
+  const std::string second = sample(30000).substr(1000);
+  const std::string packed = gzip(first) + gzip(second);
+  for (size_t chunk : {size_t(1), size_t(13), size_t(4096), packed.size()}) {
+    std::string out;
+    CHECK(decodeInPieces(Encoding::Gzip, packed, chunk, out) == Status::Ok);
+    CHECK(out == first + second);
+  }
+
+  std::string out;
+  CHECK(decodeInPieces(Encoding::Gzip, gzip(first) + "junk", 64, out) ==
+        Status::Malformed);
+  out.clear();
+  CHECK(decodeInPieces(Encoding::Deflate, compress(first, 15) + "junk", 64,
+                       out) == Status::Malformed);
+}
+
+// 截断或损坏的输入：未结束时照常返回 Ok，last 时报告 Malformed，之后的调用
+// 保持同一错误
+static void testMalformed() {
+  const std::string packed = gzip(sample(200000));
+  const std::string truncated = packed.substr(0, packed.size() - 4);
+  std::string out;
+  ContentDecoder decoder(Encoding::Gzip, {});
+  CHECK(decoder.feed(truncated.data(), truncated.size(), false, out) ==
+        Status::Ok);
+  CHECK(decoder.feed(nullptr, 0, true, out) == Status::Malformed);
+  CHECK(decoder.feed(packed.data() + truncated.size(), 4, true, out) ==
+        Status::Malformed);
+
+  for (Encoding encoding : {Encoding::Gzip, Encoding::Deflate}) {
+    std::string half = compress(sample(200000), 15).substr(0, 1000);
+    out.clear();
+    CHECK(decodeInPieces(encoding, half, 7, out) == Status::Malformed);
+    out.clear();
+    CHECK(decodeInPieces(encoding, half.substr(0, 1), 1, out) ==
+          Status::Malformed);
+  }
+
+  out.clear();
+  CHECK(decodeInPieces(Encoding::Gzip, "not compressed at all", 3, out) ==
+        Status::Malformed);
+}
+
+// max_bytes：恰好等于上限可以通过，多一个字节即 TooLarge，且超出部分
+// 不会追加到 out
+static void testMaxBytes() {
+  DecompressionLimits limits;
+  limits.maxBytes = 100000;
+  const std::string exact = sample(100000);
+  std::string out;
+  CHECK(decodeInPieces(Encoding::Gzip, gzip(exact), 1000, out, limits) ==
+        Status::Ok);
+  CHECK(out == exact);
+
+  out.clear();
+  CHECK(decodeInPieces(Encoding::Gzip, gzip(sample(100001)), 1000, out,
+                       limits) == Status::TooLarge);
+  CHECK(out.size() <= limits.maxBytes);
+}
+
+// max_ratio：全零数据的压缩比约 1000 倍。1 MB 以下不检查倍数，超过后
+// 按累计的输入输出计算
+static void testMaxRatio() {
+  const std::string small(DecompressionLimits::kRatioFloor / 2, '\0');
+  std::string out;
+  CHECK(decodeInPieces(Encoding::Gzip, gzip(small), 64, out) == Status::Ok);
+  CHECK(out == small);
+
+  const std::string bomb(4 * DecompressionLimits::kRatioFloor, '\0');
+  const std::string packed = gzip(bomb);
+  out.clear();
+  CHECK(decodeInPieces(Encoding::Gzip, packed, 64, out) == Status::TooLarge);
+  CHECK(out.size() <= DecompressionLimits::kRatioFloor);
+
+  DecompressionLimits generous;
+  generous.maxRatio = 2000;
+  out.clear();
+  CHECK(decodeInPieces(Encoding::Gzip, packed, 64, out, generous) ==
+        Status::Ok);
+  CHECK(out == bomb);
+}
+
+int main() {
+  testParseEncoding();
+  testLimitsFromJson();
+  testRoundTrip();
+  testMultiMember();
+  testMalformed();
+  testMaxBytes();
+  testMaxRatio();
+  if (failures == 0) {
+    std::printf("ContentDecoderTest: ok\n");
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
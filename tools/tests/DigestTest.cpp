@@ -0,0 +1,390 @@
+// 主机端 Digest / Hmac 回归测试：ctest --test-dir build/tools
+// 期望值为 RFC 1321 / FIPS 180-4 / RFC 2202 / RFC 4231 的测试向量；
+// 补位边界长度的期望值由 Python hashlib 生成
+#include "Digest.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::http_server;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                   #cond);                                                     \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static std::string toHex(const std::vector<uint8_t> &bytes) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string hex;
+  for (uint8_t byte : bytes) {
+    hex += kDigits[byte >> 4];
+    hex += kDigits[byte & 0xf];
+  }
+  return hex;
+}
+
+static std::string digestHex(HashAlgorithm algorithm, const std::string &data) {
+  Digest digest(algorithm);
+  digest.update(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+  return toHex(digest.finish());
+}
+
+// FIPS 180-4 的 448 位和 896 位消息
+static const char k448[] =
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmjklmnklmnolmnopmnopqnopq";
+static const char k896[] =
+    "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+    "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+struct Vector {
+  HashAlgorithm algorithm;
+  const char *message;
+  const char *expected;
+};
+
+static const Vector kVectors[] = {
+    {HashAlgorithm::Md5, "",
+     "d41d8cd98f00b204e9800998ecf8427e"},
+    {HashAlgorithm::Md5, "abc",
+     "900150983cd24fb0d6963f7d28e17f72"},
+    {HashAlgorithm::Md5, k448,
+     "da972832d24dabadc29ed289e5c6b249"},
+    {HashAlgorithm::Md5, k896,
+     "03dd8807a93175fb062dfb55dc7d359c"},
+    {HashAlgorithm::Sha1, "",
+     "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+    {HashAlgorithm::Sha1, "abc",
+     "a9993e364706816aba3e25717850c26c9cd0d89d"},
+    {HashAlgorithm::Sha1, k448,
+     "f096cc990cdf3b89b420cab73383569484f25d44"},
+    {HashAlgorithm::Sha1, k896,
+     "a49b2446a02c645bf419f995b67091253a04a259"},
+    {HashAlgorithm::Sha256, "",
+     "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {HashAlgorithm::Sha256, "abc",
+     "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {HashAlgorithm::Sha256, k448,
+     "9ad289b5b8ca3b67b3e1238ea026560d218cac02ee49b871795a3311874d107e"},
+    {HashAlgorithm::Sha256, k896,
+     "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {HashAlgorithm::Sha384, "",
+     "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da"
+     "274edebfe76f65fbd51ad2f14898b95b"},
+    {HashAlgorithm::Sha384, "abc",
+     "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+     "8086072ba1e7cc2358baeca134c825a7"},
+    {HashAlgorithm::Sha384, k448,
+     "1ada913246ec609e6cd7e3d0d51cfa50f80cd0297ae7f6d653a44caf5079fe76"
+     "786dbcad36f402f325d2546a44414e8a"},
+    {HashAlgorithm::Sha384, k896,
+     "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712"
+     "fcc7c71a557e2db966c3e9fa91746039"},
+    {HashAlgorithm::Sha512, "",
+     "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+     "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e"},
+    {HashAlgorithm::Sha512, "abc",
+     "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+     "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"},
+    {HashAlgorithm::Sha512, k448,
+     "129ae607ea671d0d6f5c2001debb6acccbc5ef8bbd133493b3ad9979cb588b4d"
+     "095c475a4898c102710da41ec5295374259009e7cb2b220b60e0051dd4d8c7d8"},
+    {HashAlgorithm::Sha512, k896,
+     "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+     "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909"},
+};
+
+static void testKnownAnswers() {
+  for (const auto &vector : kVectors) {
+    CHECK(digestHex(vector.algorithm, vector.message) == vector.expected);
+  }
+  // RFC 1321 附录 A.5 的其余消息
+  CHECK(digestHex(HashAlgorithm::Md5, "message digest") ==
+        "f96b697d7cb7938d525a2f31aaf161d0");
+  CHECK(digestHex(HashAlgorithm::Md5, "abcdefghijklmnopqrstuvwxyz") ==
+        "c3fcd3d76192e4007dfb496cca67e13b");
+  // 一百万个 'a'（FIPS 180-4 的长消息）
+  const std::string million(1000000, 'a');
+  CHECK(digestHex(HashAlgorithm::Sha1, million) ==
+        "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+  CHECK(digestHex(HashAlgorithm::Sha256, million) ==
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  CHECK(digestHex(HashAlgorithm::Sha384, million) ==
+        "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b"
+        "07b8b3dc38ecc4ebae97ddd87f3d8985");
+  CHECK(digestHex(HashAlgorithm::Sha512, million) ==
+        "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973eb"
+        "de0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+}
+
+// 补位边界附近的长度：MD5 / SHA-1 / SHA-256 的块为 64 字节，55 与 56 字节
+// 分别在一个和两个块内补位；SHA-384 / SHA-512 的块为 128 字节，分界在 112
+static std::string boundaryMessage(size_t len) {
+  std::string data(len, '\0');
+  for (size_t i = 0; i < len; i++) {
+    data[i] = static_cast<char>((i * 131 + 17) & 0xff);
+  }
+  return data;
+}
+
+struct BoundaryVector {
+  HashAlgorithm algorithm;
+  size_t length;
+  const char *expected;
+};
+
+static const BoundaryVector kBoundaryVectors[] = {
+    {HashAlgorithm::Md5, 55,
+     "96799d8bf84d94466fb1d4785f0eae6c"},
+    {HashAlgorithm::Md5, 56,
+     "bf9c6bb58c938814a38d99d564393a53"},
+    {HashAlgorithm::Md5, 63,
+     "35692891f16306d06ba365a887de5dd3"},
+    {HashAlgorithm::Md5, 64,
+     "c99cacee8808c930ea7a2a5f79a58599"},
+    {HashAlgorithm::Md5, 65,
+     "99f97c2c46e2953fc2c2b315db172a78"},
+    {HashAlgorithm::Md5, 111,
+     "5f401c8f1808e638531bdfe122bd0cfe"},
+    {HashAlgorithm::Md5, 112,
+     "b404c9bcf89a9ffbabed3e25612ccb59"},
+    {HashAlgorithm::Md5, 119,
+     "8c8f2677f6b4338b4477d6842ca735e3"},
+    {HashAlgorithm::Md5, 120,
+     "788134ee3f7a478b5eaaed0c7d6965f9"},
+    {HashAlgorithm::Md5, 127,
+     "ae30800159a9a3dd3fa3ec647f999692"},
+    {HashAlgorithm::Md5, 128,
+     "11e4554b8031fd4aa009f2ca792f8989"},
+    {HashAlgorithm::Md5, 129,
+     "af698300cb8bcf22d7a903741a5c394a"},
+    {HashAlgorithm::Md5, 200,
+     "0cfc2f397fa8c44733a438f956151dd7"},
+    {HashAlgorithm::Sha1, 55,
+     "c460dda9725993db7b635e25646d4fcd9bd30871"},
+    {HashAlgorithm::Sha1, 56,
+     "1794a43ae77e95e8cc39a31e2727c58c718ce53f"},
+    {HashAlgorithm::Sha1, 63,
+     "5274fdff2cc6384f500028c1e794d62aed870966"},
+    {HashAlgorithm::Sha1, 64,
+     "8477cdffd4b543880bcf926612a161e4a08abfbf"},
+    {HashAlgorithm::Sha1, 65,
+     "180b0aab8816d0ef092f1224dfc0568d08c22fe9"},
+    {HashAlgorithm::Sha1, 111,
+     "7089262dace1d86ce7c3801bf4f71fd0afcec009"},
+    {HashAlgorithm::Sha1, 112,
+     "fac67fbc1504e5e84a55610c7def6e7de6fd5172"},
+    {HashAlgorithm::Sha1, 119,
+     "10048d4c29cba635734b5f686a1942dfeb8239d9"},
+    {HashAlgorithm::Sha1, 120,
+     "384a2c7f5a8eb395fab7a1ae5ec76f08ccaac277"},
+    {HashAlgorithm::Sha1, 127,
+     "29d7c61615e0894d423d060678ee674652617c81"},
+    {HashAlgorithm::Sha1, 128,
+     "dc9f7cd67239c5030128aa4f129b865adc64d2a3"},
+    {HashAlgorithm::Sha1, 129,
+     "e9c20ff8b05321dadd7e9c320e29fe460559f31d"},
+    {HashAlgorithm::Sha1, 200,
+     "e8fe7558aba7a1e771db54e7bff82d3db6919321"},
+    {HashAlgorithm::Sha256, 55,
+     "59aaae80b8e7958f5757b4ac9274f1fd57ec0dc7aa8349319102316781b92006"},
+    {HashAlgorithm::Sha256, 56,
+     "dca902d31487ffab357ce36cc5abc6947fbb69127ec04c468ba5687268c4bf7c"},
+    {HashAlgorithm::Sha256, 63,
+     "b8e655e9e7ad413b96f0a371eb1d6db71dcca27f4eee35892517cbe4bfaa6f9a"},
+    {HashAlgorithm::Sha256, 64,
+     "e5146be62accc56709594cb45c651b361df94f622cbb09b91ea3ca7a2060bd53"},
+    {HashAlgorithm::Sha256, 65,
+     "4b6c6774f0cbcd776a90e187b9494e04ca880c0afe3ea1c5cad51c8bbcb41f74"},
+    {HashAlgorithm::Sha256, 111,
+     "e10996bd86a024f96eeb80e4881768a8b13419689a0590b83dd8557380ffa513"},
+    {HashAlgorithm::Sha256, 112,
+     "fbe78143adb8f8a89b71be02156e5f1d8a536d038cef5b609cde6cc7930a07c7"},
+    {HashAlgorithm::Sha256, 119,
+     "3244509f8746f6fb511ca8a72a292a4d7d12e456cce283c03f169dbbcb0d512e"},
+    {HashAlgorithm::Sha256, 120,
+     "c5236e50172da3b69c903dcd3b3bb8ce855182f79364d1b59ed36367aa25e468"},
+    {HashAlgorithm::Sha256, 127,
+     "b4f5398bf618d741f2ab0f6e2fcde06f4949c20d476b5f6e1d4bf8618bc8973a"},
+    {HashAlgorithm::Sha256, 128,
+     "ed045c7c319e0c9286e1dea21c80bfd4a08eca43e02e13ee8a7a2c8b4b2baec9"},
+    {HashAlgorithm::Sha256, 129,
+     "d6f2fca0407b3f98c9ce29ae92a6cdf489506450fdbb29172f6b18987bc685db"},
+    {HashAlgorithm::Sha256, 200,
+     "13475518cdfab8416d6b77c1ed10712f1eddcaa6d053fe954cf46cbff206df1c"},
+    {HashAlgorithm::Sha384, 55,
+     "0b8e94ce967eb2a6a9afcb35987440cbc51d6872a2ffdecf6f4fe056180df896"
+     "b8af4023503c1fc0a8309cafb7809ce7"},
+    {HashAlgorithm::Sha384, 56,
+     "5381ba2367652029eacda130f0afd5b8654cb3f3d5ceeb44370ea830d6323d04"
+     "fdeaba5454d0f43f34faa08482f81489"},
+    {HashAlgorithm::Sha384, 63,
+     "481d410008607a5739a5720284be43eecead733ab7420f81f7bab314f46dd7e2"
+     "7498ee0aaf807e9b9de5fd83b0efee0d"},
+    {HashAlgorithm::Sha384, 64,
+     "53c31096e92945814b6670bb8d694d1a0e7c449b005351a6393ccc28e342bfa2"
+     "b256faeb56671aacd6ff3a5ed950c18e"},
+    {HashAlgorithm::Sha384, 65,
+     "f7eb60ca68f59128dfbf72cbab280d7492b1687dda1d98fd449d4b3516f1badf"
+     "da8045326fdda500b9b68a3f96362d7b"},
+    {HashAlgorithm::Sha384, 111,
+     "ae05be3f17ff7bc9642dd0c02073b70932ad8516fdb8a8e2148098f163de55fb"
+     "0df302f835d4232ed64364f7c5f1f505"},
+    {HashAlgorithm::Sha384, 112,
+     "bfdd3ba274db0213cfd756eba1ca6b1180d44ba2428133f8ab37de7277258802"
+     "2f1d6b0381eb355b091999a0149998fa"},
+    {HashAlgorithm::Sha384, 119,
+     "81a2d8c61c5b5058e353af7348f962e523afb19494a80d393f35f33b95e77d95"
+     "95e45eed9e17f95eeb6c718b1ee0d09c"},
+    {HashAlgorithm::Sha384, 120,
+     "653d44e7d06cbc7e7a4fb7d313928713567046f86572d099e9907a6dbd41906d"
+     "035efa2220d717295ec40a6cefc1fddc"},
+    {HashAlgorithm::Sha384, 127,
+     "2da2c082e24e64528c01224f002a87a8f6c1e2abb109c4138ea3738f0b3dd354"
+     "6750d82a9816bbb0edaba0986aef7d7d"},
+    {HashAlgorithm::Sha384, 128,
+     "ea0b611956177051328ae3750bfad5f0dde40d20b602f2a406f179be319b99a9"
+     "eb1f8af9ebf572e09b5ee90aa7b81a11"},
+    {HashAlgorithm::Sha384, 129,
+     "8391543cf5fef95ee06b21011aad4749af279f4f17a169311fa3879ab5e722ea"
+     "6dcdd69b3ec58368499f364f451778b0"},
+    {HashAlgorithm::Sha384, 200,
+     "eb85ec63336432c6f2a8f562652cdc3740256ae4d31e063acfeae175027084ef"
+     "65129c880bcdd30cbba7853658036aa2"},
+    {HashAlgorithm::Sha512, 55,
+     "61c741935d18a01e61197bf640ade205e567f15ec3a6a373978c9e118f81365a"
+     "4a723b9544c1d924577f07d9dc93eb0126d6ab965b327bab85d8e5f883677696"},
+    {HashAlgorithm::Sha512, 56,
+     "9d4543b5712b981bea8b9ff60c6131baae11f5ac2ac4f86227d162e958b37958"
+     "e24be0df085cf8f6db54fa7ee8cc7aa2918cf119f5cdf24d67a3558684dfad28"},
+    {HashAlgorithm::Sha512, 63,
+     "2f0e84dfa64f5d4a82b4f8e51a2aef5f5f8c1c7b5f0e4fd3bc307a1f871f2679"
+     "a0ca402d130bbed3fd56480cd9e3bd5a36a88430c34b571be20745db8b87a15c"},
+    {HashAlgorithm::Sha512, 64,
+     "bc182b8cd6d29b2921583709cfa9a250b683c8ef347862ec652bfb7a29d58bc7"
+     "0a8bcde4018e9ce14548a2d3b94d90a91c62ec3a34e9b14c3bcb7dea7f75bc51"},
+    {HashAlgorithm::Sha512, 65,
+     "04fd7f3c1997480f41c83564fbefca07c9f63fef03ea71574e356fc00c5bf9b6"
+     "52a43c9a1bc85d30196476df50a60768de83e51b10735a7a632aec14bf7700df"},
+    {HashAlgorithm::Sha512, 111,
+     "e914b739fe0b5e807bcd0966007596551f6395d312b8b26b255749b9a3c0550d"
+     "a197325745c05fd3f19b6b9709af9fc4a681856adbe312bdbe4f18f94ff523a3"},
+    {HashAlgorithm::Sha512, 112,
+     "d5b97c9cef538d686c72c80befed51a66281b3ad4cf70a75f3812015e7f60bb0"
+     "ca529f8d58661a517263a0ffaf59a8e05aee80bc0588a130f6295a94c7638657"},
+    {HashAlgorithm::Sha512, 119,
+     "589a9ab16a719d6802b491b29d0b6467fe52f09f4402c41e61762f19fe390244"
+     "2954722222d2432b7920197e772cc155bf8b93069c9018daff7c5e4d2805c300"},
+    {HashAlgorithm::Sha512, 120,
+     "40cb421c4c92363642339309c399f7da8e39eaac012f3b0a608e5cc47d382783"
+     "ceeca9fba949409e67722f03e36ed2dfb529a8d980eb0ef20c030d5ae5e819e9"},
+    {HashAlgorithm::Sha512, 127,
+     "a10a2850cc7a101c1877907254550f8beb1a4c7da9d372ebf0ecacc0169fbce8"
+     "42471cd18da009aa68513a05dc72c0d6ceaaf704060fb4632be0a0901215564f"},
+    {HashAlgorithm::Sha512, 128,
+     "3b6509e01d3962462c2321ed30af8a49fd06ad2ed8c15a6310236fd1309508ad"
+     "cbe0c72404d88570f2b625a70314b5728c5b3476b2160cc93cc0e448229909aa"},
+    {HashAlgorithm::Sha512, 129,
+     "1e760fbfdd903458c19c2017c624e7bed001aeb12bb259f45b74ad307d1a5993"
+     "0100c898e514028f1b1c0a85f19572813d8547ae08e02487a7090bad9220d8ce"},
+    {HashAlgorithm::Sha512, 200,
+     "b0230556d26b8fd3aec3481cb0aee231783ce463a88b3703d66abd1b07961c4d"
+     "ca8218d0fa6cf1ffb5d627f4bd64a8f00e65357c141c25b4e67370c3cd48c410"},
+};
+
+// 每个分割点分两次 update、逐字节 update、先空 update 再整段输入，结果都
+// 应与期望值一致；finish 之后 Digest 回到初始状态，可以复用
+static void testSplitUpdates() {
+  for (const auto &vector : kBoundaryVectors) {
+    std::string data = boundaryMessage(vector.length);
+    const auto *bytes = reinterpret_cast<const uint8_t *>(data.data());
+    Digest digest(vector.algorithm);
+    for (size_t split = 0; split <= data.size(); split++) {
+      digest.update(bytes, split);
+      digest.update(bytes + split, data.size() - split);
+      CHECK(toHex(digest.finish()) == vector.expected);
+    }
+    for (size_t i = 0; i < data.size(); i++) {
+      digest.update(bytes + i, 1);
+    }
+    CHECK(toHex(digest.finish()) == vector.expected);
+    digest.update(bytes, 0);
+    digest.update(bytes, data.size());
+    CHECK(toHex(digest.finish()) == vector.expected);
+
+    // 复制即得到当前状态的副本
+    size_t half = data.size() / 2;
+    digest.update(bytes, half);
+    Digest copy = digest;
+    copy.update(bytes + half, data.size() - half);
+    CHECK(toHex(copy.finish()) == vector.expected);
+  }
+}
+
+static std::string hmacHex(HashAlgorithm algorithm, const std::string &key,
+                           const std::string &data) {
+  Hmac hmac(algorithm, reinterpret_cast<const uint8_t *>(key.data()),
+            key.size());
+  hmac.update(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+  return toHex(hmac.finish());
+}
+
+// RFC 2202（MD5 / SHA-1）与 RFC 4231（SHA-2）：短密钥，以及长于块大小、
+// 需要先做摘要的密钥
+static void testHmac() {
+  const std::string jefe = "Jefe";
+  const std::string query = "what do ya want for nothing?";
+  CHECK(hmacHex(HashAlgorithm::Md5, jefe, query) ==
+        "750c783e6ab0b503eaa86e310a5db738");
+  CHECK(hmacHex(HashAlgorithm::Sha1, jefe, query) ==
+        "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79");
+  CHECK(hmacHex(HashAlgorithm::Sha256, jefe, query) ==
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+  CHECK(hmacHex(HashAlgorithm::Sha384, jefe, query) ==
+        "af45d2e376484031617f78d2b58a6b1b9c7ef464f5a01b47e42ec3736322445e"
+        "8e2240ca5e69e2c78b3239ecfab21649");
+  CHECK(hmacHex(HashAlgorithm::Sha512, jefe, query) ==
+        "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+        "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+
+  // RFC 2202 测试 6：80 字节密钥，大于 MD5 / SHA-1 的 64 字节块
+  const std::string largerKey =
+      "Test Using Larger Than Block-Size Key - Hash Key First";
+  const std::string key80(80, '\xaa');
+  CHECK(hmacHex(HashAlgorithm::Md5, key80, largerKey) ==
+        "6b1ab7fe4bd7bf8f0b62e6ce61b9d0cd");
+  CHECK(hmacHex(HashAlgorithm::Sha1, key80, largerKey) ==
+        "aa4ae5e15272d00e95705637ce8a3b55ed402112");
+  // RFC 4231 测试 6：131 字节密钥，大于 SHA-384 / SHA-512 的 128 字节块
+  const std::string key131(131, '\xaa');
+  CHECK(hmacHex(HashAlgorithm::Sha256, key131, largerKey) ==
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+  CHECK(hmacHex(HashAlgorithm::Sha384, key131, largerKey) ==
+        "4ece084485813e9088d2c63a041bc5b44f9ef1012a2b588f3cd11f05033ac4c6"
+        "0c2ef6ab4030fe8296248df163f44952");
+  CHECK(hmacHex(HashAlgorithm::Sha512, key131, largerKey) ==
+        "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f352"
+        "6b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598");
+  // 密钥恰好等于块大小时直接使用
+  CHECK(hmacHex(HashAlgorithm::Sha256, std::string(64, 'k'), query) ==
+        "63f12563e45dcef7c354a6ba71d0c713aa28eea869b5a199da814b225867f54c");
+  CHECK(hmacHex(HashAlgorithm::Sha512, std::string(128, 'k'), query) ==
+        "17809ffde81fb68aa0814c77831a5550d614e72ab1048bc4be0ebfd6101f2513"
+        "61cd1344cc0dfa061f08e3498372f8529780db5371006f9a4f43a3b4726c8126");
+}
+
+int main() {
+  testKnownAnswers();
+  testSplitUpdates();
+  testHmac();
+  if (failures == 0) {
+    std::printf("DigestTest: ok\n");
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
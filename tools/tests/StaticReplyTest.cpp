@@ -0,0 +1,84 @@
+// 主机端 buildStaticReply 回归测试：ctest --test-dir build/tools
+#include "StaticAsset.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+using namespace margelo::nitro::http_server;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                   #cond);                                                     \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+using RequestHeaders = std::unordered_map<std::string, std::string>;
+
+// 响应头 JSON 中的 Content-Length；没有时返回 -1
+static long long contentLength(const std::string &headersJson) {
+  auto headers = JsonValue::parse(headersJson);
+  if (!headers || !headers->isObject()) {
+    return -1;
+  }
+  for (const auto &[name, value] : headers->members()) {
+    if (name == "Content-Length" || name == "content-length") {
+      return std::atoll(value.asString("").c_str());
+    }
+  }
+  return -1;
+}
+
+// HEAD 与 GET 的状态码相同，HEAD 不带响应体，Content-Length 为 GET 的长度
+static void checkHeadMatchesGet(const StaticAsset &asset,
+                                const RequestHeaders &headers) {
+  StaticReply get = buildStaticReply(asset, "GET", headers);
+  StaticReply head = buildStaticReply(asset, "HEAD", headers);
+  CHECK(head.statusCode == get.statusCode);
+  CHECK(head.bodyLen == 0);
+  CHECK(contentLength(head.headersJson) ==
+        static_cast<long long>(get.bodyLen));
+}
+
+int main() {
+  static const std::string kData(5 * 1024 * 1024, 'x');
+  static const std::string kGzip(1234, 'z');
+  StaticAsset asset;
+  asset.data = kData.data();
+  asset.size = kData.size();
+  asset.etag = "\"abc\"";
+  asset.headers.emplace_back("Content-Type", "text/plain");
+
+  checkHeadMatchesGet(asset, {});
+  checkHeadMatchesGet(asset, {{"range", "bytes=100-199"}});
+  checkHeadMatchesGet(asset, {{"range", "bytes=-10"}});
+  checkHeadMatchesGet(asset, {{"range", "bytes=99999999-"}});
+
+  StaticAsset gzipped = asset;
+  gzipped.gzipData = kGzip.data();
+  gzipped.gzipSize = kGzip.size();
+  checkHeadMatchesGet(gzipped, {{"accept-encoding", "gzip, br"}});
+  checkHeadMatchesGet(gzipped, {});
+
+  // 304 不带 Content-Length
+  StaticReply notModified =
+      buildStaticReply(asset, "HEAD", {{"if-none-match", "\"abc\""}});
+  CHECK(notModified.statusCode == 304);
+  CHECK(contentLength(notModified.headersJson) == -1);
+
+  // If-None-Match 按列表逐项比较，不做子串匹配
+  CHECK(etagMatches("\"x\", W/\"abc\"", "\"abc\""));
+  CHECK(etagMatches("*", "\"abc\""));
+  CHECK(!etagMatches("\"abcd\"", "\"abc\""));
+  CHECK(!etagMatches("\"abc-gz\"", "\"abc\""));
+
+  if (failures == 0) {
+    std::printf("StaticReplyTest: ok\n");
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
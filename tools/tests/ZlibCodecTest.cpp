@@ -0,0 +1,112 @@
+// 主机端 ZlibCodec 回归测试：ctest --test-dir build/tools
+#include "ZlibCodec.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+using namespace margelo::nitro::http_server;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                   #cond);                                                     \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static std::vector<uint8_t> sample(size_t size) {
+  std::vector<uint8_t> data(size);
+  uint32_t x = 12345;
+  for (auto &byte : data) {
+    x = x * 1103515245 + 12345;
+    // 半随机：既能压缩，又远大于一个输出块
+    byte = static_cast<uint8_t>('a' + (x >> 16) % 8);
+  }
+  return data;
+}
+
+static std::vector<uint8_t> oneShot(ZlibMode mode,
+                                    const std::vector<uint8_t> &input) {
+  ZlibCodec codec(mode, ZlibParams{});
+  return codec.process(input.data(), input.size(), Z_FINISH);
+}
+
+// 同步形式（gzipSync / gunzipSync 等）：一次 Z_FINISH 完成，输出远大于 16KB
+static void testSyncRoundTrip() {
+  auto input = sample(200000);
+  const std::pair<ZlibMode, ZlibMode> pairs[] = {
+      {ZlibMode::Gzip, ZlibMode::Gunzip},
+      {ZlibMode::Gzip, ZlibMode::Unzip},
+      {ZlibMode::Deflate, ZlibMode::Inflate},
+      {ZlibMode::Deflate, ZlibMode::Unzip},
+      {ZlibMode::DeflateRaw, ZlibMode::InflateRaw},
+  };
+  for (const auto &[compress, decompress] : pairs) {
+    auto packed = oneShot(compress, input);
+    CHECK(packed.size() < input.size());
+    try {
+      CHECK(oneShot(decompress, packed) == input);
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "%s: %s\n", zlibModeName(decompress), e.what());
+      failures++;
+    }
+  }
+}
+
+// 截断的输入仍然报告 unexpected end of file
+static void testTruncated() {
+  auto packed = oneShot(ZlibMode::Gzip, sample(200000));
+  packed.resize(packed.size() / 2);
+  bool threw = false;
+  try {
+    oneShot(ZlibMode::Gunzip, packed);
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  CHECK(threw);
+}
+
+// 多个 gzip member 拼接，且下一个 member 从后续分块开始（包括 magic 被拆开）
+static void testConcatenatedMembersAcrossChunks() {
+  auto first = sample(50000);
+  auto second = sample(30000);
+  auto a = oneShot(ZlibMode::Gzip, first);
+  auto b = oneShot(ZlibMode::Gzip, second);
+  std::vector<uint8_t> expected = first;
+  expected.insert(expected.end(), second.begin(), second.end());
+
+  for (size_t split : {a.size(), a.size() + 1}) {
+    std::vector<uint8_t> joined = a;
+    joined.insert(joined.end(), b.begin(), b.end());
+    ZlibCodec codec(ZlibMode::Gunzip, ZlibParams{});
+    auto out = codec.process(joined.data(), split, Z_NO_FLUSH);
+    auto rest = codec.process(joined.data() + split, joined.size() - split,
+                              Z_NO_FLUSH);
+    out.insert(out.end(), rest.begin(), rest.end());
+    auto tail = codec.process(nullptr, 0, Z_FINISH);
+    out.insert(out.end(), tail.begin(), tail.end());
+    CHECK(out == expected);
+  }
+
+  // 流结束后的非 gzip 数据被丢弃
+  std::vector<uint8_t> trailing = a;
+  trailing.push_back('x');
+  trailing.push_back('y');
+  CHECK(oneShot(ZlibMode::Gunzip, trailing) == first);
+}
+
+int main() {
+  testSyncRoundTrip();
+  testTruncated();
+  testConcatenatedMembersAcrossChunks();
+  if (failures == 0) {
+    std::printf("ZlibCodecTest: ok\n");
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}